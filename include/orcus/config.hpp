@@ -0,0 +1,65 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+
+#ifndef __ORCUS_CONFIG_HPP__
+#define __ORCUS_CONFIG_HPP__
+
+#include "env.hpp"
+
+#include <cstdlib>
+
+namespace orcus {
+
+class import_trace;
+
+/**
+ * Import options shared by all filters.  A filter ignores the options that
+ * don't apply to it.
+ */
+struct ORCUS_DLLPUBLIC config
+{
+    /**
+     * Number of worker threads a filter may use to process independent parts
+     * of a document concurrently.  A value of 0 or 1 makes the filter do all
+     * of its work on the calling thread, which is the default.
+     */
+    size_t thread_count;
+
+    /**
+     * Trace to record the timings of the parts of an import on, or NULL to
+     * record nothing, which is the default.  The trace must outlive the
+     * import.
+     */
+    import_trace* trace;
+
+    config();
+};
+
+}
+
+#endif
@@ -58,4 +58,11 @@
   #endif
 #endif
 
+// Branch prediction hint for conditions that rarely hold.
+#ifdef __GNUC__
+  #define ORCUS_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+  #define ORCUS_UNLIKELY(x) (x)
+#endif
+
 #endif
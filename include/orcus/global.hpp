@@ -59,6 +59,18 @@ void print_attrs(const tokens& tokens, const xml_attrs_t& attrs);
  */
 date_time_t to_date_time(const pstring& str);
 
+/**
+ * Convert a date in the proleptic Gregorian calendar into the number of
+ * days since 1970-01-01.  The difference between the day numbers of two
+ * dates is the number of days between them.
+ *
+ * @param year year
+ * @param month month, 1-based.
+ * @param day day of the month, 1-based.
+ * @return number of days since 1970-01-01, negative for earlier dates.
+ */
+ORCUS_DLLPUBLIC long to_day_number(int year, int month, int day);
+
 template<typename _T>
 struct default_deleter : public std::unary_function<_T*, void>
 {
@@ -0,0 +1,207 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+
+#ifndef ORCUS_IMPORT_TRACE_HPP
+#define ORCUS_IMPORT_TRACE_HPP
+
+#include "env.hpp"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <ostream>
+
+namespace orcus {
+
+class import_trace_impl;
+
+/**
+ * Kind of work an import trace event accounts for.
+ */
+enum trace_phase_t
+{
+    /** reading of the directory of a zip archive. */
+    trace_phase_zip_read = 0,
+    /** decompression of a stream, or of a segment of it. */
+    trace_phase_inflate,
+    /** parsing of a stream, including the import context callbacks. */
+    trace_phase_parse,
+    /** insertion of cells buffered during parsing into the document. */
+    trace_phase_insert,
+    /** finalization of the document, including all of the phases below. */
+    trace_phase_finalize,
+    /** calculation of formula cells. */
+    trace_phase_calc,
+    /** finalization of a single sheet of the document. */
+    trace_phase_finalize_sheet,
+    /** tokenization of the formulas deferred until finalization. */
+    trace_phase_tokenize
+};
+
+const size_t trace_phase_count = trace_phase_tokenize + 1;
+
+ORCUS_DLLPUBLIC const char* get_trace_phase_name(trace_phase_t phase);
+
+/**
+ * Single span of work recorded during an import.  Events recorded on the
+ * same thread may nest; for instance a parse event covers the inflate
+ * events of the segments inflated on demand while parsing, and a finalize
+ * event covers the calc event.  Nested events are always of a different
+ * phase than the events they nest in, so that the totals of the phases
+ * don't count the same time twice.
+ */
+struct ORCUS_DLLPUBLIC trace_event
+{
+    /** name of the part the work is done for, such as a stream name. */
+    std::string name;
+    trace_phase_t phase;
+    /** start time in seconds, relative to the start of the trace. */
+    double start;
+    /** duration in seconds. */
+    double duration;
+    /** 0-based index of the thread, 0 being the thread that created the trace. */
+    size_t thread;
+    /** number of bytes processed, or 0 when not applicable. */
+    size_t bytes;
+    /** number of cells inserted into the document, or 0 when not applicable. */
+    size_t cells;
+
+    trace_event();
+};
+
+/**
+ * Totals of all events of one phase.
+ */
+struct ORCUS_DLLPUBLIC trace_phase_stats
+{
+    size_t event_count;
+    double duration;
+    size_t bytes;
+    size_t cells;
+
+    trace_phase_stats();
+};
+
+/**
+ * Collects timings of the parts of an import.  Pass an instance to a
+ * filter via config::trace to have it record an event for each part it
+ * processes.  Filters record nothing, and don't count cells, when no trace
+ * is set; the only cost then is a pointer test per part.
+ *
+ * Events may be added from any thread.  Cells are counted on the thread
+ * that created the trace, which is the one that inserts them into the
+ * document.
+ */
+class ORCUS_DLLPUBLIC import_trace
+{
+    import_trace_impl* mp_impl;
+
+    import_trace(const import_trace&); // disabled
+    import_trace& operator= (const import_trace&); // disabled
+
+public:
+    import_trace();
+    ~import_trace();
+
+    /**
+     * Remove all events and restart the clock.
+     */
+    void clear();
+
+    /**
+     * @return current time in seconds, relative to the start of the trace.
+     */
+    double now() const;
+
+    void add_event(const trace_event& event);
+
+    /**
+     * Add to the number of cells inserted so far.  Call this only on the
+     * thread that created the trace.
+     */
+    void add_cells(size_t n);
+
+    /**
+     * @return number of cells inserted so far.
+     */
+    size_t get_cell_count() const;
+
+    /**
+     * @return 0-based index of the calling thread, assigned in the order
+     *         the threads first record an event.
+     */
+    size_t get_thread_index() const;
+
+    /**
+     * @return copy of all events recorded so far, in the order they ended.
+     */
+    std::vector<trace_event> get_events() const;
+
+    trace_phase_stats get_phase_stats(trace_phase_t phase) const;
+
+    /**
+     * Write all events in the Chrome trace event format, which can be
+     * loaded into chrome://tracing or any other viewer of the format.
+     */
+    void write_chrome_trace(std::ostream& os) const;
+};
+
+/**
+ * Records an event that spans the lifetime of the instance.  It does
+ * nothing when the trace is NULL.  An event recorded on the thread that
+ * created the trace gets the number of cells inserted during its lifetime.
+ */
+class ORCUS_DLLPUBLIC trace_scope
+{
+    import_trace* mp_trace;
+    trace_event m_event;
+    size_t m_cell_count;
+    bool m_count_cells;
+
+    trace_scope(const trace_scope&); // disabled
+    trace_scope& operator= (const trace_scope&); // disabled
+
+public:
+    trace_scope(import_trace* trace, trace_phase_t phase, const char* name);
+    trace_scope(import_trace* trace, trace_phase_t phase, const std::string& name);
+    ~trace_scope();
+
+    void set_bytes(size_t bytes);
+
+    /**
+     * End the event now rather than at destruction.
+     */
+    void finish();
+
+private:
+    void start();
+};
+
+}
+
+#endif
@@ -48,9 +48,21 @@ struct ORCUS_DLLPUBLIC length_t
     std::string print() const;
 };
 
+/**
+ * Convert the leading part of a string to a numeric value.  These use
+ * parse_numeric() and parse_integer() of the parser library, so the result
+ * does not depend on the current locale.
+ *
+ * @param p_parse_ended when not NULL, receives the position where the
+ *                      parsing ended.  It equals the start position when
+ *                      the string does not start with a number.
+ */
 ORCUS_DLLPUBLIC double to_double(const char* p, const char* p_end, const char** p_parse_ended = NULL);
 ORCUS_DLLPUBLIC long to_long(const char* p, const char* p_end, const char** p_parse_ended = NULL);
 
+ORCUS_DLLPUBLIC double to_double(const pstring& s, const char** p_parse_ended = NULL);
+ORCUS_DLLPUBLIC long to_long(const pstring& s, const char** p_parse_ended = NULL);
+
 /**
  * Parse a string value containing a part representing a numerical value
  * optionally followed by a part representing a unit of measurement.
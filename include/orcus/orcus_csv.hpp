@@ -29,8 +29,9 @@
 #define __ORCUS_ORCUS_CSV_HPP__
 
 #include "env.hpp"
+#include "config.hpp"
 
-#include <string>
+#include <cstdlib>
 
 namespace orcus {
 
@@ -45,13 +46,24 @@ class ORCUS_DLLPUBLIC orcus_csv
 
 public:
     orcus_csv(spreadsheet::iface::import_factory* factory);
+
+    /**
+     * Set import options.  When the thread count is greater than 1, the
+     * content is split into that many chunks at row boundaries, the chunks
+     * get parsed concurrently on worker threads, and their cells are passed
+     * to the import factory on the calling thread in the original row order.
+     */
+    void set_config(const config& opt);
+
     void read_file(const char* filepath);
 
 private:
-    void parse(const std::string& strm);
+    void parse(const char* content, size_t size);
+    void parse_parallel(const char* content, size_t size);
 
 private:
     spreadsheet::iface::import_factory* mp_factory;
+    config m_config;
 };
 
 }
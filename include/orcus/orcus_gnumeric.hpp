@@ -36,7 +36,9 @@
 namespace orcus {
 
 namespace spreadsheet { namespace iface { class import_factory; }}
+namespace sax { class stream_source; }
 
+struct config;
 struct orcus_gnumeric_impl;
 
 class ORCUS_DLLPUBLIC orcus_gnumeric
@@ -46,10 +48,32 @@ public:
     orcus_gnumeric(spreadsheet::iface::import_factory* factory);
     ~orcus_gnumeric();
 
+    /**
+     * Set import options.  The thread count has no effect on this filter,
+     * since a gnumeric file consists of one single stream.
+     */
+    void set_config(const config& opt);
+
     void read_file(const char* fpath);
 
+    /**
+     * @return number of bytes of xml content that were skipped without
+     *         being parsed during the last read_file() call, because they
+     *         contain nothing that gets imported.
+     */
+    size_t get_skipped_bytes() const;
+
 private:
-    void read_content_xml(const char* p, size_t size);
+    /**
+     * Parse the decompressed content and finalize the document.
+     *
+     * @param p pointer to the null-terminated content.
+     * @param size number of bytes of the content available so far.
+     * @param source source to ask for more of the content as the parsing
+     *               progresses, or NULL if the content is available in its
+     *               entirety.
+     */
+    void read_content_xml(const char* p, size_t size, sax::stream_source* source);
 
 private:
     orcus_gnumeric_impl* mp_impl;
@@ -35,6 +35,7 @@ namespace orcus {
 
 namespace spreadsheet { namespace iface { class import_factory; }}
 
+struct config;
 struct orcus_ods_impl;
 class zip_archive;
 
@@ -49,12 +50,24 @@ public:
 
     static bool detect(const unsigned char* blob, size_t size);
 
+    /**
+     * Set import options.  The thread count is ignored; content.xml gets
+     * parsed on the calling thread.
+     */
+    void set_config(const config& opt);
+
     void read_file(const char* fpath);
 
+    /**
+     * @return number of bytes of xml content that were skipped without
+     *         being parsed during the last read_file() call, because they
+     *         contain nothing that gets imported.
+     */
+    size_t get_skipped_bytes() const;
+
 private:
     static void list_content(const zip_archive& archive);
     void read_content(const zip_archive& archive);
-    void read_content_xml(const unsigned char* p, size_t size);
 
 private:
     orcus_ods_impl* mp_impl;
@@ -35,6 +35,7 @@ namespace orcus {
 
 namespace spreadsheet { namespace iface { class import_factory; }}
 
+struct config;
 struct orcus_xls_xml_impl;
 
 class ORCUS_DLLPUBLIC orcus_xls_xml
@@ -46,6 +47,11 @@ public:
     orcus_xls_xml(spreadsheet::iface::import_factory* factory);
     ~orcus_xls_xml();
 
+    /**
+     * Set import options.  Only the trace is used by this filter.
+     */
+    void set_config(const config& opt);
+
     void read_file(const char* fpath);
 
 private:
@@ -36,6 +36,7 @@ namespace orcus {
 
 namespace spreadsheet { namespace iface { class import_factory; }}
 
+struct config;
 struct xlsx_rel_sheet_info;
 struct orcus_xlsx_impl;
 class xlsx_opc_handler;
@@ -53,8 +54,23 @@ public:
 
     static bool detect(const unsigned char* blob, size_t size);
 
+    /**
+     * Set import options.  When the thread count is greater than 1, sheet
+     * streams are inflated and parsed concurrently on worker threads, and
+     * the results are passed to the import factory on the calling thread in
+     * the original sheet order once all the other parts have been read.
+     */
+    void set_config(const config& opt);
+
     void read_file(const char* fpath);
 
+    /**
+     * @return number of bytes of xml content that were skipped without
+     *         being parsed during the last read_file() call, because they
+     *         contain nothing that gets imported.
+     */
+    size_t get_skipped_bytes() const;
+
 private:
 
     void read_workbook(const std::string& dir_path, const std::string& file_name);
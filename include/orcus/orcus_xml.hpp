@@ -35,6 +35,7 @@ namespace orcus {
 
 class pstring;
 class xmlns_repository;
+struct config;
 struct orcus_xml_impl;
 
 namespace spreadsheet { namespace iface {
@@ -61,6 +62,12 @@ public:
 
     void append_sheet(const pstring& name);
 
+    /**
+     * Set import options.  Only the trace applies to reading a mapped xml
+     * file.
+     */
+    void set_config(const config& opt);
+
     void read_file(const char* filepath);
     void write_file(const char* filepath);
 
@@ -37,6 +37,40 @@ ORCUS_DLLPUBLIC bool is_alpha(char c);
 ORCUS_DLLPUBLIC bool is_name_char(char c);
 ORCUS_DLLPUBLIC bool is_numeric(char c);
 
+/**
+ * Parse a decimal number in the form of
+ * [+-]digits[.digits][(e|E)[+-]digits].  The decimal separator is always
+ * '.' regardless of the current locale, and the result is the double
+ * nearest to the decimal value, the same as what strtod() would return.
+ *
+ * @param p pointer to the first character to parse.  On return it points
+ *          to the first character past the number.  It stays unchanged
+ *          when the string does not start with a number.
+ * @param p_end pointer to the end of the string.  The parser never reads
+ *              past it.
+ *
+ * @return parsed value, or 0.0 if no number was found.
+ */
+ORCUS_DLLPUBLIC double parse_numeric(const char*& p, const char* p_end);
+
+/**
+ * Parse a decimal integer in the form of [+-]digits.  A value that does not
+ * fit in long is clamped to LONG_MAX or LONG_MIN, as with strtol().
+ *
+ * @param p pointer to the first character to parse.  On return it points
+ *          to the first character past the number.  It stays unchanged
+ *          when the string does not start with an integer.
+ * @param p_end pointer to the end of the string.
+ *
+ * @return parsed value, or 0 if no integer was found.
+ */
+ORCUS_DLLPUBLIC long parse_integer(const char*& p, const char* p_end);
+
+/**
+ * @return current wall-clock time in seconds, for timing purposes.
+ */
+ORCUS_DLLPUBLIC double get_current_time();
+
 }
 
 #endif
@@ -31,8 +31,8 @@
 #include "sax_parser.hpp"
 #include "xml_namespace.hpp"
 
-#include <boost/unordered_set.hpp>
-#include <boost/ptr_container/ptr_vector.hpp>
+#include <vector>
+#include <algorithm>
 
 namespace orcus {
 
@@ -68,56 +68,69 @@ struct entity_name
     {
         return other.ns == ns && other.name == name;
     }
-
-    struct hash
-    {
-        size_t operator() (const entity_name& v) const
-        {
-            static pstring::hash hasher;
-            return hasher(v.ns) + hasher(v.name);
-        }
-    };
 };
 
-typedef boost::unordered_set<pstring, pstring::hash> ns_keys_type;
-typedef boost::unordered_set<entity_name, entity_name::hash> entity_names_type;
+/**
+ * Names of the attributes of the current element, to detect duplicates.
+ * Elements rarely have more than a handful of attributes, so a linear
+ * search through a vector that keeps its capacity between elements beats
+ * hashing.
+ */
+typedef std::vector<entity_name> entity_names_type;
+
+/**
+ * Namespace aliases declared by all the elements in the current scope
+ * stack, stored back to back in the order of declaration.
+ */
+typedef std::vector<pstring> ns_keys_type;
 
 struct elem_scope
 {
     xmlns_id_t ns;
     pstring name;
-    ns_keys_type ns_keys;
-};
-
-typedef boost::ptr_vector<elem_scope> elem_scopes_type;
+    size_t ns_key_count; // number of namespace aliases declared by this element.
 
-class pop_ns_by_key : std::unary_function<pstring, void>
-{
-    xmlns_context& m_cxt;
-public:
-    pop_ns_by_key(xmlns_context& cxt) : m_cxt(cxt) {}
-    void operator() (const pstring& key)
-    {
-        m_cxt.pop(key);
-    }
+    elem_scope(xmlns_id_t _ns, const pstring& _name, size_t _ns_key_count) :
+        ns(_ns), name(_name), ns_key_count(_ns_key_count) {}
 };
 
+/**
+ * Stack of open elements.  The scopes are stored by value, so the stack
+ * stops allocating once it has grown to the maximum element depth.
+ */
+typedef std::vector<elem_scope> elem_scopes_type;
+
 }
 
 /**
  * SAX based XML parser with proper namespace handling.
  */
-template<typename _Handler>
+template<typename _Handler, typename _Config = sax_parser_default_config>
 class sax_ns_parser
 {
 public:
     typedef _Handler handler_type;
+    typedef _Config config_type;
 
     sax_ns_parser(const char* content, const size_t size, xmlns_context& ns_cxt, handler_type& handler);
+    sax_ns_parser(const char* content, const size_t size, sax::stream_source& source, xmlns_context& ns_cxt, handler_type& handler);
     ~sax_ns_parser();
 
     void parse();
 
+    /**
+     * Skip the content of the element that has just been opened.  To be
+     * called from within the handler's start_element() call.
+     *
+     * @see sax::parser_base::skip_subtree()
+     */
+    void skip_subtree() { m_parser.skip_subtree(); }
+
+    /**
+     * @return total number of bytes skipped by skip_subtree() requests.
+     */
+    size_t get_skipped_bytes() const { return m_parser.get_skipped_bytes(); }
+
 private:
     /**
      * Re-route callbacks from the internal sax_parser into sax_ns_parser
@@ -135,10 +148,12 @@ private:
         xmlns_context& m_ns_cxt;
         handler_type& m_handler;
 
+        size_t m_ns_key_count; // number of namespace aliases declared by the next element.
         bool m_declaration;
 
     public:
-        handler_wrapper(xmlns_context& ns_cxt, handler_type& handler) : m_ns_cxt(ns_cxt), m_handler(handler), m_declaration(false) {}
+        handler_wrapper(xmlns_context& ns_cxt, handler_type& handler) :
+            m_ns_cxt(ns_cxt), m_handler(handler), m_ns_key_count(0), m_declaration(false) {}
 
         void doctype(const sax::doctype_declaration& dtd)
         {
@@ -159,11 +174,9 @@ private:
 
         void start_element(const sax::parser_element& elem)
         {
-            m_scopes.push_back(new __sax::elem_scope);
-            __sax::elem_scope& scope = m_scopes.back();
-            scope.ns = m_ns_cxt.get(elem.ns);
-            scope.name = elem.name;
-            scope.ns_keys.swap(m_ns_keys);
+            m_scopes.push_back(__sax::elem_scope(m_ns_cxt.get(elem.ns), elem.name, m_ns_key_count));
+            m_ns_key_count = 0;
+            const __sax::elem_scope& scope = m_scopes.back();
 
             m_elem.ns = scope.ns;
             m_elem.ns_alias = elem.ns;
@@ -177,7 +190,7 @@ private:
 
         void end_element(const sax::parser_element& elem)
         {
-            __sax::elem_scope& scope = m_scopes.back();
+            const __sax::elem_scope& scope = m_scopes.back();
             if (scope.ns != m_ns_cxt.get(elem.ns) || scope.name != elem.name)
                 throw sax::malformed_xml_error("mis-matching closing element.");
 
@@ -189,7 +202,11 @@ private:
             m_handler.end_element(m_elem);
 
             // Pop all namespaces declared in this scope.
-            std::for_each(scope.ns_keys.begin(), scope.ns_keys.end(), __sax::pop_ns_by_key(m_ns_cxt));
+            for (size_t i = 0; i < scope.ns_key_count; ++i)
+            {
+                m_ns_cxt.pop(m_ns_keys.back());
+                m_ns_keys.pop_back();
+            }
 
             m_scopes.pop_back();
         }
@@ -201,23 +218,25 @@ private:
 
         void attribute(const sax::parser_attribute& attr)
         {
-            if (m_declaration)
+            if (config_type::declaration_callbacks && m_declaration)
             {
                 // XML declaration attribute.  Pass it through to the handler without namespace.
                 m_handler.attribute(attr.name, attr.value);
                 return;
             }
 
-            if (m_attrs.count(__sax::entity_name(attr.ns, attr.name)) > 0)
+            __sax::entity_name attr_name(attr.ns, attr.name);
+            if (std::find(m_attrs.begin(), m_attrs.end(), attr_name) != m_attrs.end())
                 throw sax::malformed_xml_error("You can't define two attributes of the same name in the same element.");
 
-            m_attrs.insert(__sax::entity_name(attr.ns, attr.name));
+            m_attrs.push_back(attr_name);
 
             if (attr.ns.empty() && attr.name == "xmlns")
             {
                 // Default namespace
                 m_ns_cxt.push(pstring(), attr.value);
-                m_ns_keys.insert(pstring());
+                m_ns_keys.push_back(pstring());
+                ++m_ns_key_count;
                 return;
             }
 
@@ -227,7 +246,8 @@ private:
                 if (!attr.name.empty())
                 {
                     m_ns_cxt.push(attr.name, attr.value);
-                    m_ns_keys.insert(attr.name);
+                    m_ns_keys.push_back(attr.name);
+                    ++m_ns_key_count;
                 }
                 return;
             }
@@ -243,23 +263,30 @@ private:
 
 private:
     handler_wrapper m_wrapper;
-    sax_parser<handler_wrapper> m_parser;
+    sax_parser<handler_wrapper, config_type> m_parser;
 };
 
-template<typename _Handler>
-sax_ns_parser<_Handler>::sax_ns_parser(
+template<typename _Handler, typename _Config>
+sax_ns_parser<_Handler,_Config>::sax_ns_parser(
     const char* content, const size_t size, xmlns_context& ns_cxt, handler_type& handler) :
     m_wrapper(ns_cxt, handler), m_parser(content, size, m_wrapper)
 {
 }
 
-template<typename _Handler>
-sax_ns_parser<_Handler>::~sax_ns_parser()
+template<typename _Handler, typename _Config>
+sax_ns_parser<_Handler,_Config>::sax_ns_parser(
+    const char* content, const size_t size, sax::stream_source& source, xmlns_context& ns_cxt, handler_type& handler) :
+    m_wrapper(ns_cxt, handler), m_parser(content, size, source, m_wrapper)
+{
+}
+
+template<typename _Handler, typename _Config>
+sax_ns_parser<_Handler,_Config>::~sax_ns_parser()
 {
 }
 
-template<typename _Handler>
-void sax_ns_parser<_Handler>::parse()
+template<typename _Handler, typename _Config>
+void sax_ns_parser<_Handler,_Config>::parse()
 {
     m_parser.parse();
 }
@@ -41,6 +41,35 @@ struct sax_parser_default_config
      * <?xml..?> declaration.
      */
     static const bool strict_xml_declaration = true;
+
+    /**
+     * When true, the parser will parse a <!DOCTYPE ...> declaration and
+     * pass it to the handler's doctype() call.  When false, the code for it
+     * is compiled out, and the parser skips the declaration, including its
+     * internal subset if any, without any callbacks.
+     */
+    static const bool doctype = true;
+
+    /**
+     * When true, the parser will parse the attributes of <?xml ...?>
+     * declarations and processing instructions, and pass them to the
+     * handler between its start_declaration() and end_declaration() calls.
+     * When false, the parser checks only the declaration name and then
+     * skips to the end of the declaration without any callbacks.
+     */
+    static const bool declaration_callbacks = true;
+};
+
+/**
+ * Config for streams that are known to be machine generated, such as the
+ * xml parts of OOXML and ODF documents, which neither use DTDs nor carry
+ * anything of interest in their declarations.
+ */
+struct sax_parser_lean_config
+{
+    static const bool strict_xml_declaration = true;
+    static const bool doctype = false;
+    static const bool declaration_callbacks = false;
 };
 
 /**
@@ -55,6 +84,17 @@ public:
     typedef _Config config_type;
 
     sax_parser(const char* content, const size_t size, handler_type& handler);
+
+    /**
+     * Constructor for a stream whose content is made available
+     * progressively by a stream source while it gets parsed.
+     *
+     * @param content pointer to the buffer the stream gets written into.
+     * @param size number of bytes that are already available.
+     * @param source source that makes the rest of the stream available.
+     * @param handler handler to receive the callbacks.
+     */
+    sax_parser(const char* content, const size_t size, sax::stream_source& source, handler_type& handler);
     ~sax_parser();
 
     void parse();
@@ -89,6 +129,14 @@ sax_parser<_Handler,_Config>::sax_parser(
 {
 }
 
+template<typename _Handler, typename _Config>
+sax_parser<_Handler,_Config>::sax_parser(
+    const char* content, const size_t size, sax::stream_source& source, handler_type& handler) :
+    sax::parser_base(content, size, source),
+    m_handler(handler)
+{
+}
+
 template<typename _Handler, typename _Config>
 sax_parser<_Handler,_Config>::~sax_parser()
 {
@@ -190,6 +238,7 @@ void sax_parser<_Handler,_Config>::element_open(const char* begin_pos)
             elem.end_pos = m_char;
             m_handler.start_element(elem);
             reset_buffer_pos();
+            m_skip_subtree = false; // nothing to skip.
             m_handler.end_element(elem);
 #if ORCUS_DEBUG_SAX_PARSER
             cout << "element_open: ns='" << elem.ns << "', name='" << elem.name << "' (self-closing)" << endl;
@@ -204,6 +253,11 @@ void sax_parser<_Handler,_Config>::element_open(const char* begin_pos)
             nest_up();
             m_handler.start_element(elem);
             reset_buffer_pos();
+            if (m_skip_subtree)
+            {
+                m_skip_subtree = false;
+                skip_element_content();
+            }
 #if ORCUS_DEBUG_SAX_PARSER
             cout << "element_open: ns='" << elem.ns << "', name='" << elem.name << "'" << endl;
 #endif
@@ -241,7 +295,7 @@ void sax_parser<_Handler,_Config>::special_tag()
 {
     assert(cur_char() == '!');
     // This can be either <![CDATA, <!--, or <!DOCTYPE.
-    size_t len = remains();
+    size_t len = ensure_remains(5);
     if (len < 2)
         throw sax::malformed_xml_error("special tag too short.");
 
@@ -273,6 +327,12 @@ void sax_parser<_Handler,_Config>::special_tag()
         {
             // check if this is a DOCTYPE.
             expects_next("OCTYPE", 6);
+            if (!config_type::doctype)
+            {
+                skip_doctype();
+                break;
+            }
+
             blank();
             if (has_char())
                 doctype();
@@ -303,6 +363,12 @@ void sax_parser<_Handler,_Config>::declaration(const char* name_check)
         throw sax::malformed_xml_error(os.str());
     }
 
+    if (!config_type::declaration_callbacks)
+    {
+        skip_past("?>", 2);
+        return;
+    }
+
     m_handler.start_declaration(decl_name);
     blank();
 
@@ -326,14 +392,12 @@ void sax_parser<_Handler,_Config>::declaration(const char* name_check)
 template<typename _Handler, typename _Config>
 void sax_parser<_Handler,_Config>::cdata()
 {
-    size_t len = remains();
-    assert(len > 3);
-
     // Parse until we reach ']]>'.
     const char* p0 = m_char;
-    size_t i = 0, match = 0;
-    for (char c = cur_char(); i < len; ++i, c = next_char())
+    size_t match = 0;
+    for (; has_char(); next())
     {
+        char c = cur_char();
         if (c == ']')
         {
             // Be aware that we may encounter a series of more than two ']'
@@ -349,7 +413,7 @@ void sax_parser<_Handler,_Config>::cdata()
         else if (c == '>' && match == 2)
         {
             // Found ']]>'.
-            size_t cdata_len = i - 2;
+            size_t cdata_len = m_char - p0 - 2;
             m_handler.characters(pstring(p0, cdata_len), false);
             next();
             return;
@@ -369,7 +433,7 @@ void sax_parser<_Handler,_Config>::doctype()
     blank();
 
     // Either PUBLIC or SYSTEM.
-    size_t len = remains();
+    size_t len = ensure_remains(6);
     if (len < 6)
         sax::malformed_xml_error("DOCTYPE section too short.");
 
@@ -432,24 +496,20 @@ void sax_parser<_Handler,_Config>::characters()
 {
     size_t first = m_pos;
     const char* p0 = m_char;
-    for (; has_char(); next())
-    {
-        if (cur_char() == '<')
-            break;
+    skip_to('<', '&');
 
-        if (cur_char() == '&')
-        {
-            // Text span with one or more encoded characters. Parse using cell buffer.
-            cell_buffer& buf = get_cell_buffer();
-            buf.reset();
-            buf.append(p0, m_pos-first);
-            characters_with_encoded_char(buf);
-            if (buf.empty())
-                m_handler.characters(pstring(), false);
-            else
-                m_handler.characters(pstring(buf.get(), buf.size()), true);
-            return;
-        }
+    if (has_char() && cur_char() == '&')
+    {
+        // Text span with one or more encoded characters. Parse using cell buffer.
+        cell_buffer& buf = get_cell_buffer();
+        buf.reset();
+        buf.append(p0, m_pos-first);
+        characters_with_encoded_char(buf);
+        if (buf.empty())
+            m_handler.characters(pstring(), false);
+        else
+            m_handler.characters(pstring(buf.get(), buf.size()), true);
+        return;
     }
 
     if (m_pos > first)
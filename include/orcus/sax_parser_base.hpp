@@ -113,21 +113,73 @@ struct parser_attribute
     bool transient;  // whether or not the attribute value is on a temporary buffer.
 };
 
+/**
+ * Source of an xml stream whose content becomes available progressively,
+ * for instance while it is being decompressed.  The whole stream is written
+ * into a single buffer that is allocated in full up front and never moves,
+ * so the strings passed to the handler remain valid for the duration of the
+ * parsing just as they do with a stream that has been loaded in its
+ * entirety.  The buffer must be allocated with one extra null byte past the
+ * end of the stream.
+ */
+class ORCUS_DLLPUBLIC stream_source
+{
+public:
+    virtual ~stream_source() = 0;
+
+    /**
+     * Make more of the stream available to the parser.
+     *
+     * @param size number of bytes that are currently available.
+     *
+     * @return number of bytes available after the call.  The same value as
+     *         the passed size indicates that the end of the stream has been
+     *         reached.
+     */
+    virtual size_t fill(size_t size) = 0;
+};
+
 class ORCUS_DLLPUBLIC parser_base
 {
+public:
+    /**
+     * Have the parser skip the content of the element that has just been
+     * opened.  Call this from within the handler's start_element() call.
+     * The parser then fast-forwards to the matching closing tag without
+     * any callbacks for what lies in between, and calls end_element() for
+     * the element as usual.  The request is ignored for a self-closing
+     * element.
+     */
+    void skip_subtree() { m_skip_subtree = true; }
+
+    /**
+     * @return total number of bytes skipped by skip_subtree() requests.
+     */
+    size_t get_skipped_bytes() const { return m_skipped_bytes; }
+
 protected:
     boost::ptr_vector<cell_buffer> m_cell_buffers;
     const char* m_content;
     const char* m_char;
-    const size_t m_size;
+    stream_source* mp_source;
+    size_t m_size;
     size_t m_pos;
     size_t m_nest_level;
     size_t m_buffer_pos;
+    size_t m_skipped_bytes;
     bool m_root_elem_open:1;
+    bool m_skip_subtree:1;
 
 protected:
     parser_base(const char* content, size_t size);
 
+    /**
+     * @param content pointer to the buffer the stream gets written into.
+     * @param size number of bytes that are already available.
+     * @param source source that makes the rest of the stream available.
+     */
+    parser_base(const char* content, size_t size, stream_source& source);
+
     void next() { ++m_pos; ++m_char; }
 
     void next_check()
@@ -147,14 +199,60 @@ protected:
     void inc_buffer_pos();
     void reset_buffer_pos() { m_buffer_pos = 0; }
 
-    bool has_char() const { return m_pos < m_size; }
+    /**
+     * Move the current position forward to the first occurrence of either
+     * c1 or c2, or to the end of the stream if neither character is found.
+     * The stream is scanned 16 or 32 bytes at a time when the library is
+     * built with SSE2 or AVX2 enabled.
+     */
+    void skip_to(char c1, char c2);
+
+    /**
+     * Move the current position forward past the first occurrence of the
+     * n-byte terminator sequence.  Throws if the stream ends before it.
+     */
+    void skip_past(const char* term, size_t n);
+
+    /**
+     * Move the current position forward past the end of the DOCTYPE
+     * declaration whose keyword has just been read, skipping its internal
+     * subset if any.  Throws if the stream ends before it.
+     */
+    void skip_doctype();
+
+    /**
+     * Move the current position forward past the content of the element
+     * that has just been opened, up to the '<' of its closing tag.  Nothing
+     * gets parsed on the way other than what it takes to track the nesting
+     * of the elements inside, and to not get confused by the '<' and '>'
+     * characters in comments, CDATA sections and attribute values.
+     */
+    void skip_element_content();
+
+    /**
+     * Ask the stream source for more of the stream, if there is one.
+     *
+     * @return true if there are more bytes to read at the current position
+     *         after the call, false otherwise.
+     */
+    bool fill();
 
-    void has_char_throw(const char* msg) const
+    bool has_char() { return m_pos < m_size || fill(); }
+
+    void has_char_throw(const char* msg)
     {
         if (!has_char())
             throw malformed_xml_error(msg);
     }
 
+    /**
+     * Make sure that at least n bytes are available from the current
+     * position unless the stream ends before that.
+     *
+     * @return number of bytes available from the current position.
+     */
+    size_t ensure_remains(size_t n);
+
     inline size_t remains() const
     {
 #if ORCUS_DEBUG_SAX_PARSER
@@ -164,16 +262,20 @@ protected:
         return m_size - m_pos;
     }
 
-    char cur_char() const
+    char cur_char()
     {
+        if (ORCUS_UNLIKELY(m_pos >= m_size))
+        {
+            fill();
 #if ORCUS_DEBUG_SAX_PARSER
-        if (m_pos >= m_size)
-            throw malformed_xml_error("xml stream ended prematurely.");
+            if (m_pos >= m_size)
+                throw malformed_xml_error("xml stream ended prematurely.");
 #endif
+        }
         return *m_char;
     }
 
-    char cur_char_checked() const
+    char cur_char_checked()
     {
         if (!has_char())
             throw malformed_xml_error("xml stream ended prematurely.");
@@ -184,11 +286,7 @@ protected:
     char next_char()
     {
         next();
-#if ORCUS_DEBUG_SAX_PARSER
-        if (m_pos >= m_size)
-            throw malformed_xml_error("xml stream ended prematurely.");
-#endif
-        return *m_char;
+        return cur_char();
     }
 
     char next_char_checked()
@@ -77,18 +77,35 @@ struct sax_token_parser_element
 /**
  * XML parser that tokenizes element and attribute names while parsing.
  */
-template<typename _Handler, typename _Tokens>
+template<typename _Handler, typename _Tokens, typename _Config = sax_parser_default_config>
 class sax_token_parser
 {
 public:
     typedef _Handler    handler_type;
     typedef _Tokens     tokens_map;
+    typedef _Config     config_type;
 
     sax_token_parser(const char* content, const size_t size, const tokens_map& tokens, xmlns_context& ns_cxt, handler_type& handler);
+    sax_token_parser(
+        const char* content, const size_t size, sax::stream_source& source,
+        const tokens_map& tokens, xmlns_context& ns_cxt, handler_type& handler);
     ~sax_token_parser();
 
     void parse();
 
+    /**
+     * Skip the content of the element that has just been opened.  To be
+     * called from within the handler's start_element() call.
+     *
+     * @see sax::parser_base::skip_subtree()
+     */
+    void skip_subtree() { m_parser.skip_subtree(); }
+
+    /**
+     * @return total number of bytes skipped by skip_subtree() requests.
+     */
+    size_t get_skipped_bytes() const { return m_parser.get_skipped_bytes(); }
+
 private:
 
     /**
@@ -160,11 +177,11 @@ private:
 private:
     xmlns_context& m_ns_cxt;
     handler_wrapper m_wrapper;
-    sax_ns_parser<handler_wrapper> m_parser;
+    sax_ns_parser<handler_wrapper, config_type> m_parser;
 };
 
-template<typename _Handler, typename _Tokens>
-sax_token_parser<_Handler,_Tokens>::sax_token_parser(
+template<typename _Handler, typename _Tokens, typename _Config>
+sax_token_parser<_Handler,_Tokens,_Config>::sax_token_parser(
     const char* content, const size_t size, const tokens_map& tokens, xmlns_context& ns_cxt, handler_type& handler) :
     m_ns_cxt(ns_cxt),
     m_wrapper(tokens, handler),
@@ -172,13 +189,23 @@ sax_token_parser<_Handler,_Tokens>::sax_token_parser(
 {
 }
 
-template<typename _Handler, typename _Tokens>
-sax_token_parser<_Handler,_Tokens>::~sax_token_parser()
+template<typename _Handler, typename _Tokens, typename _Config>
+sax_token_parser<_Handler,_Tokens,_Config>::sax_token_parser(
+    const char* content, const size_t size, sax::stream_source& source,
+    const tokens_map& tokens, xmlns_context& ns_cxt, handler_type& handler) :
+    m_ns_cxt(ns_cxt),
+    m_wrapper(tokens, handler),
+    m_parser(content, size, source, m_ns_cxt, m_wrapper)
+{
+}
+
+template<typename _Handler, typename _Tokens, typename _Config>
+sax_token_parser<_Handler,_Tokens,_Config>::~sax_token_parser()
 {
 }
 
-template<typename _Handler, typename _Tokens>
-void sax_token_parser<_Handler,_Tokens>::parse()
+template<typename _Handler, typename _Tokens, typename _Config>
+void sax_token_parser<_Handler,_Tokens,_Config>::parse()
 {
     m_parser.parse();
 }
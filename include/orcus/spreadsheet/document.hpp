@@ -32,6 +32,7 @@
 #include "orcus/spreadsheet/types.hpp"
 
 #include <ostream>
+#include <cstdlib>
 
 namespace ixion {
     class model_context;
@@ -41,6 +42,8 @@ namespace ixion {
 namespace orcus {
 
 class pstring;
+class import_trace;
+struct date_time_t;
 
 namespace spreadsheet {
 
@@ -80,8 +83,61 @@ public:
     sheet* get_sheet(sheet_t sheet_pos);
     const sheet* get_sheet(sheet_t sheet_pos) const;
 
+    /**
+     * Calculate all formula cells that have been marked dirty since the last
+     * calculation.  The cells are calculated using as many threads as set
+     * by set_formula_calc_threads().
+     */
     void calc_formulas();
 
+    /**
+     * Set the number of worker threads ixion may use to calculate formula
+     * cells.  A value of 0, which is the default, makes it calculate all
+     * cells on the calling thread.
+     *
+     * @param n number of worker threads.
+     */
+    void set_formula_calc_threads(size_t n);
+
+    size_t get_formula_calc_threads() const;
+
+    /**
+     * Set whether to trust the formula results cached in the imported file.
+     * When trusted, finalize() doesn't calculate the formula cells, and the
+     * cells report their cached results until calc_formulas() gets called.
+     * The default is not to trust them.
+     *
+     * @param b true to trust the cached formula results, false otherwise.
+     */
+    void set_trust_cached_results(bool b);
+
+    bool get_trust_cached_results() const;
+
+    /**
+     * Set the number of threads used to tokenize formula expressions.  A
+     * value of 0, which is the default, makes each formula get tokenized
+     * as it is imported.  A positive value defers tokenization to
+     * finalize(), where the recorded formula strings get tokenized in
+     * parallel batches before their dependencies are registered.
+     *
+     * @param n number of tokenizer threads, or 0 to tokenize on import.
+     */
+    void set_formula_tokenize_threads(size_t n);
+
+    size_t get_formula_tokenize_threads() const;
+
+    /**
+     * Set the number of threads finalize() may use to finalize the sheets.
+     * A value of 0 or 1, which is the default, finalizes them one after
+     * another on the calling thread.  With a trace set, the time each
+     * sheet takes is recorded under the sheet's name.
+     *
+     * @param n number of finalizer threads.
+     */
+    void set_finalize_threads(size_t n);
+
+    size_t get_finalize_threads() const;
+
     void swap(document& other);
 
     /**
@@ -115,13 +171,34 @@ public:
 
     void set_origin_date(int year, int month, int day);
 
+    /**
+     * Get the date that serial date values are relative to.  It defaults to
+     * 1899-12-30 when the document doesn't specify one.
+     */
+    const date_time_t& get_origin_date() const;
+
     ixion::model_context& get_model_context();
     const ixion::model_context& get_model_context() const;
 
+    /**
+     * Finalize the sheets and calculate the formula cells, unless the cached
+     * formula results are trusted.
+     */
     void finalize();
 
+    /**
+     * Set a trace to record formula calculation on.  The import factory
+     * sets this for the duration of an import when the filter is given a
+     * trace.
+     *
+     * @param trace trace to record on, or NULL to record nothing.
+     */
+    void set_trace(import_trace* trace);
+
 private:
     void insert_dirty_cell(const ixion::abs_address_t& pos);
+    void insert_deferred_formula(const ixion::abs_address_t& pos, const char* p, size_t n);
+    void tokenize_formulas();
 
 private:
     document_impl* mp_impl;
@@ -48,6 +48,7 @@ public:
     virtual iface::import_sheet* append_sheet(const char* sheet_name, size_t sheet_name_length);
     virtual iface::import_sheet* get_sheet(const char* sheet_name, size_t sheet_name_length);
     virtual void finalize();
+    virtual void set_trace(import_trace* trace);
 
 private:
     document* mp_document;
@@ -34,7 +34,11 @@
 #include "../types.hpp"
 #include "../env.hpp"
 
-namespace orcus { namespace spreadsheet { namespace iface {
+namespace orcus {
+
+class import_trace;
+
+namespace spreadsheet { namespace iface {
 
 /**
  * Interface class designed to be derived by the implementor.
@@ -210,6 +214,80 @@ public:
      */
     virtual void set_bool(orcus::spreadsheet::row_t row, orcus::spreadsheet::col_t col, bool value) = 0;
 
+    /**
+     * Set numerical values to a block of cells that are next to each other
+     * in the same row.  Filters use this instead of set_value() to pass a
+     * run of numeric cells in one call.  The default implementation calls
+     * set_value() for each cell.
+     *
+     * @param row row ID
+     * @param col column ID of the first cell in the block
+     * @param values array of values being assigned to the cells
+     * @param n number of cells in the block
+     */
+    virtual void set_values(
+        orcus::spreadsheet::row_t row, orcus::spreadsheet::col_t col, const double* values, size_t n);
+
+    /**
+     * Set string values to a block of cells that are next to each other in
+     * the same row.  The default implementation calls set_string() for each
+     * cell.
+     *
+     * @param row row ID
+     * @param col column ID of the first cell in the block
+     * @param sindices array of 0-based string indices in the shared string
+     *                 table
+     * @param n number of cells in the block
+     */
+    virtual void set_strings(
+        orcus::spreadsheet::row_t row, orcus::spreadsheet::col_t col, const size_t* sindices, size_t n);
+
+    /**
+     * Set boolean values to a block of cells that are next to each other in
+     * the same row.  The default implementation calls set_bool() for each
+     * cell.
+     *
+     * @param row row ID
+     * @param col column ID of the first cell in the block
+     * @param values array of boolean values being assigned to the cells
+     * @param n number of cells in the block
+     */
+    virtual void set_bools(
+        orcus::spreadsheet::row_t row, orcus::spreadsheet::col_t col, const bool* values, size_t n);
+
+    /**
+     * Set the same numerical value to all cells in a rectangular range.
+     * Filters use this for cells that the document marks as repeated, so
+     * that a long run costs a single call, and clip the range to the sheet
+     * before passing it.  The default implementation calls set_value() for
+     * each cell, which costs one call per cell; override it if the
+     * implementation can store a block of cells at once.
+     *
+     * @param row1 row ID of the top edge of the range
+     * @param col1 column ID of the left edge of the range
+     * @param row2 row ID of the bottom edge of the range (inclusive)
+     * @param col2 column ID of the right edge of the range (inclusive)
+     * @param value value being assigned to the cells
+     */
+    virtual void set_value_range(
+        orcus::spreadsheet::row_t row1, orcus::spreadsheet::col_t col1,
+        orcus::spreadsheet::row_t row2, orcus::spreadsheet::col_t col2, double value);
+
+    /**
+     * Set the same string value to all cells in a rectangular range.  The
+     * default implementation calls set_string() for each cell, which costs
+     * one call per cell.
+     *
+     * @param row1 row ID of the top edge of the range
+     * @param col1 column ID of the left edge of the range
+     * @param row2 row ID of the bottom edge of the range (inclusive)
+     * @param col2 column ID of the right edge of the range (inclusive)
+     * @param sindex 0-based string index in the shared string table
+     */
+    virtual void set_string_range(
+        orcus::spreadsheet::row_t row1, orcus::spreadsheet::col_t col1,
+        orcus::spreadsheet::row_t row2, orcus::spreadsheet::col_t col2, size_t sindex);
+
     /**
      * Set date and time value to a cell.
      *
@@ -230,6 +308,22 @@ public:
      */
     virtual void set_format(orcus::spreadsheet::row_t row, orcus::spreadsheet::col_t col, size_t xf_index) = 0;
 
+    /**
+     * Set the same cell format to all cells in a rectangular range.  The
+     * default implementation calls set_format() for each cell, which costs
+     * one call per cell.  Filters don't pass the format-only ranges that
+     * only extend a format past the last row with values.
+     *
+     * @param row1 row ID of the top edge of the range
+     * @param col1 column ID of the left edge of the range
+     * @param row2 row ID of the bottom edge of the range (inclusive)
+     * @param col2 column ID of the right edge of the range (inclusive)
+     * @param xf_index 0-based xf (cell format) index
+     */
+    virtual void set_format_range(
+        orcus::spreadsheet::row_t row1, orcus::spreadsheet::col_t col1,
+        orcus::spreadsheet::row_t row2, orcus::spreadsheet::col_t col2, size_t xf_index);
+
     /**
      * Set normal, non-shared formula expression to specified cell.
      *
@@ -349,10 +443,10 @@ public:
  * inside it and have the document instance manage the life cycles of
  * various objects it creates.
  */
-class import_factory
+class ORCUS_DLLPUBLIC import_factory
 {
 public:
-    ORCUS_DLLPUBLIC virtual ~import_factory() = 0;
+    virtual ~import_factory() = 0;
 
     virtual import_global_settings* get_global_settings() = 0;
 
@@ -386,6 +480,16 @@ public:
      * chance to perform post-processing if necessary.
      */
     virtual void finalize() = 0;
+
+    /**
+     * Filters call this with the trace passed to them via config::trace at
+     * the start of an import, and with NULL at the end, so that the
+     * implementor can record events of its own work on the trace, such as
+     * formula calculation.  The default implementation does nothing.
+     *
+     * @param trace trace to record events on, or NULL.
+     */
+    virtual void set_trace(import_trace* trace);
 };
 
 }}}
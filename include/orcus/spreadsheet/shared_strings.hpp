@@ -37,6 +37,7 @@
 
 #include <boost/noncopyable.hpp>
 #include <boost/unordered_map.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
 
 namespace ixion { class model_context; }
 
@@ -63,7 +64,29 @@ struct ORCUS_DLLPUBLIC format_run
     bool formatted() const;
 };
 
-typedef std::vector<format_run> format_runs_t;
+/**
+ * Format runs of a single string.  It refers to the run storage of the
+ * shared strings it was obtained from, which never moves the runs of a
+ * committed string, and stays valid for as long as that instance lives.
+ */
+class ORCUS_DLLPUBLIC format_runs_t
+{
+    const format_run* mp_begin;
+    const format_run* mp_end;
+
+public:
+    typedef const format_run* const_iterator;
+
+    format_runs_t() : mp_begin(NULL), mp_end(NULL) {}
+    format_runs_t(const format_run* p_begin, const format_run* p_end) :
+        mp_begin(p_begin), mp_end(p_end) {}
+
+    const_iterator begin() const { return mp_begin; }
+    const_iterator end() const { return mp_end; }
+    size_t size() const { return mp_end - mp_begin; }
+    bool empty() const { return mp_begin == mp_end; }
+    const format_run& operator[] (size_t i) const { return mp_begin[i]; }
+};
 
 /**
  * This class handles global pool of string instances.
@@ -74,10 +97,44 @@ class ORCUS_DLLPUBLIC import_shared_strings : public iface::import_shared_string
 
     import_shared_strings(); // disabled
 
+    /**
+     * Range of the format runs of one string in one of the run blocks.  An
+     * empty range means the string is unformatted.
+     */
+    struct run_range
+    {
+        const format_run* begin;
+        const format_run* end;
+
+        run_range() : begin(NULL), end(NULL) {}
+    };
+
+    typedef std::vector<run_range> run_index_type;
+    typedef std::vector<format_run> run_block_type;
+    typedef boost::ptr_vector<run_block_type> run_blocks_type;
+
 public:
 
-    // format runs for all shared strings, mapped by string IDs.
-    typedef boost::unordered_map<size_t, format_runs_t*> format_runs_map_type;
+    /**
+     * Memory usage of the format runs.
+     */
+    struct stats
+    {
+        /** Number of strings that have format runs. */
+        size_t formatted_string_count;
+        /** Number of format runs of all strings. */
+        size_t run_count;
+        /**
+         * Bytes allocated for the run index and for the flags of the
+         * strings committed via commit_segments(), both of which are
+         * aligned with the string IDs.
+         */
+        size_t index_bytes;
+        /** Bytes allocated for the run blocks. */
+        size_t pool_bytes;
+
+        stats();
+    };
 
     import_shared_strings(orcus::string_pool& sp, ixion::model_context& cxt, import_styles& styles);
     virtual ~import_shared_strings();
@@ -93,10 +150,22 @@ public:
     virtual void append_segment(const char* s, size_t n);
     virtual size_t commit_segments();
 
-    const format_runs_t* get_format_runs(size_t index) const;
+    /**
+     * Get the format runs of a string.
+     *
+     * @param index string ID.
+     *
+     * @return format runs of the string, which are empty if the string is
+     *         unformatted.  When the same string has been committed more
+     *         than once via commit_segments(), they are the ones of the
+     *         first commit, even if that one had no format runs.
+     */
+    format_runs_t get_format_runs(size_t index) const;
 
     const std::string* get_string(size_t index) const;
 
+    stats get_stats() const;
+
     void dump() const;
 
 private:
@@ -104,15 +173,30 @@ private:
     ixion::model_context& m_cxt;
     import_styles& m_styles;
 
+    void push_run(const format_run& run);
+
+    /**
+     * Ranges of the format runs in the run blocks, indexed by string IDs.
+     * It only extends as far as the largest ID of a formatted string.
+     */
+    run_index_type m_run_index;
+
+    /**
+     * Flags of the string IDs that have been committed via
+     * commit_segments(), to keep the format runs of the first commit.
+     */
+    std::vector<bool> m_committed;
+
     /**
-     * Container for all format runs of all formatted strings.  Format runs
-     * are mapped with the string IDs.
+     * Format runs of all formatted strings.  Each block is allocated with
+     * a fixed capacity and never grows past it, so that the runs stay put.
+     * The runs of the string being built are at the end of the last block.
      */
-    format_runs_map_type m_formats;
+    run_blocks_type m_run_blocks;
 
     ::std::string   m_cur_segment_string;
     format_run      m_cur_format;
-    format_runs_t* mp_cur_format_runs;
+    size_t          m_cur_run_begin; /// position of the first run of the string being built in the last block.
     str_index_map_type m_set;
 };
 
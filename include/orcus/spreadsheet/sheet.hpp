@@ -66,8 +66,14 @@ public:
     virtual void set_string(row_t row, col_t col, size_t sindex);
     virtual void set_value(row_t row, col_t col, double value);
     virtual void set_bool(row_t row, col_t col, bool value);
+    virtual void set_values(row_t row, col_t col, const double* values, size_t n);
+    virtual void set_strings(row_t row, col_t col, const size_t* sindices, size_t n);
+    virtual void set_bools(row_t row, col_t col, const bool* values, size_t n);
+    virtual void set_value_range(row_t row1, col_t col1, row_t row2, col_t col2, double value);
+    virtual void set_string_range(row_t row1, col_t col1, row_t row2, col_t col2, size_t sindex);
     virtual void set_date_time(row_t row, col_t col, int year, int month, int day, int hour, int minute, double second);
     virtual void set_format(row_t row, col_t col, size_t index);
+    virtual void set_format_range(row_t row1, col_t col1, row_t row2, col_t col2, size_t index);
     virtual void set_formula(row_t row, col_t col, formula_grammar_t grammar, const char* p, size_t n);
     virtual void set_shared_formula(
         row_t row, col_t col, formula_grammar_t grammar, size_t sindex,
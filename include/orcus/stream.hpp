@@ -30,10 +30,47 @@
 
 #include "env.hpp"
 
+#include <cstdlib>
 #include <string>
 
 namespace orcus {
 
+class file_content_impl;
+
+/**
+ * Read-only view of the content of a file.  The file gets mapped into
+ * memory rather than read into a buffer, so no copy of its content is
+ * made, and it stays mapped for the lifetime of the instance.  As with a
+ * std::string, the byte past the end of the content is readable and is
+ * always a null character.
+ */
+class ORCUS_DLLPUBLIC file_content
+{
+    file_content_impl* mp_impl;
+
+    file_content(const file_content&); // disabled
+    file_content& operator= (const file_content&); // disabled
+
+public:
+    /**
+     * @param filepath file to open
+     */
+    file_content(const char* filepath);
+    ~file_content();
+
+    /**
+     * @return pointer to the first byte of the file content.
+     */
+    const char* data() const;
+
+    /**
+     * @return size of the file content in bytes.
+     */
+    size_t size() const;
+
+    bool empty() const;
+};
+
 /**
  * Load the content of a file into a file stream.
  *
@@ -28,10 +28,8 @@
 #ifndef __ORCUS_STRING_POOL_HPP__
 #define __ORCUS_STRING_POOL_HPP__
 
-#include <string>
-#include <boost/unordered_set.hpp>
-#include <boost/ptr_container/ptr_vector.hpp>
-#include <boost/functional/hash.hpp>
+#include <cstdlib>
+#include <vector>
 
 #include "env.hpp"
 #include "pstring.hpp"
@@ -39,28 +37,53 @@
 namespace orcus {
 
 /**
- * Implements string hash map.
+ * Implements string hash map.  Interned strings are stored back-to-back in
+ * memory blocks that never move nor get freed until the pool is cleared or
+ * destroyed, and they are indexed by an open-addressing hash table with
+ * linear probing.
  */
 class ORCUS_DLLPUBLIC string_pool
 {
-    struct string_hash
-    {
-        size_t operator() (const std::string* p) const;
-    private:
-        boost::hash<std::string> m_hash;
-    };
+    string_pool(const string_pool&); // disabled
+    string_pool& operator=(const string_pool&); // disabled
 
-    struct string_equal_to
+    struct entry
     {
-        bool operator() (const std::string* p1, const std::string* p2) const;
-    private:
-        std::equal_to<std::string> m_equal_to;
+        const char* str;
+        size_t size;
+        size_t hash;
     };
 
-    typedef boost::unordered_set<pstring, pstring::hash> string_set_type;
-    typedef boost::ptr_vector<std::string> string_store_type;
+    typedef std::vector<entry> index_type;
+    typedef std::vector<char*> block_store_type;
 
 public:
+
+    /**
+     * Memory usage and lookup statistics of a string pool.
+     */
+    struct stats
+    {
+        /** Number of interned strings. */
+        size_t entry_count;
+        /** Number of slots in the hash index. */
+        size_t slot_count;
+        /** Bytes used by the interned strings including their terminators. */
+        size_t string_bytes;
+        /** Bytes allocated for the memory blocks that store the strings. */
+        size_t block_bytes;
+        /** Bytes allocated for the hash index. */
+        size_t index_bytes;
+        /** Number of non-empty strings passed to intern(). */
+        size_t lookup_count;
+        /** Total number of index slots examined by those lookups. */
+        size_t probe_count;
+        /** Largest number of index slots examined by a single lookup. */
+        size_t max_probe_length;
+
+        stats();
+    };
+
     string_pool();
     ~string_pool();
 
@@ -99,9 +122,38 @@ public:
     void clear();
     size_t size() const;
 
+    stats get_stats() const;
+
+private:
+    /**
+     * Copy a string into the current memory block, followed by a null
+     * terminator.  A new block gets allocated when the current one is full.
+     */
+    const char* store(const char* str, size_t n);
+
+    /**
+     * Double the size of the hash index, and re-insert all its entries.
+     */
+    void grow_index();
+
+    /**
+     * Find the slot that stores the string, or the empty slot where it
+     * should be inserted.
+     */
+    entry* find_slot(const char* str, size_t n, size_t hash, size_t& probe_length);
+
 private:
-    string_set_type m_set;
-    string_store_type m_store;
+    index_type m_index;
+    block_store_type m_blocks;
+    char* mp_block_pos;
+    size_t m_block_remaining;
+    size_t m_block_size;
+    size_t m_size;
+    size_t m_string_bytes;
+    size_t m_block_bytes;
+    size_t m_lookup_count;
+    size_t m_probe_count;
+    size_t m_max_probe_length;
 };
 
 }
@@ -38,12 +38,38 @@ namespace orcus {
 
 class pstring;
 
+/**
+ * Minimal perfect hash table of a fixed set of token names.  The token
+ * generator scripts under misc emit one for each token set along with the
+ * token names.
+ */
+struct token_hash_table
+{
+    /** displacement value for each bucket. */
+    const unsigned int* displacements;
+    size_t bucket_count;
+
+    /** token value stored in each slot. */
+    const xml_token_t* slots;
+    size_t slot_count;
+};
+
 class tokens
 {
 public:
 
     tokens(const char** token_names, size_t token_name_count);
 
+    /**
+     * Constructor for a token set that comes with a pre-generated perfect
+     * hash table, which get_token() then uses instead of a hash map.
+     *
+     * @param token_names array of token names.
+     * @param token_name_count number of token names.
+     * @param hash_table perfect hash table of the token names.
+     */
+    tokens(const char** token_names, size_t token_name_count, const token_hash_table& hash_table);
+
     /**
      * Check if a token returned from get_token() method is valid.
      *
@@ -75,6 +101,7 @@ private:
     token_map_type   m_tokens;
     const char** m_token_names;
     size_t m_token_name_count;
+    const token_hash_table* mp_hash_table;
 };
 
 }
@@ -40,6 +40,7 @@ namespace orcus {
 
 class zip_archive_stream;
 class zip_archive_impl;
+class zip_file_entry_reader_impl;
 class pstring;
 
 class ORCUS_DLLPUBLIC zip_error : public std::exception
@@ -53,8 +54,32 @@ public:
     virtual const char* what() const throw();
 };
 
+/**
+ * Backend used to decompress deflated file entries.  The default backend
+ * is zlib, unless the library is configured with --with-zip-inflate=builtin.
+ */
+enum zip_inflate_backend_t
+{
+    /**
+     * zlib's inflate, which reads the compressed data through a window of
+     * fixed size.
+     */
+    zip_inflate_zlib,
+
+    /**
+     * In-tree decoder, which takes the compressed data of an entry in its
+     * entirety, and makes use of the uncompressed size known from the
+     * central directory to decode straight into the destination buffer.
+     * It is used only when the archive stream holds the data in memory;
+     * zlib is used otherwise.
+     */
+    zip_inflate_builtin
+};
+
 class ORCUS_DLLPUBLIC zip_archive
 {
+    friend class zip_file_entry_reader;
+
     zip_archive_impl* mp_impl;
 
     zip_archive(); // disabled
@@ -117,6 +142,87 @@ public:
      * @return true if successful, false otherwise.
      */
     bool read_file_entry(const pstring& entry_name, std::vector<unsigned char>& buf) const;
+
+    /**
+     * Set the backend to decompress deflated file entries with.  It applies
+     * to file entries opened after the call.
+     *
+     * @param backend decompression backend.
+     */
+    void set_inflate_backend(zip_inflate_backend_t backend);
+
+    /**
+     * @return backend used to decompress deflated file entries.
+     */
+    zip_inflate_backend_t get_inflate_backend() const;
+};
+
+/**
+ * Reader for the data stream of a single file entry, which retrieves the
+ * data stream one segment at a time.  Compressed data gets inflated
+ * directly into the buffer passed by the caller.  With the zlib backend,
+ * the compressed data is read from the archive stream through a window of
+ * fixed size, so it is never held in memory in its entirety.
+ */
+class ORCUS_DLLPUBLIC zip_file_entry_reader
+{
+    zip_file_entry_reader_impl* mp_impl;
+
+    zip_file_entry_reader(const zip_file_entry_reader&); // disabled
+    zip_file_entry_reader& operator= (const zip_file_entry_reader&); // disabled
+
+public:
+    zip_file_entry_reader();
+    ~zip_file_entry_reader();
+
+    /**
+     * Open a file entry for reading.  The archive instance must stay alive
+     * while the entry is being read.
+     *
+     * @param archive archive that contains the file entry.
+     * @param entry_name file entry name.
+     *
+     * @return true if the entry is found and its compression method is
+     *         supported, false otherwise.
+     */
+    bool open(const zip_archive& archive, const pstring& entry_name);
+
+    /**
+     * @return size of the data stream of the opened file entry after
+     *         decompression.
+     */
+    size_t size() const;
+
+    /**
+     * Get direct access to the data stream of the opened file entry without
+     * copying it.  This is only possible when the entry is stored without
+     * compression, and the archive stream holds its content in memory as
+     * zip_archive_stream_mmap does.  At least one byte past the end of the
+     * data stream is readable, but it belongs to whatever follows the entry
+     * in the archive, and is not necessarily a null byte.
+     *
+     * @return pointer to the first byte of the data stream, or NULL if
+     *         direct access is not possible.
+     */
+    const unsigned char* data() const;
+
+    /**
+     * Read the next segment of the data stream of the opened file entry.
+     *
+     * When the builtin inflate backend is used, segments read into
+     * consecutive positions of one buffer are decoded in place, with the
+     * previous segments serving as the history for back references.  Such
+     * segments must be left intact until the whole data stream is read.
+     * Reading a segment anywhere else switches the rest of the data stream
+     * over to zlib.
+     *
+     * @param buf buffer to write the data into.
+     * @param n maximum number of bytes to write.
+     *
+     * @return number of bytes written to the buffer, which is less than n
+     *         only when the end of the data stream has been reached.
+     */
+    size_t read(unsigned char* buf, size_t n);
 };
 
 }
@@ -34,6 +34,8 @@
 
 namespace orcus {
 
+class file_content;
+
 class ORCUS_DLLPUBLIC zip_archive_stream
 {
 public:
@@ -43,6 +45,19 @@ public:
     virtual size_t tell() const = 0;
     virtual void seek(size_t pos) = 0;
     virtual void read(unsigned char* buffer, size_t length) const = 0;
+
+    /**
+     * Get direct access to a segment of the stream, for streams whose
+     * content is already in memory.  The default implementation returns
+     * NULL.
+     *
+     * @param pos position of the first byte of the segment.
+     * @param length length of the segment.
+     *
+     * @return pointer to the first byte of the segment, or NULL if the
+     *         stream doesn't support direct access.
+     */
+    virtual const unsigned char* get_memory(size_t pos, size_t length) const;
 };
 
 /**
@@ -65,6 +80,33 @@ public:
     virtual void read(unsigned char* buffer, size_t length) const;
 };
 
+/**
+ * Zip archive based on a memory-mapped file.  The file gets mapped in its
+ * entirety at instantiation time, and every read is served directly from
+ * the mapped memory without a system call.
+ */
+class ORCUS_DLLPUBLIC zip_archive_stream_mmap : public zip_archive_stream
+{
+    file_content* mp_content;
+    const unsigned char* m_data;
+    size_t m_size;
+    mutable size_t m_pos;
+
+    zip_archive_stream_mmap(); // disabled
+    zip_archive_stream_mmap(const zip_archive_stream_mmap&); // disabled
+    zip_archive_stream_mmap& operator= (const zip_archive_stream_mmap&); // disabled
+
+public:
+    zip_archive_stream_mmap(const char* filepath);
+    virtual ~zip_archive_stream_mmap();
+
+    virtual size_t size() const;
+    virtual size_t tell() const;
+    virtual void seek(size_t pos);
+    virtual void read(unsigned char* buffer, size_t length) const;
+    virtual const unsigned char* get_memory(size_t pos, size_t length) const;
+};
+
 /**
  * Zip archive whose content is already loaded onto memory.
  */
@@ -83,6 +125,7 @@ public:
     virtual size_t tell() const;
     virtual void seek(size_t pos);
     virtual void read(unsigned char* buffer, size_t length) const;
+    virtual const unsigned char* get_memory(size_t pos, size_t length) const;
 };
 
 }
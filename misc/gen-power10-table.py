@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+########################################################################
+#
+#  Copyright (c) 2013 Kohei Yoshida
+#
+#  Permission is hereby granted, free of charge, to any person
+#  obtaining a copy of this software and associated documentation
+#  files (the "Software"), to deal in the Software without
+#  restriction, including without limitation the rights to use,
+#  copy, modify, merge, publish, distribute, sublicense, and/or sell
+#  copies of the Software, and to permit persons to whom the
+#  Software is furnished to do so, subject to the following
+#  conditions:
+#
+#  The above copyright notice and this permission notice shall be
+#  included in all copies or substantial portions of the Software.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+#  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+#  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+#  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+#  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+#  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+#  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+#  OTHER DEALINGS IN THE SOFTWARE.
+#
+########################################################################
+
+# Generate the table of 128-bit truncated powers of ten used by the
+# Eisel-Lemire decimal-to-double conversion in src/parser/parser_global.cpp.
+#
+# Each entry holds the 128 most significant bits of 10^q (rounded down),
+# normalized so that the highest bit is set.  The high 64 bits come first.
+
+import argparse, sys
+
+min_exp10 = -342
+max_exp10 = 308
+
+def truncated_mantissa(q):
+    if q >= 0:
+        v = 10 ** q
+        while v < (1 << 127):
+            v <<= 1
+        while v >= (1 << 128):
+            v >>= 1
+        return v
+
+    d = 10 ** -q
+    k = 0
+    while (1 << k) < d:
+        k += 1
+    # 2^(k+127) / d lies in [2^126, 2^128).
+    v = (1 << (k + 127)) // d
+    while v < (1 << 127):
+        k += 1
+        v = (1 << (k + 127)) // d
+    return v
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("output", help="output file")
+    args = parser.parse_args()
+
+    outfile = open(args.output, 'w')
+    outfile.write("// This file has been auto-generated by misc/gen-power10-table.py.  Do not hand-edit.\n\n")
+    outfile.write("const int power10_min_exp10 = %d;\n" % min_exp10)
+    outfile.write("const int power10_max_exp10 = %d;\n\n" % max_exp10)
+    outfile.write("const uint64_t power10_table[][2] = {\n")
+    for q in range(min_exp10, max_exp10 + 1):
+        v = truncated_mantissa(q)
+        hi = v >> 64
+        lo = v & ((1 << 64) - 1)
+        outfile.write("    { 0x%016XULL, 0x%016XULL }, // 1e%d\n" % (hi, lo, q))
+    outfile.write("};\n")
+    outfile.close()
+
+if __name__ == '__main__':
+    main()
@@ -95,4 +95,99 @@ def gen_token_names (filepath, tokens):
         token_id += 1
     outfile.write("};\n\n")
     outfile.write("size_t token_name_count = %d;\n\n"%token_id)
+    gen_token_hash(outfile, tokens)
     outfile.close()
+
+
+# Minimal perfect hash of the token names, using the hash-and-displace
+# method.  Every name is first hashed into a 32-bit value, which selects a
+# bucket.  Each bucket stores a displacement value that is mixed into the
+# hash of its names, chosen so that all names end up in distinct slots.
+# The functions below must be kept in sync with the lookup code in
+# src/liborcus/tokens.cpp.
+
+hash_mask = 0xFFFFFFFF
+
+def hash_mix (h):
+    h ^= h >> 16
+    h = (h * 0x7FEB352D) & hash_mask
+    h ^= h >> 15
+    h = (h * 0x846CA68B) & hash_mask
+    h ^= h >> 16
+    return h
+
+
+def hash_token_name (name):
+    data = bytearray(name.encode('utf-8'))
+    n = len(data)
+    h = (n * 0x9E3779B1) & hash_mask
+    i = 0
+    while i < n:
+        # Read up to 4 bytes at a time in little endian order.
+        w = 0
+        for j in range(0, min(4, n-i)):
+            w |= data[i+j] << (8*j)
+        h = ((h ^ w) * 0x85EBCA6B) & hash_mask
+        h ^= h >> 13
+        i += 4
+    return hash_mix(h)
+
+
+def hash_range (h, n):
+    # Map a 32-bit hash value onto [0, n) without a division.
+    return (h * n) >> 32
+
+
+def gen_token_hash (outfile, tokens):
+
+    token_size = len(tokens)
+    bucket_size = max(1, (token_size + 3) // 4)
+
+    buckets = []
+    for i in range(0, bucket_size):
+        buckets.append([])
+
+    hashes = {}
+    for i in range(0, token_size):
+        h = hash_token_name(tokens[i])
+        if h in hashes:
+            die("tokens '%s' and '%s' have the same hash value."%(hashes[h], tokens[i]))
+        hashes[h] = tokens[i]
+        buckets[hash_range(h, bucket_size)].append((h, i+1))
+
+    # Place the largest buckets first, while there are still many free slots.
+    order = list(range(0, bucket_size))
+    order.sort(key=lambda b: len(buckets[b]), reverse=True)
+
+    slots = [0] * token_size
+    displacements = [0] * bucket_size
+    for b in order:
+        if not buckets[b]:
+            break
+        d = 0
+        while True:
+            pos = [hash_range(hash_mix(h ^ d), token_size) for h, token_id in buckets[b]]
+            if len(set(pos)) == len(pos) and all(slots[p] == 0 for p in pos):
+                break
+            d += 1
+            if d > hash_mask:
+                die("failed to generate perfect hash for the tokens.")
+        displacements[b] = d
+        for p, item in zip(pos, buckets[b]):
+            slots[p] = item[1]
+
+    outfile.write("const unsigned int token_hash_displacements[] = {\n")
+    for i in range(0, bucket_size, 8):
+        row = displacements[i:i+8]
+        outfile.write("    " + ", ".join(["%d"%v for v in row]) + ",\n")
+    outfile.write("};\n\n")
+
+    outfile.write("const xml_token_t token_hash_slots[] = {\n")
+    for i in range(0, token_size, 8):
+        row = slots[i:i+8]
+        outfile.write("    " + ", ".join(["%d"%v for v in row]) + ",\n")
+    outfile.write("};\n\n")
+
+    outfile.write("const token_hash_table token_hash = {\n")
+    outfile.write("    token_hash_displacements, %d, token_hash_slots, %d\n"%(bucket_size, token_size))
+    outfile.write("};\n\n")
@@ -0,0 +1,421 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+#include "orcus/orcus_csv.hpp"
+#include "orcus/config.hpp"
+#include "orcus/import_trace.hpp"
+#include "orcus/measurement.hpp"
+#include "mock_spreadsheet.hpp"
+
+#include <cstdlib>
+#include <cstdio>
+#include <cassert>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace orcus;
+using namespace orcus::spreadsheet;
+using namespace orcus::spreadsheet::mock;
+
+namespace {
+
+const char* test_file_path = "liborcus-test-csv.csv";
+
+struct cell
+{
+    row_t row;
+    col_t col;
+    string value;
+
+    cell(row_t _row, col_t _col, const char* p, size_t n) :
+        row(_row), col(_col), value(p ? string(p, n) : string()) {}
+
+    bool operator== (const cell& r) const
+    {
+        return row == r.row && col == r.col && value == r.value;
+    }
+};
+
+class mock_sheet : public import_sheet
+{
+public:
+    virtual void set_auto(row_t row, col_t col, const char* p, size_t n)
+    {
+        m_cells.push_back(cell(row, col, p, n));
+    }
+
+    const vector<cell>& get_cells() const { return m_cells; }
+
+private:
+    vector<cell> m_cells;
+};
+
+class mock_factory : public import_factory
+{
+public:
+    mock_factory() : m_sheet_count(0) {}
+
+    virtual iface::import_sheet* append_sheet(const char*, size_t)
+    {
+        ++m_sheet_count;
+        return &m_mock_sheet;
+    }
+
+    virtual iface::import_shared_strings* get_shared_strings()
+    {
+        // Have all cells go through set_auto().
+        return NULL;
+    }
+
+    const mock_sheet& get_sheet() const { return m_mock_sheet; }
+    size_t get_sheet_count() const { return m_sheet_count; }
+
+private:
+    mock_sheet m_mock_sheet;
+    size_t m_sheet_count;
+};
+
+string to_number_string(double val)
+{
+    ostringstream os;
+    os << '#' << val;
+    return os.str();
+}
+
+class typed_shared_strings : public import_shared_strings
+{
+public:
+    virtual size_t add(const char* s, size_t n)
+    {
+        m_strings.push_back(string(s, n));
+        return m_strings.size() - 1;
+    }
+
+    const string& get(size_t sindex) const { return m_strings[sindex]; }
+
+private:
+    vector<string> m_strings;
+};
+
+/**
+ * Sheet that takes typed values only, and records numbers prefixed with a
+ * '#'.
+ */
+class typed_sheet : public import_sheet
+{
+public:
+    typed_sheet(const typed_shared_strings& strings) : m_strings(strings) {}
+
+    virtual void set_auto(row_t, col_t, const char*, size_t)
+    {
+        assert(!"set_auto should not be called.");
+    }
+
+    virtual void set_value(row_t row, col_t col, double value)
+    {
+        string s = to_number_string(value);
+        m_cells.push_back(cell(row, col, s.data(), s.size()));
+    }
+
+    virtual void set_string(row_t row, col_t col, size_t sindex)
+    {
+        const string& s = m_strings.get(sindex);
+        m_cells.push_back(cell(row, col, s.data(), s.size()));
+    }
+
+    const vector<cell>& get_cells() const { return m_cells; }
+
+private:
+    const typed_shared_strings& m_strings;
+    vector<cell> m_cells;
+};
+
+class typed_factory : public import_factory
+{
+public:
+    typed_factory() : m_sheet(m_strings) {}
+
+    virtual iface::import_sheet* append_sheet(const char*, size_t)
+    {
+        return &m_sheet;
+    }
+
+    virtual iface::import_shared_strings* get_shared_strings()
+    {
+        return &m_strings;
+    }
+
+    const typed_sheet& get_sheet() const { return m_sheet; }
+
+private:
+    typed_shared_strings m_strings;
+    typed_sheet m_sheet;
+};
+
+/**
+ * Generate content large enough to be split into several chunks, with
+ * quoted cells that contain delimiters, line feeds and escaped quotes.
+ */
+string generate_content()
+{
+    ostringstream os;
+    for (size_t i = 0; i < 50000; ++i)
+    {
+        os << i << ",text " << i << ',';
+        switch (i % 5)
+        {
+            case 0:
+                os << "\"quoted, with delimiter\"";
+                break;
+            case 1:
+                os << "\"multi\nline\n" << i << "\"";
+                break;
+            case 2:
+                os << "\"escaped \"\"quote\"\" " << i << "\"";
+                break;
+            case 3:
+                os << "\"\n\"";
+                break;
+            default:
+                ;
+        }
+        os << ",1.5\n";
+    }
+
+    // Last row without a trailing line feed.
+    os << "last,row";
+    return os.str();
+}
+
+void import(const string& content, size_t thread_count, iface::import_factory& factory, import_trace* trace = NULL)
+{
+    {
+        ofstream file(test_file_path, ios::out | ios::binary);
+        file << content;
+    }
+
+    config opt;
+    opt.thread_count = thread_count;
+    opt.trace = trace;
+    orcus_csv app(&factory);
+    app.set_config(opt);
+    app.read_file(test_file_path);
+    remove(test_file_path);
+}
+
+}
+
+void test_parallel_import()
+{
+    string content = generate_content();
+
+    mock_factory expected;
+    import(content, 1, expected);
+    const vector<cell>& expected_cells = expected.get_sheet().get_cells();
+    assert(expected.get_sheet_count() == 1);
+    assert(expected_cells.size() == 50000*4 + 2);
+    assert(expected_cells[2].value == "quoted, with delimiter");
+    assert(expected_cells[6].value == "multi\nline\n1");
+    assert(expected_cells[10].value == "escaped \"quote\" 2");
+    assert(expected_cells[14].value == "\n");
+    assert(expected_cells.back().row == 50000);
+
+    size_t thread_counts[] = { 2, 3, 4, 7, 16 };
+    for (size_t i = 0; i < sizeof(thread_counts)/sizeof(thread_counts[0]); ++i)
+    {
+        cout << "thread count: " << thread_counts[i] << endl;
+        mock_factory factory;
+        import(content, thread_counts[i], factory);
+        assert(factory.get_sheet_count() == 1);
+        assert(factory.get_sheet().get_cells() == expected_cells);
+    }
+}
+
+void test_block_setters()
+{
+    // With shared strings available, the cells of the chunks are passed as
+    // numbers and strings, classified the way set_auto() does, and empty
+    // cells are dropped.
+    string content = generate_content();
+    content += "\n 2.5,,\"3\",4x\n";
+
+    mock_factory untyped;
+    import(content, 1, untyped);
+    const vector<cell>& untyped_cells = untyped.get_sheet().get_cells();
+
+    vector<cell> expected_cells;
+    for (size_t i = 0; i < untyped_cells.size(); ++i)
+    {
+        const cell& c = untyped_cells[i];
+        if (c.value.empty())
+            continue;
+
+        const char* p = c.value.data();
+        const char* p_end = p + c.value.size();
+        while (p != p_end && *p == ' ')
+            ++p;
+
+        const char* endptr = NULL;
+        double val = to_double(p, p_end, &endptr);
+        if (endptr != p && endptr == p_end)
+        {
+            string s = to_number_string(val);
+            expected_cells.push_back(cell(c.row, c.col, s.data(), s.size()));
+        }
+        else
+            expected_cells.push_back(c);
+    }
+
+    assert(expected_cells.back() == cell(50001, 3, "4x", 2));
+    assert(expected_cells[expected_cells.size()-2] == cell(50001, 2, "#3", 2));
+    assert(expected_cells[expected_cells.size()-3] == cell(50001, 0, "#2.5", 4));
+
+    typed_factory factory;
+    import(content, 4, factory);
+    assert(factory.get_sheet().get_cells() == expected_cells);
+}
+
+void test_misplaced_quotes()
+{
+    // Quotes inside unquoted cells throw the quote count off, which must
+    // not change the result.
+    ostringstream os;
+    for (size_t i = 0; i < 50000; ++i)
+    {
+        os << i << ",5'10\",";
+        if (i % 3 == 0)
+            os << "\"multi\nline\"";
+        os << ",x\n";
+    }
+    string content = os.str();
+
+    mock_factory expected;
+    import(content, 1, expected);
+    const vector<cell>& expected_cells = expected.get_sheet().get_cells();
+    assert(expected_cells.size() == 50000*4);
+    assert(expected_cells[1].value == "5'10\"");
+
+    size_t thread_counts[] = { 2, 3, 4, 7 };
+    for (size_t i = 0; i < sizeof(thread_counts)/sizeof(thread_counts[0]); ++i)
+    {
+        mock_factory factory;
+        import(content, thread_counts[i], factory);
+        assert(factory.get_sheet().get_cells() == expected_cells);
+    }
+}
+
+void test_premature_end()
+{
+    // The last cell is missing its closing quote.  The cells before it
+    // should still be imported.
+    string content = generate_content();
+    content += "\nx,\"unterminated \"\"quoted cell";
+
+    mock_factory expected;
+    import(content, 1, expected);
+    const vector<cell>& expected_cells = expected.get_sheet().get_cells();
+    assert(expected_cells.back() == cell(50001, 0, "x", 1));
+
+    mock_factory factory;
+    import(content, 4, factory);
+    assert(factory.get_sheet().get_cells() == expected_cells);
+}
+
+void test_small_content()
+{
+    // Content too small to split gets parsed on the calling thread.
+    mock_factory factory;
+    import("1,2\n\"a\nb\",c\n", 4, factory);
+    const vector<cell>& cells = factory.get_sheet().get_cells();
+    assert(cells.size() == 4);
+    assert(cells[2] == cell(1, 0, "a\nb", 3));
+    assert(cells[3] == cell(1, 1, "c", 1));
+}
+
+void test_trace()
+{
+    string content = generate_content();
+    size_t cell_count = 50000*4 + 2;
+
+    import_trace trace;
+    mock_factory factory;
+    import(content, 1, factory, &trace);
+    assert(factory.get_sheet().get_cells().size() == cell_count);
+    assert(trace.get_cell_count() == cell_count);
+
+    trace_phase_stats stats = trace.get_phase_stats(trace_phase_parse);
+    assert(stats.event_count == 1);
+    assert(stats.bytes == content.size());
+    assert(stats.cells == cell_count);
+    assert(trace.get_phase_stats(trace_phase_finalize).event_count == 1);
+    assert(trace.get_phase_stats(trace_phase_insert).event_count == 0);
+
+    // With worker threads, the chunks get parsed off the calling thread,
+    // and their cells are counted when they are inserted.
+    trace.clear();
+    assert(trace.get_events().empty());
+    import(content, 4, factory, &trace);
+    stats = trace.get_phase_stats(trace_phase_parse);
+    assert(stats.event_count == 4);
+    assert(stats.bytes == content.size());
+    assert(stats.cells == 0);
+    stats = trace.get_phase_stats(trace_phase_insert);
+    assert(stats.event_count == 4);
+    assert(stats.cells == cell_count);
+
+    vector<trace_event> events = trace.get_events();
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        if (events[i].phase == trace_phase_parse)
+            assert(events[i].thread > 0);
+        else
+            assert(events[i].thread == 0);
+    }
+
+    ostringstream os;
+    trace.write_chrome_trace(os);
+    string json = os.str();
+    assert(json.find("{\"traceEvents\":[") == 0);
+    assert(json.find("\"cat\":\"insert\"") != string::npos);
+    assert(json.find("\"ph\":\"X\"") != string::npos);
+}
+
+int main()
+{
+    test_parallel_import();
+    test_block_setters();
+    test_misplaced_quotes();
+    test_premature_end();
+    test_small_content();
+    test_trace();
+
+    return EXIT_SUCCESS;
+}
@@ -26,6 +26,7 @@
  ************************************************************************/
 
 #include "orcus/global.hpp"
+#include "orcus/measurement.hpp"
 #include "orcus/tokens.hpp"
 #include "orcus/exception.hpp"
 
@@ -87,7 +88,7 @@ void process_char(const char* p, const char*& digit, size_t& digit_len)
 
 void flush_int(int& store, const char*& digit, size_t& digit_len)
 {
-    store = strtol(digit, NULL, 10);
+    store = to_long(digit, digit + digit_len);
     digit = NULL;
     digit_len = 0;
 }
@@ -145,7 +146,7 @@ date_time_t to_date_time(const pstring& str)
                 }
 
                 // Flush day.
-                ret.day = strtol(digit, NULL, 10);
+                ret.day = to_long(digit, digit + digit_len);
                 digit = NULL;
                 digit_len = 0;
 
@@ -233,15 +234,28 @@ date_time_t to_date_time(const pstring& str)
     if (t_count)
     {
         // Flush second.
-        ret.second = strtod(digit, NULL);
+        ret.second = to_double(digit, digit + digit_len);
     }
     else
     {
         // Flush day.
-        ret.day = strtol(digit, NULL, 10);
+        ret.day = to_long(digit, digit + digit_len);
     }
 
     return ret;
 }
 
+long to_day_number(int year, int month, int day)
+{
+    // Count years from March so that the leap day falls at the end.
+    if (month <= 2)
+        --year;
+
+    long era = (year >= 0 ? year : year - 399) / 400;
+    long year_of_era = year - era * 400;
+    long day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    long day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + day_of_era - 719468;
+}
+
 }
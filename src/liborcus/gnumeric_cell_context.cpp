@@ -30,6 +30,7 @@
 #include "gnumeric_namespace_types.hpp"
 #include "gnumeric_cell_context.hpp"
 #include "orcus/global.hpp"
+#include "orcus/measurement.hpp"
 #include "orcus/spreadsheet/import_interface.hpp"
 
 #include <iostream>
@@ -84,14 +85,14 @@ public:
         switch (attr.name)
         {
             case XML_Row:
-                cell_data.row = atoi(attr.value.get());
+                cell_data.row = to_long(attr.value);
                 break;
             case XML_Col:
-                cell_data.col = atoi(attr.value.get());
+                cell_data.col = to_long(attr.value);
                 break;
             case XML_ValueType:
             {
-                int value_type = atoi(attr.value.get());
+                int value_type = to_long(attr.value);
                 switch (value_type)
                 {
                     case 20:
@@ -107,15 +108,15 @@ public:
             }
             break;
             case XML_ExprID:
-                cell_data.shared_formula_id = atoi(attr.value.get());
+                cell_data.shared_formula_id = to_long(attr.value);
                 cell_data.cell_type = cell_type_shared_formula;
                 break;
             case XML_Rows:
-                cell_data.array_rows = atoi(attr.value.get());
+                cell_data.array_rows = to_long(attr.value);
                 cell_data.cell_type = cell_type_array;
                 break;
             case XML_Cols:
-                cell_data.array_cols = atoi(attr.value.get());
+                cell_data.array_cols = to_long(attr.value);
                 cell_data.cell_type = cell_type_array;
                 break;
         }
@@ -137,7 +138,8 @@ private:
 gnumeric_cell_context::gnumeric_cell_context(session_context& session_cxt, const tokens& tokens, spreadsheet::iface::import_factory* factory, spreadsheet::iface::import_sheet* sheet) :
     xml_context_base(session_cxt, tokens),
     mp_factory(factory),
-    mp_sheet(sheet)
+    mp_sheet(sheet),
+    m_row_buffer(sheet)
 {
 }
 
@@ -187,6 +189,9 @@ bool gnumeric_cell_context::end_element(xmlns_id_t ns, xml_token_t name)
             case XML_Cell:
                 end_cell();
                 break;
+            case XML_Cells:
+                m_row_buffer.flush();
+                break;
             default:
                 ;
         }
@@ -218,15 +223,15 @@ void gnumeric_cell_context::end_cell()
     {
         case cell_type_value:
         {
-            double val = atof(chars.get());
-            mp_sheet->set_value(row, col, val);
+            double val = to_double(chars);
+            m_row_buffer.set_value(row, col, val);
         }
         break;
         case cell_type_string:
         {
             spreadsheet::iface::import_shared_strings* shared_strings = mp_factory->get_shared_strings();
             size_t id = shared_strings->add(chars.get(), chars.size());
-            mp_sheet->set_string(row, col, id);
+            m_row_buffer.set_string(row, col, id);
         }
         break;
         case cell_type_formula:
@@ -249,7 +254,7 @@ void gnumeric_cell_context::end_cell()
         case cell_type_bool:
         {
             bool val = chars == "TRUE";
-            mp_sheet->set_bool(row, col, val);
+            m_row_buffer.set_bool(row, col, val);
         }
         break;
         default:
@@ -29,6 +29,7 @@
 #define __ORCUS_GNUMERIC_CELL_CONTEXT_HPP__
 
 #include "xml_context_base.hpp"
+#include "sheet_row_buffer.hpp"
 #include <boost/scoped_ptr.hpp>
 
 namespace orcus {
@@ -70,6 +71,8 @@ private:
     pstring chars;
 
     spreadsheet::iface::import_sheet* mp_sheet;
+
+    sheet_row_buffer m_row_buffer; /// collects adjacent value cells.
 };
 
 } // namespace orcus
@@ -86,12 +86,20 @@ void gnumeric_content_xml_context::start_element(xmlns_id_t ns, xml_token_t name
     {
         switch (name)
         {
+            case XML_Workbook:
+            case XML_Sheets:
+            break;
             default:
+                // Workbook-level metadata.  Not imported.
                 warn_unhandled();
+                skip_subtree();
         }
     }
     else
+    {
         warn_unhandled();
+        skip_subtree();
+    }
 }
 
 bool gnumeric_content_xml_context::end_element(xmlns_id_t ns, xml_token_t name)
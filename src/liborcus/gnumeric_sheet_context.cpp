@@ -31,6 +31,7 @@
 #include "gnumeric_namespace_types.hpp"
 #include "gnumeric_helper.hpp"
 #include "orcus/global.hpp"
+#include "orcus/measurement.hpp"
 #include "orcus/spreadsheet/import_interface.hpp"
 #include "gnumeric_helper.hpp"
 
@@ -50,25 +51,25 @@ public:
         {
             case XML_startCol:
             {
-                size_t n = atoi(attr.value.get());
+                size_t n = to_long(attr.value);
                 m_style_region_data.start_col = n;
             }
             break;
             case XML_startRow:
             {
-                size_t n = atoi(attr.value.get());
+                size_t n = to_long(attr.value);
                 m_style_region_data.start_row = n;
             }
             break;
             case XML_endCol:
             {
-                size_t n = atoi(attr.value.get());
+                size_t n = to_long(attr.value);
                 m_style_region_data.end_col = n;
             }
             break;
             case XML_endRow:
             {
-                size_t n = atoi(attr.value.get());
+                size_t n = to_long(attr.value);
                 m_style_region_data.end_row = n;
             }
             break;
@@ -93,25 +94,25 @@ public:
         {
             case XML_Unit:
             {
-                double n = atoi(attr.value.get());
+                double n = to_long(attr.value);
                 m_styles.set_font_size(n);
             }
             break;
             case XML_Bold:
             {
-                bool b = atoi(attr.value.get()) != 0;
+                bool b = to_long(attr.value) != 0;
                 m_styles.set_font_bold(b);
             }
             break;
             case XML_Italic:
             {
-                bool b = atoi(attr.value.get()) != 0;
+                bool b = to_long(attr.value) != 0;
                 m_styles.set_font_italic(b);
             }
             break;
             case XML_Underline:
             {
-                int n = atoi(attr.value.get());
+                int n = to_long(attr.value);
                 switch (n)
                 {
                     case 0:
@@ -167,7 +168,7 @@ public:
             break;
             case XML_Hidden:
             {
-                bool b = atoi(attr.value.get());
+                bool b = to_long(attr.value);
                 m_styles.set_cell_hidden(b);
 
                 m_protection = true;
@@ -175,7 +176,7 @@ public:
             break;
             case XML_Locked:
             {
-                bool b = atoi(attr.value.get());
+                bool b = to_long(attr.value);
                 m_styles.set_cell_locked(b);
 
                 m_protection = true;
@@ -225,25 +226,25 @@ public:
         {
             case XML_No:
             {
-                size_t i = atoi(attr.value.get());
+                size_t i = to_long(attr.value);
                 m_position = i;
             }
             break;
             case XML_Unit:
             {
-                double n = atof(attr.value.get());
+                double n = to_double(attr.value);
                 m_size = n;
             }
             break;
             case XML_Count:
             {
-                size_t i = atoi(attr.value.get());
+                size_t i = to_long(attr.value);
                 m_num_repeated = i;
             }
             break;
             case XML_Hidden:
             {
-                bool b = atoi(attr.value.get()) != 0;
+                bool b = to_long(attr.value) != 0;
                 m_hidden = b;
             }
         }
@@ -337,6 +338,18 @@ void gnumeric_sheet_context::start_element(xmlns_id_t ns, xml_token_t name, cons
             case XML_RowInfo:
                 start_row(attrs);
             break;
+            case XML_Names:
+            case XML_PrintInformation:
+            case XML_Selections:
+            case XML_SheetLayout:
+            case XML_Objects:
+            case XML_Solver:
+            case XML_Scenarios:
+            case XML_Filters:
+            case XML_MergedRegions:
+                // Not imported.
+                skip_subtree();
+            break;
             default:
                 ;
         }
@@ -456,15 +469,9 @@ void gnumeric_sheet_context::end_style()
 
 void gnumeric_sheet_context::end_style_region()
 {
-    for (spreadsheet::col_t col = mp_region_data->start_col;
-            col <= mp_region_data->end_col; ++col)
-    {
-        for (spreadsheet::row_t row = mp_region_data->start_row;
-                row <= mp_region_data->end_row; ++row)
-        {
-            mp_sheet->set_format(row, col, mp_region_data->xf_id);
-        }
-    }
+    mp_sheet->set_format_range(
+        mp_region_data->start_row, mp_region_data->start_col,
+        mp_region_data->end_row, mp_region_data->end_col, mp_region_data->xf_id);
     mp_region_data.reset();
 }
 
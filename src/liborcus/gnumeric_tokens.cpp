@@ -35,6 +35,6 @@ namespace {
 
 }
 
-tokens gnumeric_tokens = tokens(token_names, token_name_count);
+tokens gnumeric_tokens = tokens(token_names, token_name_count, token_hash);
 
 }
\ No newline at end of file
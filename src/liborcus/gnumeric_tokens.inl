@@ -261,3 +261,53 @@ const char* token_names[] = {
 
 size_t token_name_count = 256;
 
+const unsigned int token_hash_displacements[] = {
+    29, 4, 27, 184, 21, 24, 33, 137,
+    104, 39, 1, 30, 12, 77, 0, 480,
+    2, 124, 102, 33, 144, 7, 94, 0,
+    28, 95, 7, 15, 0, 18, 32, 2,
+    41, 23, 105, 45, 80, 297, 0, 194,
+    34, 13, 238, 69, 0, 1, 601, 174,
+    16, 0, 4, 191, 266, 323, 47, 0,
+    2, 37, 647, 198, 13, 174, 24, 1220,
+};
+
+const xml_token_t token_hash_slots[] = {
+    50, 222, 72, 199, 144, 201, 96, 120,
+    35, 88, 66, 176, 241, 8, 255, 237,
+    203, 95, 182, 154, 155, 129, 84, 136,
+    106, 186, 114, 134, 168, 20, 39, 91,
+    78, 214, 126, 16, 160, 45, 224, 142,
+    228, 221, 175, 164, 252, 27, 229, 18,
+    68, 147, 151, 34, 53, 162, 157, 137,
+    218, 86, 47, 187, 217, 52, 98, 85,
+    156, 207, 37, 226, 146, 105, 174, 220,
+    15, 62, 177, 116, 170, 240, 112, 200,
+    103, 208, 231, 238, 239, 163, 140, 97,
+    180, 49, 230, 183, 152, 172, 33, 100,
+    198, 79, 161, 184, 82, 202, 247, 223,
+    22, 48, 206, 233, 248, 93, 141, 188,
+    70, 227, 173, 57, 193, 213, 74, 56,
+    253, 205, 251, 212, 2, 29, 36, 60,
+    24, 135, 59, 54, 178, 3, 19, 63,
+    17, 165, 69, 4, 43, 194, 25, 40,
+    64, 94, 10, 55, 12, 243, 215, 128,
+    235, 111, 211, 219, 5, 83, 132, 181,
+    169, 77, 14, 138, 210, 46, 87, 109,
+    244, 89, 11, 31, 196, 44, 115, 133,
+    124, 58, 232, 195, 143, 131, 23, 123,
+    191, 130, 245, 41, 167, 158, 119, 26,
+    145, 225, 149, 166, 6, 121, 110, 13,
+    30, 21, 42, 216, 148, 108, 107, 122,
+    28, 7, 101, 204, 254, 99, 127, 118,
+    90, 113, 192, 153, 179, 209, 71, 125,
+    92, 1, 38, 73, 185, 81, 67, 190,
+    246, 197, 171, 61, 76, 104, 32, 102,
+    249, 159, 117, 75, 236, 51, 65, 234,
+    139, 80, 242, 150, 250, 9, 189,
+};
+
+const token_hash_table token_hash = {
+    token_hash_displacements, 64, token_hash_slots, 255
+};
+
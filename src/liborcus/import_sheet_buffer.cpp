@@ -0,0 +1,384 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+
+#include "import_sheet_buffer.hpp"
+
+#include <algorithm>
+
+#include <boost/scoped_array.hpp>
+
+using namespace std;
+
+namespace orcus {
+
+using namespace spreadsheet;
+
+import_sheet_buffer::import_sheet_buffer() {}
+
+import_sheet_buffer::~import_sheet_buffer() {}
+
+void import_sheet_buffer::replay(iface::import_sheet& sheet) const
+{
+    iface::import_sheet_properties* props = sheet.get_sheet_properties();
+
+    commands_type::const_iterator it = m_commands.begin(), it_end = m_commands.end();
+    for (; it != it_end; ++it)
+    {
+        const command& cmd = *it;
+        switch (cmd.type)
+        {
+            case cmd_auto:
+                sheet.set_auto(cmd.row, cmd.col, get_str(cmd.str), cmd.str.size);
+            break;
+            case cmd_string:
+                sheet.set_string(cmd.row, cmd.col, cmd.index);
+            break;
+            case cmd_value:
+                sheet.set_value(cmd.row, cmd.col, cmd.value);
+            break;
+            case cmd_bool:
+                sheet.set_bool(cmd.row, cmd.col, cmd.flag);
+            break;
+            case cmd_values:
+                sheet.set_values(cmd.row, cmd.col, &m_values[cmd.block.pos], cmd.block.size);
+            break;
+            case cmd_strings:
+                sheet.set_strings(cmd.row, cmd.col, &m_sindices[cmd.block.pos], cmd.block.size);
+            break;
+            case cmd_bools:
+            {
+                // std::vector<bool> doesn't store its elements as an array.
+                boost::scoped_array<bool> values(new bool[cmd.block.size]);
+                std::copy(m_bools.begin() + cmd.block.pos, m_bools.begin() + cmd.block.pos + cmd.block.size, values.get());
+                sheet.set_bools(cmd.row, cmd.col, values.get(), cmd.block.size);
+            }
+            break;
+            case cmd_date_time:
+            {
+                const date_time_args& dt = cmd.date_time;
+                sheet.set_date_time(cmd.row, cmd.col, dt.year, dt.month, dt.day, dt.hour, dt.minute, dt.second);
+            }
+            break;
+            case cmd_format:
+                sheet.set_format(cmd.row, cmd.col, cmd.index);
+            break;
+            case cmd_format_range:
+                sheet.set_format_range(cmd.row, cmd.col, cmd.range.row_last, cmd.range.col_last, cmd.range.index);
+            break;
+            case cmd_formula:
+            {
+                const formula_args& f = cmd.formula;
+                sheet.set_formula(
+                    cmd.row, cmd.col, static_cast<formula_grammar_t>(f.grammar),
+                    get_str(f.formula), f.formula.size);
+            }
+            break;
+            case cmd_shared_formula:
+            {
+                const formula_args& f = cmd.formula;
+                sheet.set_shared_formula(
+                    cmd.row, cmd.col, static_cast<formula_grammar_t>(f.grammar), f.index,
+                    get_str(f.formula), f.formula.size, get_str(f.range), f.range.size);
+            }
+            break;
+            case cmd_shared_formula_no_range:
+            {
+                const formula_args& f = cmd.formula;
+                sheet.set_shared_formula(
+                    cmd.row, cmd.col, static_cast<formula_grammar_t>(f.grammar), f.index,
+                    get_str(f.formula), f.formula.size);
+            }
+            break;
+            case cmd_shared_formula_index:
+                sheet.set_shared_formula(cmd.row, cmd.col, cmd.index);
+            break;
+            case cmd_formula_result:
+                sheet.set_formula_result(cmd.row, cmd.col, get_str(cmd.str), cmd.str.size);
+            break;
+            case cmd_array_formula:
+            {
+                const array_formula_args& f = cmd.array_formula;
+                sheet.set_array_formula(
+                    cmd.row, cmd.col, static_cast<formula_grammar_t>(f.grammar),
+                    get_str(f.formula), f.formula.size, f.rows, f.cols);
+            }
+            break;
+            case cmd_array_formula_range:
+            {
+                const formula_args& f = cmd.formula;
+                sheet.set_array_formula(
+                    cmd.row, cmd.col, static_cast<formula_grammar_t>(f.grammar),
+                    get_str(f.formula), f.formula.size, get_str(f.range), f.range.size);
+            }
+            break;
+            case cmd_column_width:
+                if (props)
+                    props->set_column_width(
+                        cmd.col, cmd.length.value, static_cast<length_unit_t>(cmd.length.unit));
+            break;
+            case cmd_column_hidden:
+                if (props)
+                    props->set_column_hidden(cmd.col, cmd.flag);
+            break;
+            case cmd_row_height:
+                if (props)
+                    props->set_row_height(
+                        cmd.row, cmd.length.value, static_cast<length_unit_t>(cmd.length.unit));
+            break;
+            case cmd_row_hidden:
+                if (props)
+                    props->set_row_hidden(cmd.row, cmd.flag);
+            break;
+        }
+    }
+}
+
+void import_sheet_buffer::clear()
+{
+    commands_type().swap(m_commands);
+    string().swap(m_strings);
+    vector<double>().swap(m_values);
+    vector<size_t>().swap(m_sindices);
+    vector<bool>().swap(m_bools);
+}
+
+iface::import_sheet_properties* import_sheet_buffer::get_sheet_properties()
+{
+    return this;
+}
+
+void import_sheet_buffer::set_auto(row_t row, col_t col, const char* p, size_t n)
+{
+    command cmd(cmd_auto, row, col);
+    cmd.str = store(p, n);
+    m_commands.push_back(cmd);
+}
+
+void import_sheet_buffer::set_string(row_t row, col_t col, size_t sindex)
+{
+    command cmd(cmd_string, row, col);
+    cmd.index = sindex;
+    m_commands.push_back(cmd);
+}
+
+void import_sheet_buffer::set_value(row_t row, col_t col, double value)
+{
+    command cmd(cmd_value, row, col);
+    cmd.value = value;
+    m_commands.push_back(cmd);
+}
+
+void import_sheet_buffer::set_bool(row_t row, col_t col, bool value)
+{
+    command cmd(cmd_bool, row, col);
+    cmd.flag = value;
+    m_commands.push_back(cmd);
+}
+
+void import_sheet_buffer::set_values(row_t row, col_t col, const double* values, size_t n)
+{
+    command cmd(cmd_values, row, col);
+    cmd.block.pos = m_values.size();
+    cmd.block.size = n;
+    m_values.insert(m_values.end(), values, values + n);
+    m_commands.push_back(cmd);
+}
+
+void import_sheet_buffer::set_strings(row_t row, col_t col, const size_t* sindices, size_t n)
+{
+    command cmd(cmd_strings, row, col);
+    cmd.block.pos = m_sindices.size();
+    cmd.block.size = n;
+    m_sindices.insert(m_sindices.end(), sindices, sindices + n);
+    m_commands.push_back(cmd);
+}
+
+void import_sheet_buffer::set_bools(row_t row, col_t col, const bool* values, size_t n)
+{
+    command cmd(cmd_bools, row, col);
+    cmd.block.pos = m_bools.size();
+    cmd.block.size = n;
+    m_bools.insert(m_bools.end(), values, values + n);
+    m_commands.push_back(cmd);
+}
+
+void import_sheet_buffer::set_date_time(
+    row_t row, col_t col, int year, int month, int day, int hour, int minute, double second)
+{
+    command cmd(cmd_date_time, row, col);
+    date_time_args& dt = cmd.date_time;
+    dt.year = year;
+    dt.month = month;
+    dt.day = day;
+    dt.hour = hour;
+    dt.minute = minute;
+    dt.second = second;
+    m_commands.push_back(cmd);
+}
+
+void import_sheet_buffer::set_format(row_t row, col_t col, size_t xf_index)
+{
+    command cmd(cmd_format, row, col);
+    cmd.index = xf_index;
+    m_commands.push_back(cmd);
+}
+
+void import_sheet_buffer::set_format_range(row_t row1, col_t col1, row_t row2, col_t col2, size_t xf_index)
+{
+    command cmd(cmd_format_range, row1, col1);
+    range_args& r = cmd.range;
+    r.row_last = row2;
+    r.col_last = col2;
+    r.index = xf_index;
+    m_commands.push_back(cmd);
+}
+
+void import_sheet_buffer::set_formula(
+    row_t row, col_t col, formula_grammar_t grammar, const char* p, size_t n)
+{
+    command cmd(cmd_formula, row, col);
+    formula_args& f = cmd.formula;
+    f.grammar = grammar;
+    f.index = 0;
+    f.formula = store(p, n);
+    f.range = store(NULL, 0);
+    m_commands.push_back(cmd);
+}
+
+void import_sheet_buffer::set_shared_formula(
+    row_t row, col_t col, formula_grammar_t grammar,
+    size_t sindex, const char* p_formula, size_t n_formula, const char* p_range, size_t n_range)
+{
+    command cmd(cmd_shared_formula, row, col);
+    formula_args& f = cmd.formula;
+    f.grammar = grammar;
+    f.index = sindex;
+    f.formula = store(p_formula, n_formula);
+    f.range = store(p_range, n_range);
+    m_commands.push_back(cmd);
+}
+
+void import_sheet_buffer::set_shared_formula(
+    row_t row, col_t col, formula_grammar_t grammar,
+    size_t sindex, const char* p_formula, size_t n_formula)
+{
+    command cmd(cmd_shared_formula_no_range, row, col);
+    formula_args& f = cmd.formula;
+    f.grammar = grammar;
+    f.index = sindex;
+    f.formula = store(p_formula, n_formula);
+    f.range = store(NULL, 0);
+    m_commands.push_back(cmd);
+}
+
+void import_sheet_buffer::set_shared_formula(row_t row, col_t col, size_t sindex)
+{
+    command cmd(cmd_shared_formula_index, row, col);
+    cmd.index = sindex;
+    m_commands.push_back(cmd);
+}
+
+void import_sheet_buffer::set_formula_result(row_t row, col_t col, const char* p, size_t n)
+{
+    command cmd(cmd_formula_result, row, col);
+    cmd.str = store(p, n);
+    m_commands.push_back(cmd);
+}
+
+void import_sheet_buffer::set_array_formula(
+    row_t row, col_t col, formula_grammar_t grammar,
+    const char* p, size_t n, row_t array_rows, col_t array_cols)
+{
+    command cmd(cmd_array_formula, row, col);
+    array_formula_args& f = cmd.array_formula;
+    f.grammar = grammar;
+    f.rows = array_rows;
+    f.cols = array_cols;
+    f.formula = store(p, n);
+    m_commands.push_back(cmd);
+}
+
+void import_sheet_buffer::set_array_formula(
+    row_t row, col_t col, formula_grammar_t grammar,
+    const char* p, size_t n, const char* p_range, size_t n_range)
+{
+    command cmd(cmd_array_formula_range, row, col);
+    formula_args& f = cmd.formula;
+    f.grammar = grammar;
+    f.index = 0;
+    f.formula = store(p, n);
+    f.range = store(p_range, n_range);
+    m_commands.push_back(cmd);
+}
+
+void import_sheet_buffer::set_column_width(col_t col, double width, length_unit_t unit)
+{
+    command cmd(cmd_column_width, 0, col);
+    cmd.length.value = width;
+    cmd.length.unit = unit;
+    m_commands.push_back(cmd);
+}
+
+void import_sheet_buffer::set_column_hidden(col_t col, bool hidden)
+{
+    command cmd(cmd_column_hidden, 0, col);
+    cmd.flag = hidden;
+    m_commands.push_back(cmd);
+}
+
+void import_sheet_buffer::set_row_height(row_t row, double height, length_unit_t unit)
+{
+    command cmd(cmd_row_height, row, 0);
+    cmd.length.value = height;
+    cmd.length.unit = unit;
+    m_commands.push_back(cmd);
+}
+
+void import_sheet_buffer::set_row_hidden(row_t row, bool hidden)
+{
+    command cmd(cmd_row_hidden, row, 0);
+    cmd.flag = hidden;
+    m_commands.push_back(cmd);
+}
+
+import_sheet_buffer::str_ref import_sheet_buffer::store(const char* p, size_t n)
+{
+    str_ref ref;
+    ref.pos = m_strings.size();
+    ref.size = n;
+    if (n)
+        m_strings.append(p, n);
+    return ref;
+}
+
+const char* import_sheet_buffer::get_str(const str_ref& ref) const
+{
+    return m_strings.data() + ref.pos;
+}
+
+}
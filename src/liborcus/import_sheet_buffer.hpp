@@ -0,0 +1,239 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+
+#ifndef ORCUS_IMPORT_SHEET_BUFFER_HPP
+#define ORCUS_IMPORT_SHEET_BUFFER_HPP
+
+#include "orcus/spreadsheet/import_interface.hpp"
+
+#include <vector>
+#include <string>
+
+namespace orcus {
+
+/**
+ * Sheet import interface implementation that records all calls it receives
+ * without passing them anywhere, so that they can be replayed later onto a
+ * real sheet instance in the same order.  This allows sheet streams to be
+ * parsed on worker threads while keeping all calls into the client's
+ * import interfaces on one thread.
+ *
+ * All string values passed to this buffer are copied, so the caller doesn't
+ * need to keep them alive.
+ */
+class import_sheet_buffer :
+    public spreadsheet::iface::import_sheet,
+    public spreadsheet::iface::import_sheet_properties
+{
+    enum command_type
+    {
+        cmd_auto,
+        cmd_string,
+        cmd_value,
+        cmd_bool,
+        cmd_values,
+        cmd_strings,
+        cmd_bools,
+        cmd_date_time,
+        cmd_format,
+        cmd_format_range,
+        cmd_formula,
+        cmd_shared_formula,
+        cmd_shared_formula_no_range,
+        cmd_shared_formula_index,
+        cmd_formula_result,
+        cmd_array_formula,
+        cmd_array_formula_range,
+        cmd_column_width,
+        cmd_column_hidden,
+        cmd_row_height,
+        cmd_row_hidden
+    };
+
+    /**
+     * Position and length of a string stored in the string buffer.
+     */
+    struct str_ref
+    {
+        size_t pos;
+        size_t size;
+    };
+
+    /**
+     * Position and length of a block of cell values stored in one of the
+     * value buffers.
+     */
+    struct block_ref
+    {
+        size_t pos;
+        size_t size;
+    };
+
+    struct date_time_args
+    {
+        int year;
+        int month;
+        int day;
+        int hour;
+        int minute;
+        double second;
+    };
+
+    struct formula_args
+    {
+        int grammar;
+        size_t index;
+        str_ref formula;
+        str_ref range;
+    };
+
+    struct array_formula_args
+    {
+        int grammar;
+        spreadsheet::row_t rows;
+        spreadsheet::col_t cols;
+        str_ref formula;
+    };
+
+    struct range_args
+    {
+        spreadsheet::row_t row_last;
+        spreadsheet::col_t col_last;
+        size_t index;
+    };
+
+    struct length_args
+    {
+        double value;
+        int unit;
+    };
+
+    struct command
+    {
+        command_type type;
+        spreadsheet::row_t row;
+        spreadsheet::col_t col;
+
+        union
+        {
+            double value;
+            size_t index;
+            bool flag;
+            str_ref str;
+            block_ref block;
+            date_time_args date_time;
+            formula_args formula;
+            array_formula_args array_formula;
+            range_args range;
+            length_args length;
+        };
+
+        command(command_type _type, spreadsheet::row_t _row, spreadsheet::col_t _col) :
+            type(_type), row(_row), col(_col) {}
+    };
+
+    typedef std::vector<command> commands_type;
+
+public:
+    import_sheet_buffer();
+    virtual ~import_sheet_buffer();
+
+    /**
+     * Replay all recorded calls onto the specified sheet, in the order they
+     * were received.  Calls for sheet properties are skipped if the sheet
+     * doesn't provide a sheet properties interface.
+     *
+     * @param sheet sheet instance to receive the recorded calls.
+     */
+    void replay(spreadsheet::iface::import_sheet& sheet) const;
+
+    /**
+     * Discard all recorded calls and release their storage.
+     */
+    void clear();
+
+    // import_sheet
+
+    virtual spreadsheet::iface::import_sheet_properties* get_sheet_properties();
+
+    virtual void set_auto(spreadsheet::row_t row, spreadsheet::col_t col, const char* p, size_t n);
+    virtual void set_string(spreadsheet::row_t row, spreadsheet::col_t col, size_t sindex);
+    virtual void set_value(spreadsheet::row_t row, spreadsheet::col_t col, double value);
+    virtual void set_bool(spreadsheet::row_t row, spreadsheet::col_t col, bool value);
+    virtual void set_values(spreadsheet::row_t row, spreadsheet::col_t col, const double* values, size_t n);
+    virtual void set_strings(spreadsheet::row_t row, spreadsheet::col_t col, const size_t* sindices, size_t n);
+    virtual void set_bools(spreadsheet::row_t row, spreadsheet::col_t col, const bool* values, size_t n);
+    virtual void set_date_time(
+        spreadsheet::row_t row, spreadsheet::col_t col,
+        int year, int month, int day, int hour, int minute, double second);
+    virtual void set_format(spreadsheet::row_t row, spreadsheet::col_t col, size_t xf_index);
+    virtual void set_format_range(
+        spreadsheet::row_t row1, spreadsheet::col_t col1,
+        spreadsheet::row_t row2, spreadsheet::col_t col2, size_t xf_index);
+    virtual void set_formula(
+        spreadsheet::row_t row, spreadsheet::col_t col, spreadsheet::formula_grammar_t grammar,
+        const char* p, size_t n);
+    virtual void set_shared_formula(
+        spreadsheet::row_t row, spreadsheet::col_t col, spreadsheet::formula_grammar_t grammar,
+        size_t sindex, const char* p_formula, size_t n_formula, const char* p_range, size_t n_range);
+    virtual void set_shared_formula(
+        spreadsheet::row_t row, spreadsheet::col_t col, spreadsheet::formula_grammar_t grammar,
+        size_t sindex, const char* p_formula, size_t n_formula);
+    virtual void set_shared_formula(
+        spreadsheet::row_t row, spreadsheet::col_t col, size_t sindex);
+    virtual void set_formula_result(
+        spreadsheet::row_t row, spreadsheet::col_t col, const char* p, size_t n);
+    virtual void set_array_formula(
+        spreadsheet::row_t row, spreadsheet::col_t col, spreadsheet::formula_grammar_t grammar,
+        const char* p, size_t n, spreadsheet::row_t array_rows, spreadsheet::col_t array_cols);
+    virtual void set_array_formula(
+        spreadsheet::row_t row, spreadsheet::col_t col, spreadsheet::formula_grammar_t grammar,
+        const char* p, size_t n, const char* p_range, size_t n_range);
+
+    // import_sheet_properties
+
+    virtual void set_column_width(spreadsheet::col_t col, double width, orcus::length_unit_t unit);
+    virtual void set_column_hidden(spreadsheet::col_t col, bool hidden);
+    virtual void set_row_height(spreadsheet::row_t row, double height, orcus::length_unit_t unit);
+    virtual void set_row_hidden(spreadsheet::row_t row, bool hidden);
+
+private:
+    str_ref store(const char* p, size_t n);
+    const char* get_str(const str_ref& ref) const;
+
+private:
+    commands_type m_commands;
+    std::string m_strings;
+    std::vector<double> m_values;
+    std::vector<size_t> m_sindices;
+    std::vector<bool> m_bools;
+};
+
+}
+
+#endif
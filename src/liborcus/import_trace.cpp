@@ -0,0 +1,261 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+
+#include "orcus/import_trace.hpp"
+#include "orcus/parser_global.hpp"
+
+#include <cstdio>
+#include <map>
+
+#include <boost/thread.hpp>
+
+using namespace std;
+
+namespace orcus {
+
+namespace {
+
+const char* trace_phase_names[] = {
+    "zip_read",
+    "inflate",
+    "parse",
+    "insert",
+    "finalize",
+    "calc",
+    "finalize_sheet",
+    "tokenize"
+};
+
+void write_json_string(ostream& os, const string& s)
+{
+    os << '"';
+    for (string::const_iterator it = s.begin(), it_end = s.end(); it != it_end; ++it)
+    {
+        unsigned char c = *it;
+        if (c == '"' || c == '\\')
+            os << '\\' << c;
+        else if (c < 0x20)
+        {
+            char buf[8];
+            snprintf(buf, sizeof(buf), "\\u%04x", c);
+            os << buf;
+        }
+        else
+            os << c;
+    }
+    os << '"';
+}
+
+}
+
+const char* get_trace_phase_name(trace_phase_t phase)
+{
+    if (static_cast<size_t>(phase) >= trace_phase_count)
+        return "unknown";
+
+    return trace_phase_names[phase];
+}
+
+trace_event::trace_event() :
+    phase(trace_phase_parse), start(0.0), duration(0.0), thread(0), bytes(0), cells(0) {}
+
+trace_phase_stats::trace_phase_stats() :
+    event_count(0), duration(0.0), bytes(0), cells(0) {}
+
+class import_trace_impl
+{
+public:
+    typedef std::map<boost::thread::id, size_t> thread_map_type;
+
+    mutable boost::mutex m_mtx;
+    mutable thread_map_type m_threads;
+    std::vector<trace_event> m_events;
+    double m_origin;
+    size_t m_cell_count;
+
+    import_trace_impl() : m_origin(0.0), m_cell_count(0)
+    {
+        clear();
+    }
+
+    void clear()
+    {
+        m_events.clear();
+        m_threads.clear();
+        m_threads.insert(thread_map_type::value_type(boost::this_thread::get_id(), 0));
+        m_origin = get_current_time();
+        m_cell_count = 0;
+    }
+};
+
+import_trace::import_trace() : mp_impl(new import_trace_impl) {}
+
+import_trace::~import_trace()
+{
+    delete mp_impl;
+}
+
+void import_trace::clear()
+{
+    boost::mutex::scoped_lock lock(mp_impl->m_mtx);
+    mp_impl->clear();
+}
+
+double import_trace::now() const
+{
+    return get_current_time() - mp_impl->m_origin;
+}
+
+void import_trace::add_event(const trace_event& event)
+{
+    boost::mutex::scoped_lock lock(mp_impl->m_mtx);
+    mp_impl->m_events.push_back(event);
+}
+
+void import_trace::add_cells(size_t n)
+{
+    mp_impl->m_cell_count += n;
+}
+
+size_t import_trace::get_cell_count() const
+{
+    return mp_impl->m_cell_count;
+}
+
+size_t import_trace::get_thread_index() const
+{
+    boost::mutex::scoped_lock lock(mp_impl->m_mtx);
+    import_trace_impl::thread_map_type& threads = mp_impl->m_threads;
+    size_t index = threads.size();
+    return threads.insert(
+        import_trace_impl::thread_map_type::value_type(boost::this_thread::get_id(), index)).first->second;
+}
+
+vector<trace_event> import_trace::get_events() const
+{
+    boost::mutex::scoped_lock lock(mp_impl->m_mtx);
+    return mp_impl->m_events;
+}
+
+trace_phase_stats import_trace::get_phase_stats(trace_phase_t phase) const
+{
+    boost::mutex::scoped_lock lock(mp_impl->m_mtx);
+    trace_phase_stats stats;
+    vector<trace_event>::const_iterator it = mp_impl->m_events.begin(), it_end = mp_impl->m_events.end();
+    for (; it != it_end; ++it)
+    {
+        if (it->phase != phase)
+            continue;
+
+        ++stats.event_count;
+        stats.duration += it->duration;
+        stats.bytes += it->bytes;
+        stats.cells += it->cells;
+    }
+    return stats;
+}
+
+void import_trace::write_chrome_trace(ostream& os) const
+{
+    vector<trace_event> events = get_events();
+
+    // Timestamps and durations are in microseconds.
+    char buf[64];
+    os << "{\"traceEvents\":[";
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        const trace_event& e = events[i];
+        os << (i ? "," : "") << endl;
+        os << "{\"name\":";
+        write_json_string(os, e.name);
+        os << ",\"cat\":\"" << get_trace_phase_name(e.phase) << "\",\"ph\":\"X\"";
+        snprintf(buf, sizeof(buf), ",\"ts\":%.3f,\"dur\":%.3f", e.start*1000000.0, e.duration*1000000.0);
+        os << buf << ",\"pid\":0,\"tid\":" << e.thread;
+        os << ",\"args\":{\"bytes\":" << e.bytes << ",\"cells\":" << e.cells << "}}";
+    }
+    os << endl << "],\"displayTimeUnit\":\"ms\"}" << endl;
+}
+
+trace_scope::trace_scope(import_trace* trace, trace_phase_t phase, const char* name) :
+    mp_trace(trace), m_cell_count(0), m_count_cells(false)
+{
+    if (!mp_trace)
+        return;
+
+    m_event.phase = phase;
+    m_event.name = name;
+    start();
+}
+
+trace_scope::trace_scope(import_trace* trace, trace_phase_t phase, const string& name) :
+    mp_trace(trace), m_cell_count(0), m_count_cells(false)
+{
+    if (!mp_trace)
+        return;
+
+    m_event.phase = phase;
+    m_event.name = name;
+    start();
+}
+
+trace_scope::~trace_scope()
+{
+    finish();
+}
+
+void trace_scope::set_bytes(size_t bytes)
+{
+    m_event.bytes = bytes;
+}
+
+void trace_scope::finish()
+{
+    if (!mp_trace)
+        return;
+
+    m_event.duration = mp_trace->now() - m_event.start;
+    if (m_count_cells)
+        m_event.cells = mp_trace->get_cell_count() - m_cell_count;
+
+    mp_trace->add_event(m_event);
+    mp_trace = NULL;
+}
+
+void trace_scope::start()
+{
+    m_event.thread = mp_trace->get_thread_index();
+
+    // Cells are only counted on the thread that created the trace.
+    m_count_cells = m_event.thread == 0;
+    if (m_count_cells)
+        m_cell_count = mp_trace->get_cell_count();
+
+    m_event.start = mp_trace->now();
+}
+
+}
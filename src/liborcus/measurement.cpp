@@ -28,6 +28,7 @@
 #include "orcus/measurement.hpp"
 #include "orcus/pstring.hpp"
 #include "orcus/exception.hpp"
+#include "orcus/parser_global.hpp"
 
 #include <sstream>
 
@@ -35,99 +36,6 @@ using namespace std;
 
 namespace orcus {
 
-namespace {
-
-double parse_numeric(const char*& p, const char* p_end)
-{
-    double ret = 0.0, divisor = 1.0;
-    bool negative_sign = false;
-    bool before_decimal_pt = true;
-
-    // Check for presence of a sign.
-    if (p != p_end)
-    {
-        switch (*p)
-        {
-            case '+':
-                ++p;
-            break;
-            case '-':
-                negative_sign = true;
-                ++p;
-            break;
-            default:
-                ;
-        }
-    }
-
-    for (; p != p_end; ++p)
-    {
-        if (*p == '.')
-        {
-            if (!before_decimal_pt)
-            {
-                // Second '.' encountered. Terminate the parsing.
-                ret /= divisor;
-                return negative_sign ? -ret : ret;
-            }
-
-            before_decimal_pt = false;
-            continue;
-        }
-
-        if (*p < '0' || '9' < *p)
-        {
-            ret /= divisor;
-            return negative_sign ? -ret : ret;
-        }
-
-        ret *= 10.0;
-        ret += *p - '0';
-
-        if (!before_decimal_pt)
-            divisor *= 10.0;
-    }
-
-    ret /= divisor;
-    return negative_sign ? -ret : ret;
-}
-
-long parse_integer(const char*& p, const char* p_end)
-{
-    long ret = 0.0;
-    bool negative_sign = false;
-
-    // Check for presence of a sign.
-    if (p != p_end)
-    {
-        switch (*p)
-        {
-            case '+':
-                ++p;
-            break;
-            case '-':
-                negative_sign = true;
-                ++p;
-            break;
-            default:
-                ;
-        }
-    }
-
-    for (; p != p_end; ++p)
-    {
-        if (*p < '0' || '9' < *p)
-            return negative_sign ? -ret : ret;
-
-        ret *= 10;
-        ret += *p - '0';
-    }
-
-    return negative_sign ? -ret : ret;
-}
-
-}
-
 length_t::length_t() : unit(length_unit_unknown), value(0.0) {}
 
 std::string length_t::print() const
@@ -175,6 +83,16 @@ long to_long(const char* p, const char* p_end, const char** p_parse_ended)
     return val;
 }
 
+double to_double(const pstring& s, const char** p_parse_ended)
+{
+    return to_double(s.get(), s.get() + s.size(), p_parse_ended);
+}
+
+long to_long(const pstring& s, const char** p_parse_ended)
+{
+    return to_long(s.get(), s.get() + s.size(), p_parse_ended);
+}
+
 length_t to_length(const pstring& str)
 {
     length_t ret;
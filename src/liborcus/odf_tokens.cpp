@@ -35,7 +35,7 @@ namespace {
 
 }
 
-tokens odf_tokens = tokens(token_names, token_name_count);
+tokens odf_tokens = tokens(token_names, token_name_count, token_hash);
 
 }
 
@@ -2255,3 +2255,366 @@ const char* token_names[] = {
 
 size_t token_name_count = 2250;
 
+const unsigned int token_hash_displacements[] = {
+    1, 6, 2, 1, 1, 7, 14, 106,
+    7, 2, 42, 6, 24, 0, 237, 275,
+    116, 1, 4, 19, 124, 473, 11, 4,
+    215, 28, 131, 219, 12, 35, 30, 95,
+    0, 1, 0, 36, 75, 0, 109, 17,
+    46, 0, 122, 15, 8, 396, 4, 31,
+    45, 40, 36, 20, 1, 224, 14, 68,
+    0, 176, 22, 48, 56, 0, 76, 298,
+    26, 1, 16, 0, 29, 9, 16, 0,
+    3, 1, 72, 157, 4, 173, 53, 8,
+    0, 62, 14, 2, 33, 83, 50, 71,
+    6, 332, 18, 127, 0, 1, 7, 0,
+    25, 25, 54, 5, 7, 1, 1, 50,
+    42, 160, 17, 95, 82, 59, 2, 27,
+    5, 87, 1, 76, 100, 2, 72, 0,
+    122, 176, 121, 61, 27, 0, 36, 13,
+    2, 2, 14, 27, 0, 442, 3, 1,
+    55, 50, 43, 84, 52, 52, 15, 15,
+    55, 233, 30, 7, 5, 16, 212, 0,
+    0, 3, 100, 22, 67, 11, 2, 10,
+    106, 13, 0, 1, 8, 83, 384, 0,
+    16, 128, 1, 102, 107, 16, 165, 9,
+    1, 1, 2, 0, 1, 45, 5, 0,
+    0, 3, 2, 180, 137, 1, 21, 9,
+    7, 24, 14, 34, 379, 20, 23, 204,
+    12, 16, 22, 71, 34, 39, 72, 2,
+    172, 109, 79, 23, 0, 3, 29, 196,
+    54, 214, 15, 0, 23, 298, 9, 272,
+    19, 1, 242, 36, 316, 1, 70, 0,
+    0, 7, 3, 18, 38, 129, 0, 235,
+    228, 11, 153, 9, 91, 117, 17, 2,
+    71, 9, 11, 279, 115, 5, 7, 21,
+    0, 1, 166, 101, 0, 0, 1, 25,
+    493, 5, 6, 9, 251, 26, 7, 73,
+    195, 8, 15, 29, 9, 211, 2, 8,
+    412, 22, 31, 1023, 28, 1, 11, 405,
+    3, 24, 536, 38, 0, 161, 118, 42,
+    70, 4, 33, 16, 193, 135, 0, 23,
+    0, 43, 1, 16, 45, 883, 77, 118,
+    4, 475, 62, 120, 27, 98, 236, 21,
+    1, 7, 113, 35, 31, 11, 179, 21,
+    3, 23, 1127, 71, 201, 540, 43, 134,
+    239, 779, 19, 16, 315, 1, 6, 232,
+    9, 5, 10, 61, 80, 117, 113, 17,
+    177, 804, 39, 13, 1217, 155, 36, 81,
+    1, 125, 55, 12, 6, 34, 166, 3,
+    1116, 126, 142, 259, 56, 24, 45, 134,
+    1138, 283, 10, 1, 300, 1, 146, 247,
+    0, 250, 0, 0, 1054, 47, 0, 109,
+    26, 83, 0, 9, 7, 59, 17, 51,
+    74, 70, 0, 76, 50, 13, 8, 67,
+    4, 3, 18, 15, 276, 137, 10, 468,
+    173, 0, 9, 1, 5, 48, 0, 56,
+    729, 34, 162, 2, 1839, 76, 25, 3915,
+    1026, 19, 707, 237, 133, 635, 30, 114,
+    55, 0, 2, 38, 28, 608, 100, 1,
+    351, 1271, 84, 9, 49, 528, 92, 156,
+    1185, 349, 245, 2679, 488, 106, 129, 12,
+    3, 574, 0, 359, 380, 162, 19, 363,
+    80, 563, 81, 137, 11, 168, 2130, 218,
+    298, 2, 7, 118, 7, 8, 2, 2552,
+    145, 181, 72, 0, 8, 660, 599, 2826,
+    775, 1, 995, 336, 128, 1, 756, 12,
+    3014, 73, 105, 0, 81, 83, 150, 5,
+    146, 4331, 660, 0, 21, 756, 276, 706,
+    5, 110, 11, 2, 1, 0, 16, 3,
+    378, 14, 833, 25, 1157, 1, 2173, 26,
+    0, 8, 956, 1, 57, 12, 0, 91,
+    306, 256, 1815, 148, 759, 122, 87, 43,
+    1242, 962, 649, 8, 0, 0, 2, 9040,
+    874, 318, 665,
+};
+
+const xml_token_t token_hash_slots[] = {
+    1630, 1831, 1086, 822, 2219, 727, 460, 234,
+    493, 524, 907, 77, 457, 63, 2190, 1198,
+    976, 1162, 939, 47, 1540, 1734, 1145, 2021,
+    1592, 1375, 1163, 1326, 1047, 52, 820, 326,
+    802, 1914, 104, 1187, 1241, 1816, 947, 978,
+    394, 273, 877, 1378, 1273, 1017, 1120, 1405,
+    134, 863, 137, 777, 1067, 56, 1620, 2053,
+    815, 629, 499, 809, 955, 586, 1371, 19,
+    967, 448, 2207, 1334, 1481, 1634, 1911, 1751,
+    602, 163, 1884, 1532, 1338, 830, 1901, 213,
+    352, 2048, 346, 2151, 1740, 679, 1932, 1231,
+    2013, 801, 185, 1807, 817, 1256, 1712, 397,
+    1888, 1340, 2, 522, 1023, 1353, 1942, 1862,
+    1332, 1331, 831, 1749, 903, 678, 73, 344,
+    199, 2198, 312, 233, 270, 1727, 267, 1000,
+    59, 2189, 1755, 1496, 1156, 2160, 2232, 833,
+    1609, 732, 2166, 1364, 1464, 99, 1366, 407,
+    537, 1972, 279, 498, 1714, 1617, 1269, 1203,
+    744, 1587, 1228, 1286, 637, 220, 2177, 1028,
+    410, 1330, 338, 2206, 782, 2015, 2197, 650,
+    1507, 1866, 2196, 788, 762, 1093, 1992, 1574,
+    749, 1742, 391, 811, 790, 690, 179, 363,
+    232, 1539, 1175, 2144, 1361, 872, 1297, 715,
+    440, 1830, 937, 663, 1792, 74, 970, 184,
+    699, 810, 2042, 231, 1079, 2010, 2154, 1912,
+    1569, 689, 1137, 617, 416, 1246, 1635, 594,
+    1750, 2138, 789, 1645, 761, 645, 1110, 845,
+    519, 1753, 1213, 2188, 1674, 1683, 167, 724,
+    1928, 1467, 1673, 1993, 707, 1946, 559, 2069,
+    186, 641, 49, 1521, 187, 621, 850, 1864,
+    236, 2172, 1244, 481, 608, 1204, 1261, 114,
+    1671, 1349, 1989, 1021, 1821, 673, 979, 844,
+    81, 2133, 929, 2136, 1647, 174, 464, 655,
+    1908, 1480, 399, 1111, 771, 1315, 2112, 219,
+    109, 1767, 1741, 1333, 474, 1255, 329, 691,
+    1399, 1958, 1953, 93, 1607, 1404, 865, 2011,
+    1962, 1033, 1736, 317, 1463, 2248, 298, 989,
+    1704, 38, 118, 2028, 914, 358, 799, 662,
+    909, 1051, 283, 1937, 1973, 459, 1274, 480,
+    428, 1604, 320, 2024, 1474, 680, 257, 924,
+    2159, 1688, 2152, 1678, 1036, 1295, 1859, 140,
+    921, 1434, 2239, 1679, 896, 1319, 729, 2076,
+    2086, 1717, 614, 2209, 2072, 1250, 2038, 1063,
+    370, 1881, 2201, 2244, 15, 1222, 41, 1015,
+    964, 549, 17, 130, 183, 1483, 1002, 281,
+    54, 1974, 1311, 1252, 24, 1586, 337, 2106,
+    1759, 1027, 649, 1811, 546, 940, 1766, 2003,
+    2233, 2122, 303, 1663, 1665, 660, 1752, 1265,
+    442, 619, 28, 798, 1695, 409, 778, 631,
+    276, 1431, 216, 1039, 726, 2247, 526, 1014,
+    1412, 1460, 16, 2032, 516, 36, 22, 928,
+    1351, 2045, 316, 1236, 868, 1518, 1517, 1986,
+    1321, 46, 1848, 1721, 1919, 1887, 1991, 1346,
+    309, 1954, 1867, 775, 846, 618, 1043, 2231,
+    1658, 2130, 1762, 793, 847, 2194, 455, 88,
+    26, 2218, 1798, 540, 1098, 703, 1701, 750,
+    994, 991, 610, 1230, 1196, 2071, 2186, 1489,
+    1939, 2147, 607, 1032, 1251, 392, 622, 1632,
+    1294, 2096, 1348, 1985, 2217, 212, 1541, 1860,
+    2009, 580, 1225, 348, 1451, 1181, 1011, 1773,
+    484, 2065, 927, 936, 1050, 1572, 601, 1263,
+    302, 341, 999, 225, 1568, 23, 824, 1886,
+    451, 818, 1882, 897, 1107, 1763, 2002, 1566,
+    452, 2155, 2120, 1475, 858, 573, 2025, 1106,
+    1801, 1844, 1689, 2183, 1950, 1307, 1979, 1710,
+    1646, 284, 103, 1883, 2085, 1814, 1542, 1417,
+    838, 685, 339, 805, 1653, 1966, 123, 652,
+    488, 292, 1155, 1842, 658, 624, 1789, 781,
+    1666, 373, 255, 1591, 595, 1448, 182, 730,
+    2165, 1374, 2079, 720, 742, 808, 541, 371,
+    2005, 2142, 1896, 1393, 1083, 1048, 2193, 7,
+    763, 1857, 571, 2236, 1642, 176, 1916, 1661,
+    758, 1654, 654, 606, 1778, 1626, 433, 1129,
+    70, 796, 971, 1046, 2141, 592, 1194, 1121,
+    1149, 1091, 1783, 1357, 1895, 504, 406, 171,
+    773, 973, 1537, 2027, 1341, 336, 211, 431,
+    1019, 884, 1289, 774, 90, 1074, 1731, 2245,
+    1872, 1527, 1952, 1210, 429, 550, 2073, 1606,
+    667, 1611, 1208, 893, 1696, 353, 417, 1725,
+    1709, 1904, 489, 2221, 57, 1072, 1903, 1744,
+    223, 335, 791, 560, 1259, 849, 681, 585,
+    1122, 2139, 1254, 566, 1459, 2180, 1522, 1565,
+    1636, 122, 1, 528, 2129, 887, 509, 53,
+    355, 25, 1846, 239, 1805, 177, 1524, 2062,
+    1877, 328, 1097, 2014, 1174, 1612, 880, 1426,
+    2054, 910, 1556, 875, 713, 1271, 1099, 180,
+    1177, 998, 1127, 2077, 444, 112, 2163, 1530,
+    2101, 1573, 1085, 1438, 1601, 383, 401, 1605,
+    4, 984, 692, 1490, 1910, 1825, 149, 288,
+    2036, 150, 1118, 752, 1381, 2041, 1268, 800,
+    1700, 1498, 1132, 325, 738, 1557, 899, 1758,
+    829, 1477, 29, 548, 938, 260, 737, 436,
+    786, 1589, 1211, 1218, 1628, 1672, 196, 330,
+    347, 874, 1322, 124, 1052, 1813, 1637, 2083,
+    1057, 151, 11, 676, 396, 1840, 319, 362,
+    467, 886, 1103, 892, 1854, 252, 1892, 1421,
+    2008, 2075, 1049, 1694, 1980, 1894, 1395, 1581,
+    398, 405, 164, 2081, 1670, 237, 2020, 584,
+    1105, 870, 1841, 1551, 1075, 2176, 879, 1906,
+    915, 235, 1240, 582, 864, 1287, 1373, 168,
+    1571, 369, 2215, 79, 859, 2210, 1590, 2220,
+    1324, 1442, 162, 1923, 311, 377, 426, 1600,
+    1025, 1995, 147, 2135, 1772, 1905, 1652, 1201,
+    723, 2092, 1996, 139, 959, 2017, 1031, 502,
+    1323, 902, 813, 51, 2195, 1056, 240, 1285,
+    367, 175, 1454, 1692, 1092, 2012, 1693, 825,
+    951, 1745, 241, 697, 1433, 670, 1096, 1144,
+    944, 512, 2030, 1087, 1425, 1006, 2126, 1260,
+    412, 983, 1370, 1258, 906, 1124, 956, 1416,
+    2145, 1852, 1290, 719, 1561, 214, 191, 1838,
+    1128, 67, 1082, 126, 1768, 201, 1350, 542,
+    1770, 1069, 756, 181, 1754, 747, 1004, 1090,
+    111, 1615, 1707, 2131, 494, 1037, 2018, 889,
+    203, 1769, 342, 603, 1851, 736, 37, 1698,
+    438, 1555, 523, 1853, 2208, 2181, 795, 1143,
+    1339, 42, 1009, 153, 530, 1484, 1705, 1494,
+    1116, 254, 1956, 1535, 430, 706, 1997, 1913,
+    2203, 1560, 1169, 701, 1401, 590, 1164, 1154,
+    327, 1927, 1221, 423, 1824, 256, 1492, 141,
+    1726, 819, 1774, 982, 2187, 794, 1545, 871,
+    2026, 1062, 280, 1427, 769, 1308, 534, 1243,
+    172, 628, 860, 966, 2115, 1924, 1602, 1803,
+    945, 1865, 545, 514, 420, 583, 1898, 1715,
+    709, 1790, 100, 1327, 1808, 1957, 2087, 1564,
+    669, 194, 82, 1304, 1520, 486, 268, 2004,
+    957, 708, 911, 898, 1761, 1685, 482, 576,
+    1499, 1843, 881, 222, 1207, 246, 350, 1403,
+    916, 995, 1455, 1990, 766, 638, 269, 1253,
+    310, 1959, 1619, 1088, 1961, 2175, 922, 552,
+    6, 272, 1176, 2070, 2157, 1933, 1388, 421,
+    770, 1579, 1614, 1922, 1312, 1501, 132, 605,
+    1372, 253, 2040, 1345, 1730, 807, 572, 1523,
+    228, 209, 1713, 1264, 642, 1306, 577, 205,
+    1820, 1158, 1880, 138, 923, 746, 13, 2023,
+    1875, 165, 271, 969, 1277, 1915, 197, 908,
+    1018, 1738, 739, 1534, 170, 598, 1462, 1488,
+    1836, 900, 1189, 1040, 86, 2039, 1219, 190,
+    1931, 1943, 1314, 2113, 157, 882, 1367, 1999,
+    565, 1785, 1724, 390, 2200, 1094, 1396, 2224,
+    1949, 1068, 32, 45, 2047, 508, 1891, 1281,
+    1514, 1262, 671, 1603, 1329, 1316, 372, 1061,
+    1476, 389, 1757, 533, 1856, 136, 2162, 1998,
+    354, 290, 2150, 2107, 1559, 445, 1706, 1595,
+    106, 360, 1293, 156, 178, 648, 943, 227,
+    247, 2127, 1863, 1134, 1394, 535, 633, 1235,
+    1382, 376, 1610, 1392, 1292, 1397, 1385, 1621,
+    1550, 83, 510, 543, 58, 131, 704, 2006,
+    958, 1965, 569, 87, 2034, 1827, 597, 1668,
+    2202, 1930, 1153, 823, 2097, 368, 826, 700,
+    1764, 1897, 1599, 1192, 1233, 152, 1343, 1833,
+    413, 1354, 1038, 385, 2007, 634, 1435, 2235,
+    1291, 1812, 2067, 1659, 1112, 780, 463, 2102,
+    446, 173, 116, 728, 968, 322, 425, 547,
+    941, 1296, 1139, 2074, 1608, 1563, 1983, 2001,
+    1288, 1644, 1058, 1168, 384, 1771, 1869, 731,
+    110, 1804, 1711, 1597, 366, 1627, 674, 1360,
+    656, 1920, 30, 894, 2140, 2055, 1270, 243,
+    1411, 393, 1503, 323, 2192, 564, 529, 43,
+    783, 1984, 9, 1639, 1703, 1478, 561, 753,
+    1528, 2134, 1430, 2111, 1667, 1861, 1577, 1160,
+    693, 1780, 1810, 917, 1209, 840, 462, 2043,
+    1558, 1716, 553, 2100, 1272, 286, 382, 2169,
+    492, 1223, 675, 2050, 1510, 2105, 599, 1982,
+    954, 1125, 1458, 1452, 1643, 1284, 291, 2057,
+    1832, 1858, 1786, 1165, 1675, 2246, 1184, 718,
+    101, 1531, 694, 997, 454, 2044, 146, 490,
+    683, 1699, 963, 449, 862, 1409, 148, 558,
+    905, 2174, 677, 249, 1453, 207, 797, 1202,
+    1298, 1469, 1029, 710, 307, 2178, 20, 192,
+    1310, 1549, 1516, 1940, 1941, 593, 1737, 919,
+    1008, 930, 1907, 1732, 2143, 640, 403, 1199,
+    258, 1450, 2171, 1708, 169, 1794, 166, 308,
+    721, 2033, 1003, 538, 415, 496, 387, 304,
+    1432, 613, 741, 986, 1978, 418, 437, 1443,
+    1873, 2029, 1102, 1580, 2225, 992, 289, 1077,
+    198, 476, 1650, 1680, 470, 296, 80, 1248,
+    657, 2204, 1044, 665, 1070, 1797, 251, 511,
+    458, 102, 1975, 505, 1624, 1596, 2109, 1379,
+    411, 1059, 531, 380, 1335, 1776, 40, 1829,
+    1660, 806, 1161, 117, 615, 265, 536, 735,
+    1141, 1697, 1893, 696, 1418, 740, 755, 1594,
+    1428, 1728, 453, 1400, 2094, 357, 760, 469,
+    2049, 1588, 953, 120, 95, 1682, 784, 2046,
+    962, 1355, 1970, 2242, 1756, 477, 195, 1138,
+    1649, 725, 1358, 2063, 125, 672, 1676, 1456,
+    1618, 282, 920, 2068, 92, 1616, 1640, 501,
+    933, 1001, 1648, 244, 1885, 1100, 2119, 294,
+    34, 772, 1224, 161, 1487, 1182, 767, 1976,
+    1815, 705, 934, 1064, 2148, 1436, 1420, 76,
+    2016, 261, 1921, 1544, 1422, 1802, 202, 867,
+    1042, 1190, 1206, 1387, 804, 1237, 743, 835,
+    1502, 263, 1977, 2123, 885, 948, 285, 94,
+    2158, 2061, 1142, 1157, 722, 2149, 2064, 1356,
+    144, 27, 977, 527, 468, 702, 873, 1109,
+    1035, 119, 2227, 714, 612, 374, 1681, 427,
+    12, 96, 1183, 1195, 1441, 836, 1337, 1868,
+    1126, 1133, 1413, 1845, 2230, 1447, 2114, 1655,
+    639, 1495, 1415, 1123, 314, 386, 142, 1889,
+    155, 1553, 866, 1185, 626, 238, 44, 843,
+    2080, 1380, 1410, 1300, 1963, 1171, 1446, 1471,
+    1108, 931, 1440, 1817, 378, 68, 332, 91,
+    1140, 84, 66, 1925, 447, 299, 1299, 1493,
+    1461, 359, 1935, 975, 1303, 1423, 2000, 1497,
+    1585, 1938, 517, 1024, 2031, 1871, 913, 647,
+    1159, 2168, 1013, 2089, 814, 643, 334, 1664,
+    1506, 544, 143, 2088, 160, 682, 1152, 1485,
+    587, 264, 1890, 2093, 154, 404, 935, 495,
+    1215, 1690, 557, 2037, 787, 85, 1509, 78,
+    1376, 745, 2226, 1656, 443, 853, 297, 1917,
+    1146, 1822, 1870, 1136, 2170, 145, 135, 627,
+    556, 926, 1389, 1135, 208, 2084, 1552, 218,
+    1505, 1657, 812, 1200, 450, 1468, 988, 115,
+    1782, 932, 105, 503, 1368, 55, 1173, 1034,
+    942, 1216, 1016, 2185, 1302, 1826, 1669, 1318,
+    687, 575, 422, 567, 2104, 764, 340, 2216,
+    712, 883, 695, 1513, 1512, 1981, 262, 1739,
+    659, 2124, 364, 1445, 400, 1313, 1486, 107,
+    242, 1547, 965, 1359, 2128, 1900, 1229, 1987,
+    1104, 1406, 1651, 623, 688, 230, 466, 952,
+    1578, 1735, 206, 1054, 2098, 1687, 1623, 1066,
+    1964, 1055, 609, 1784, 69, 1743, 1583, 589,
+    2125, 461, 1723, 2121, 2052, 604, 666, 1101,
+    856, 277, 1733, 1239, 1968, 1180, 1629, 2156,
+    912, 65, 62, 776, 1408, 456, 1508, 50,
+    1529, 500, 651, 1834, 581, 1718, 408, 1465,
+    1796, 331, 1593, 2179, 2056, 1631, 2205, 1828,
+    1030, 1622, 278, 1686, 1613, 1317, 2164, 2173,
+    1787, 1188, 2222, 1278, 127, 1386, 1945, 839,
+    2191, 1466, 717, 816, 748, 1874, 1437, 2212,
+    259, 551, 1305, 2116, 402, 1249, 1720, 852,
+    1220, 1325, 635, 31, 1641, 2132, 2117, 14,
+    591, 1472, 1548, 1309, 946, 1625, 1788, 1078,
+    1115, 520, 861, 1533, 2066, 351, 465, 888,
+    1365, 439, 1847, 491, 1457, 646, 1684, 878,
+    1238, 2240, 851, 1633, 1994, 661, 1242, 1384,
+    1576, 792, 128, 1748, 497, 1342, 1575, 1234,
+    1793, 855, 1791, 1279, 1479, 2184, 1073, 1022,
+    1119, 478, 854, 684, 1543, 1041, 75, 1960,
+    2223, 1170, 1439, 1747, 1257, 1948, 1482, 1570,
+    981, 1076, 636, 2238, 1746, 1473, 1275, 1084,
+    996, 961, 305, 2213, 904, 2108, 275, 1166,
+    2199, 960, 2249, 1491, 949, 1117, 1818, 664,
+    890, 554, 2051, 414, 525, 60, 1053, 1765,
+    361, 2103, 1114, 2019, 2241, 1429, 356, 1918,
+    61, 113, 1781, 1584, 1362, 1390, 632, 2118,
+    1328, 1336, 653, 287, 757, 616, 1806, 1876,
+    515, 221, 483, 1320, 1511, 1722, 668, 841,
+    2082, 471, 64, 158, 644, 513, 1081, 1020,
+    388, 539, 1955, 1245, 1779, 857, 473, 869,
+    266, 71, 472, 1005, 1344, 1232, 518, 1519,
+    1515, 1795, 217, 1777, 133, 2110, 306, 188,
+    1837, 1383, 35, 349, 1010, 343, 345, 562,
+    2022, 698, 716, 834, 485, 1419, 1662, 1402,
+    506, 1567, 434, 2167, 1971, 765, 1702, 1283,
+    2090, 848, 1909, 395, 226, 1944, 250, 574,
+    1095, 210, 588, 2059, 620, 1172, 432, 1147,
+    1026, 1449, 785, 1899, 2035, 204, 313, 2237,
+    1197, 1691, 2214, 521, 570, 754, 1444, 2211,
+    121, 980, 1546, 1562, 507, 48, 2099, 1525,
+    686, 1217, 1926, 365, 1363, 1080, 711, 381,
+    837, 97, 733, 2137, 189, 1934, 5, 768,
+    33, 1012, 1677, 1347, 987, 193, 1060, 2153,
+    1470, 1598, 1391, 2078, 1504, 2058, 891, 1227,
+    1352, 2146, 1902, 1849, 21, 1113, 1850, 2228,
+    375, 1878, 832, 1214, 1226, 475, 2060, 315,
+    424, 578, 1538, 98, 1526, 1500, 318, 2091,
+    1212, 1179, 1929, 295, 1839, 1760, 751, 1414,
+    2182, 1951, 1130, 895, 487, 563, 1369, 1800,
+    1377, 1007, 579, 1809, 950, 1276, 10, 1186,
+    1719, 901, 1191, 1178, 248, 1282, 2095, 8,
+    39, 734, 1424, 224, 1266, 1071, 1148, 1729,
+    108, 1205, 1799, 1947, 972, 974, 3, 596,
+    2234, 1823, 1151, 129, 828, 1131, 441, 555,
+    1988, 324, 1167, 245, 803, 1969, 611, 321,
+    1301, 876, 1554, 827, 821, 1855, 215, 1280,
+    1638, 293, 2229, 532, 1089, 18, 842, 300,
+    72, 759, 379, 1398, 159, 479, 1150, 985,
+    1267, 1407, 1582, 568, 1936, 229, 274, 1045,
+    1835, 2161, 779, 1193, 625, 925, 419, 1879,
+    1967, 1536, 1247, 993, 89, 990, 2243, 630,
+    918, 1775, 301, 200, 600, 1065, 1819, 435,
+    333,
+};
+
+const token_hash_table token_hash = {
+    token_hash_displacements, 563, token_hash_slots, 2249
+};
+
@@ -31,6 +31,7 @@
 #include "odf_styles_context.hpp"
 
 #include "orcus/global.hpp"
+#include "orcus/measurement.hpp"
 #include "orcus/spreadsheet/import_interface.hpp"
 
 #include <iostream>
@@ -44,6 +45,13 @@ namespace orcus {
 
 namespace {
 
+/**
+ * Largest row and column IDs an ods document can address.  Repeated cells
+ * are clipped to them.
+ */
+const int max_row = 1048575;
+const int max_col = 1023;
+
 class null_date_attr_parser : public unary_function<xml_token_attr_t, void>
 {
 public:
@@ -116,10 +124,12 @@ public:
             {
                 case XML_number_rows_repeated:
                 {
-                    char* endptr;
-                    long val = strtol(attr.value.str().c_str(), &endptr, 10);
-                    if (endptr != attr.value.str())
-                        m_number_rows_repeated = val;
+                    const char* end = attr.value.get() + attr.value.size();
+                    const char* endptr;
+                    long val = to_long(attr.value, &endptr);
+                    if (endptr == end && val > 0)
+                        // Anything beyond the last row is outside the sheet.
+                        m_number_rows_repeated = std::min<long>(val, max_row + 1);
                 }
                 break;
                 case XML_style_name:
@@ -164,10 +174,11 @@ private:
             case XML_number_columns_repeated:
             {
                 const char* end = attr.value.get() + attr.value.size();
-                char* endptr;
-                long val = strtol(attr.value.get(), &endptr, 10);
-                if (endptr == end)
-                    m_attr.number_columns_repeated = static_cast<int>(val);
+                const char* endptr;
+                long val = to_long(attr.value, &endptr);
+                if (endptr == end && val > 0)
+                    // Anything beyond the last column is outside the sheet.
+                    m_attr.number_columns_repeated = std::min<long>(val, max_col + 1);
             }
             break;
             default:
@@ -182,8 +193,8 @@ private:
             case XML_value:
             {
                 const char* end = attr.value.get() + attr.value.size();
-                char* endptr;
-                double val = strtod(attr.value.get(), &endptr);
+                const char* endptr;
+                double val = to_double(attr.value, &endptr);
                 if (endptr == end)
                     m_attr.value = val;
             }
@@ -225,15 +236,26 @@ ods_content_xml_context::cell_attr::cell_attr() :
 
 // ============================================================================
 
+ods_content_xml_context::format_range::format_range(
+    spreadsheet::row_t _row1, spreadsheet::col_t _col1,
+    spreadsheet::row_t _row2, spreadsheet::col_t _col2, size_t _xf_index) :
+    row1(_row1), col1(_col1), row2(_row2), col2(_col2), xf_index(_xf_index) {}
+
 ods_content_xml_context::ods_content_xml_context(session_context& session_cxt, const tokens& tokens, spreadsheet::iface::import_factory* factory) :
     xml_context_base(session_cxt, tokens),
     mp_factory(factory),
+    m_row_buffer(NULL),
     m_row(0), m_col(0),
     m_para_index(0),
     m_has_content(false),
+    m_row_has_value(false),
     m_styles(),
     m_child_para(session_cxt, tokens, factory->get_shared_strings(), m_styles)
 {
+    // Default null date, in effect unless the document specifies one.
+    m_origin_date.year = 1899;
+    m_origin_date.month = 12;
+    m_origin_date.day = 30;
 }
 
 ods_content_xml_context::~ods_content_xml_context()
@@ -330,6 +352,12 @@ void ods_content_xml_context::start_element(xmlns_id_t ns, xml_token_t name, con
             break;
             case XML_spreadsheet:
             break;
+            case XML_scripts:
+            case XML_font_face_decls:
+            case XML_forms:
+                // Not imported.
+                skip_subtree();
+            break;
             default:
                 warn_unhandled();
         }
@@ -338,6 +366,14 @@ void ods_content_xml_context::start_element(xmlns_id_t ns, xml_token_t name, con
     {
         switch (name)
         {
+            case XML_named_expressions:
+            case XML_shapes:
+            case XML_content_validations:
+            case XML_dde_links:
+            case XML_database_ranges:
+                // Not imported.
+                skip_subtree();
+            break;
             case XML_calculation_settings:
             break;
             case XML_null_date:
@@ -415,15 +451,15 @@ void ods_content_xml_context::characters(const pstring& str, bool transient)
 
 void ods_content_xml_context::start_null_date(const xml_attrs_t& attrs)
 {
+    pstring null_date = for_each(attrs.begin(), attrs.end(), null_date_attr_parser()).get_date_value();
+    m_origin_date = to_date_time(null_date);
+
     spreadsheet::iface::import_global_settings* gs = mp_factory->get_global_settings();
     if (!gs)
         // Global settings not available. No point going further.
         return;
 
-    pstring null_date = for_each(attrs.begin(), attrs.end(), null_date_attr_parser()).get_date_value();
-    date_time_t val = to_date_time(null_date);
-
-    gs->set_origin_date(val.year, val.month, val.day);
+    gs->set_origin_date(m_origin_date.year, m_origin_date.month, m_origin_date.day);
 }
 
 void ods_content_xml_context::start_table(const xml_attrs_t& attrs)
@@ -431,13 +467,20 @@ void ods_content_xml_context::start_table(const xml_attrs_t& attrs)
     table_attr_parser parser = for_each(attrs.begin(), attrs.end(), table_attr_parser());
     const pstring& name = parser.get_name();
     m_tables.push_back(mp_factory->append_sheet(name.get(), name.size()));
+    m_row_buffer.set_sheet(m_tables.back());
     cout << "start table " << name << endl;
 
     m_row = m_col = 0;
+    m_pending_formats.clear();
 }
 
 void ods_content_xml_context::end_table()
 {
+    m_row_buffer.flush();
+
+    // Repeated empty rows after the last row with values typically only
+    // carry a format down to the bottom of the sheet.  Drop them.
+    m_pending_formats.clear();
     cout << "end table" << endl;
 }
 
@@ -469,6 +512,7 @@ void ods_content_xml_context::end_column()
 void ods_content_xml_context::start_row(const xml_attrs_t& attrs)
 {
     m_col = 0;
+    m_row_has_value = false;
     m_row_attr = row_attr();
     row_attr_parser func;
     func = for_each(attrs.begin(), attrs.end(), func);
@@ -491,12 +535,24 @@ void ods_content_xml_context::start_row(const xml_attrs_t& attrs)
 
 void ods_content_xml_context::end_row()
 {
-    if (m_row_attr.number_rows_repeated > 1)
+    m_row_buffer.flush();
+
+    if (m_row_has_value)
     {
-        // TODO: repeat this row.
-//      cout << "repeat this row " << m_row_attr.number_rows_repeated << " times" << endl;
+        // The empty rows held so far lie within the data.
+        flush_formats(m_pending_formats);
+        flush_formats(m_row_formats);
     }
-    m_row += m_row_attr.number_rows_repeated;
+    else
+    {
+        m_pending_formats.insert(m_pending_formats.end(), m_row_formats.begin(), m_row_formats.end());
+        m_row_formats.clear();
+    }
+
+    // The cells of a repeated row have already been filled over all the
+    // rows it repeats.  Stop counting past the end of the sheet, so that
+    // the row position doesn't overflow.
+    m_row = std::min<long>(long(m_row) + m_row_attr.number_rows_repeated, max_row + 1);
 }
 
 void ods_content_xml_context::start_cell(const xml_attrs_t& attrs)
@@ -507,32 +563,72 @@ void ods_content_xml_context::start_cell(const xml_attrs_t& attrs)
 
 void ods_content_xml_context::end_cell()
 {
+    if (m_row > max_row || m_col > max_col)
+    {
+        // Outside of the sheet.
+        m_col = std::min<long>(long(m_col) + m_cell_attr.number_columns_repeated, max_col + 1);
+        m_has_content = false;
+        return;
+    }
+
+    // A repeated cell in a repeated row covers a whole rectangle.
+    spreadsheet::row_t row_last = m_row + std::min(m_row_attr.number_rows_repeated - 1, max_row - m_row);
+    spreadsheet::col_t col_last = m_col + std::min(m_cell_attr.number_columns_repeated - 1, max_col - m_col);
+    bool single = row_last == m_row && col_last == m_col;
+
+    bool has_value = has_cell_value();
+    if (has_value)
+        m_row_has_value = true;
+
     name2id_type::const_iterator it = m_cell_format_map.find(m_cell_attr.style_name);
     if (it != m_cell_format_map.end())
-        m_tables.back()->set_format(m_row, m_col, it->second);
-
-    push_cell_value();
+    {
+        if (single)
+            m_row_buffer.set_format(m_row, m_col, it->second);
+        else if (m_row_attr.number_rows_repeated > 1)
+            // Whether this row lies within the data is known only at its end.
+            m_row_formats.push_back(format_range(m_row, m_col, row_last, col_last, it->second));
+        else
+            m_tables.back()->set_format_range(m_row, m_col, row_last, col_last, it->second);
+    }
 
-    ++m_col;
-    if (m_cell_attr.number_columns_repeated > 1)
+    if (has_value)
     {
-        int col_upper = m_col + m_cell_attr.number_columns_repeated - 2;
-        for (; m_col <= col_upper; ++m_col)
+        if (single)
             push_cell_value();
+        else
+            push_cell_value_range(row_last, col_last);
     }
+
+    m_col = std::min<long>(long(m_col) + m_cell_attr.number_columns_repeated, max_col + 1);
     m_has_content = false;
 }
 
+bool ods_content_xml_context::has_cell_value() const
+{
+    switch (m_cell_attr.type)
+    {
+        case vt_float:
+        case vt_date:
+            return true;
+        case vt_string:
+            return m_has_content;
+        default:
+            ;
+    }
+    return false;
+}
+
 void ods_content_xml_context::push_cell_value()
 {
     switch (m_cell_attr.type)
     {
         case vt_float:
-            m_tables.back()->set_value(m_row, m_col, m_cell_attr.value);
+            m_row_buffer.set_value(m_row, m_col, m_cell_attr.value);
         break;
         case vt_string:
             if (m_has_content)
-                m_tables.back()->set_string(m_row, m_col, m_para_index);
+                m_row_buffer.set_string(m_row, m_col, m_para_index);
         break;
         case vt_date:
         {
@@ -546,4 +642,42 @@ void ods_content_xml_context::push_cell_value()
     }
 }
 
+void ods_content_xml_context::push_cell_value_range(spreadsheet::row_t row_last, spreadsheet::col_t col_last)
+{
+    spreadsheet::iface::import_sheet* sheet = m_tables.back();
+    switch (m_cell_attr.type)
+    {
+        case vt_float:
+            sheet->set_value_range(m_row, m_col, row_last, col_last, m_cell_attr.value);
+        break;
+        case vt_string:
+            if (m_has_content)
+                sheet->set_string_range(m_row, m_col, row_last, col_last, m_para_index);
+        break;
+        case vt_date:
+        {
+            // There is no range setter for dates, but a date cell is stored
+            // as its serial value relative to the null date.
+            date_time_t val = to_date_time(m_cell_attr.date_value);
+            long days = to_day_number(val.year, val.month, val.day) -
+                to_day_number(m_origin_date.year, m_origin_date.month, m_origin_date.day);
+            double time = (val.hour * 3600.0 + val.minute * 60.0 + val.second) / 86400.0;
+            sheet->set_value_range(m_row, m_col, row_last, col_last, days + time);
+        }
+        break;
+        default:
+            ;
+    }
+}
+
+void ods_content_xml_context::flush_formats(format_ranges_type& formats)
+{
+    spreadsheet::iface::import_sheet* sheet = m_tables.back();
+    format_ranges_type::const_iterator it = formats.begin(), it_end = formats.end();
+    for (; it != it_end; ++it)
+        sheet->set_format_range(it->row1, it->col1, it->row2, it->col2, it->xf_index);
+
+    formats.clear();
+}
+
 }
@@ -31,6 +31,7 @@
 #include "xml_context_base.hpp"
 #include "odf_para_context.hpp"
 #include "odf_styles.hpp"
+#include "sheet_row_buffer.hpp"
 
 #include <vector>
 #include <boost/scoped_ptr.hpp>
@@ -69,6 +70,24 @@ public:
         cell_attr();
     };
 
+    /**
+     * Cell format set to a rectangular range of cells.
+     */
+    struct format_range
+    {
+        spreadsheet::row_t row1;
+        spreadsheet::col_t col1;
+        spreadsheet::row_t row2;
+        spreadsheet::col_t col2;
+        size_t xf_index;
+
+        format_range(
+            spreadsheet::row_t _row1, spreadsheet::col_t _col1,
+            spreadsheet::row_t _row2, spreadsheet::col_t _col2, size_t _xf_index);
+    };
+
+    typedef std::vector<format_range> format_ranges_type;
+
     ods_content_xml_context(session_context& session_cxt, const tokens& tokens, spreadsheet::iface::import_factory* factory);
     virtual ~ods_content_xml_context();
 
@@ -95,21 +114,45 @@ private:
     void start_cell(const xml_attrs_t& attrs);
     void end_cell();
 
+    bool has_cell_value() const;
     void push_cell_value();
 
+    /**
+     * Set the value of the current cell to all cells between it and the
+     * specified bottom-right corner.
+     */
+    void push_cell_value_range(spreadsheet::row_t row_last, spreadsheet::col_t col_last);
+
+    /**
+     * Pass the format ranges to the current sheet, and empty the container.
+     */
+    void flush_formats(format_ranges_type& formats);
+
 private:
     spreadsheet::iface::import_factory* mp_factory;
     std::vector<spreadsheet::iface::import_sheet*> m_tables;
+    sheet_row_buffer m_row_buffer; /// collects the value cells of the current row.
 
     boost::scoped_ptr<xml_context_base> mp_child;
 
     row_attr    m_row_attr;
     cell_attr   m_cell_attr;
 
+    date_time_t m_origin_date; /// null date, which date cells are relative to.
+
     int m_row;
     int m_col;
     size_t m_para_index;
     bool m_has_content;
+    bool m_row_has_value; /// whether any cell of the current row has a value.
+
+    format_ranges_type m_row_formats; /// formats of the current row, when it is repeated.
+
+    /**
+     * Formats of repeated rows without any values, held until a later row
+     * with values shows that they are not past the end of the data.
+     */
+    format_ranges_type m_pending_formats;
 
     odf_styles_map_type m_styles; /// map storing all automatic styles by their names.
     name2id_type m_cell_format_map; /// map of style names to cell format (xf) IDs.
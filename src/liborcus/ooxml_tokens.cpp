@@ -41,8 +41,8 @@ namespace opc {
 
 }
 
-tokens ooxml_tokens = tokens(ooxml::token_names, ooxml::token_name_count);
+tokens ooxml_tokens = tokens(ooxml::token_names, ooxml::token_name_count, ooxml::token_hash);
 
-tokens opc_tokens = tokens(opc::token_names, opc::token_name_count);
+tokens opc_tokens = tokens(opc::token_names, opc::token_name_count, opc::token_hash);
 
 }
@@ -3520,3 +3520,563 @@ const char* token_names[] = {
 
 size_t token_name_count = 3515;
 
+const unsigned int token_hash_displacements[] = {
+    35, 0, 61, 4, 239, 9, 8, 66,
+    36, 5, 10, 83, 0, 89, 0, 38,
+    104, 68, 1, 0, 1, 38, 11, 0,
+    10, 58, 56, 6, 2, 276, 11, 21,
+    1, 1, 4, 9, 0, 129, 5, 66,
+    21, 105, 111, 8, 2, 9, 27, 0,
+    3, 2, 52, 27, 3, 19, 101, 221,
+    26, 147, 0, 36, 147, 5, 7, 10,
+    65, 7, 14, 0, 0, 25, 5, 32,
+    0, 125, 7, 1, 5, 39, 6, 433,
+    188, 10, 14, 652, 59, 80, 44, 15,
+    262, 4, 0, 0, 70, 59, 15, 72,
+    91, 29, 7, 84, 10, 0, 4, 114,
+    437, 69, 19, 0, 4, 101, 247, 7,
+    1, 5, 47, 9, 353, 220, 41, 2,
+    27, 115, 107, 5, 6, 27, 100, 74,
+    15, 18, 161, 17, 0, 29, 4, 18,
+    53, 1, 16, 4, 2, 38, 264, 21,
+    0, 0, 1, 1, 214, 4, 5, 37,
+    18, 37, 183, 121, 0, 9, 49, 15,
+    21, 0, 6, 3, 951, 4, 2, 1,
+    20, 1, 20, 14, 84, 83, 30, 177,
+    1, 8, 3, 75, 18, 124, 367, 153,
+    32, 14, 18, 1, 21, 7, 22, 7,
+    0, 67, 624, 75, 0, 74, 17, 17,
+    31, 119, 35, 8, 138, 5, 0, 24,
+    7, 20, 0, 2, 0, 66, 1, 95,
+    27, 37, 2, 14, 52, 62, 6, 0,
+    1, 1, 59, 116, 59, 2, 12, 27,
+    11, 196, 1, 255, 13, 199, 0, 352,
+    132, 0, 13, 16, 19, 66, 0, 1,
+    4, 10, 38, 183, 473, 17, 22, 7,
+    57, 77, 6, 0, 29, 294, 107, 6,
+    56, 38, 147, 17, 29, 4, 10, 171,
+    476, 605, 31, 0, 290, 12, 120, 3,
+    524, 63, 1, 3, 45, 27, 127, 0,
+    10, 197, 57, 4, 4, 25, 368, 33,
+    24, 9, 1, 13, 5, 83, 0, 64,
+    0, 106, 32, 9, 106, 4, 2, 8,
+    59, 149, 4, 165, 0, 44, 337, 115,
+    13, 0, 110, 83, 5, 85, 260, 83,
+    3, 461, 4, 36, 54, 41, 3, 1,
+    0, 152, 12, 7, 2, 98, 307, 56,
+    93, 62, 0, 114, 91, 64, 110, 19,
+    5, 16, 18, 1, 56, 2, 176, 40,
+    40, 228, 18, 36, 0, 2, 3, 11,
+    70, 154, 25, 133, 10, 0, 6, 189,
+    9, 0, 373, 102, 275, 37, 34, 0,
+    124, 321, 1114, 150, 0, 26, 0, 12,
+    40, 169, 527, 82, 19, 39, 117, 52,
+    156, 134, 85, 1, 282, 381, 47, 32,
+    0, 35, 38, 17, 560, 28, 55, 161,
+    11, 27, 18, 9, 0, 430, 0, 5,
+    96, 147, 106, 0, 2, 126, 2, 305,
+    8, 432, 0, 4, 1, 25, 30, 0,
+    16, 2, 0, 3, 6, 80, 284, 10,
+    103, 53, 171, 116, 11, 30, 142, 0,
+    107, 194, 59, 101, 2, 49, 276, 10,
+    5, 1, 10, 4, 4, 174, 38, 44,
+    100, 35, 1, 0, 8, 3, 23, 131,
+    144, 64, 107, 4, 369, 0, 25, 1,
+    280, 2, 65, 351, 670, 0, 7, 73,
+    54, 1, 703, 146, 84, 28, 5, 0,
+    54, 71, 27, 27, 20, 53, 180, 140,
+    2, 22, 273, 35, 29, 372, 0, 0,
+    6, 155, 0, 140, 6, 64, 3, 208,
+    377, 0, 3, 7, 1, 181, 34, 20,
+    215, 0, 12, 32, 27, 13, 28, 0,
+    680, 452, 7, 180, 23, 957, 420, 83,
+    156, 43, 67, 25, 178, 30, 81, 0,
+    1, 14, 0, 287, 72, 2, 92, 565,
+    59, 8, 8, 115, 16, 28, 71, 34,
+    278, 66, 158, 6, 2, 4, 3, 159,
+    646, 0, 34, 277, 6, 239, 0, 121,
+    10, 85, 1000, 104, 9, 8, 1231, 104,
+    137, 1078, 2, 295, 385, 176, 400, 130,
+    42, 31, 16, 48, 4, 1, 69, 65,
+    48, 26, 80, 3, 32, 14, 128, 4,
+    234, 0, 0, 290, 183, 15, 99, 177,
+    584, 737, 111, 21, 323, 60, 1173, 13,
+    411, 154, 0, 1400, 5, 675, 3, 184,
+    1, 186, 74, 23, 9, 12, 302, 5,
+    242, 0, 1450, 42, 2, 405, 0, 9,
+    512, 18, 0, 20, 195, 123, 572, 7,
+    89, 301, 45, 16, 220, 1261, 147, 309,
+    2763, 10, 655, 1455, 2, 106, 821, 41,
+    12, 546, 841, 27, 203, 564, 282, 64,
+    3, 0, 2, 17, 71, 57, 34, 21,
+    211, 372, 9, 995, 215, 84, 791, 405,
+    799, 178, 1, 36, 0, 330, 706, 95,
+    0, 1, 47, 19, 358, 51, 352, 77,
+    1535, 610, 182, 14, 770, 0, 69, 101,
+    5, 1351, 2187, 167, 108, 115, 1312, 121,
+    0, 0, 844, 1387, 24, 7, 23, 37,
+    20, 6, 41, 955, 83, 509, 13, 54,
+    489, 147, 70, 48, 82, 9, 68, 927,
+    6, 6, 701, 127, 53, 115, 2195, 80,
+    693, 18, 12, 0, 384, 330, 16, 72,
+    80, 614, 1066, 46, 72, 198, 90, 6,
+    16, 6, 67, 376, 47, 765, 10, 1,
+    12, 414, 314, 704, 1175, 14, 6, 579,
+    62, 583, 843, 1967, 4482, 1444, 66, 378,
+    17, 289, 174, 22, 326, 174, 44, 2106,
+    30, 584, 2149, 55, 72, 620, 0, 1472,
+    597, 11, 78, 0, 2, 0, 3601, 5270,
+    156, 690, 2, 724, 2058, 2953, 228, 568,
+    624, 10, 439, 282, 2, 1, 26, 1459,
+    131, 220, 421, 3897, 23, 1620, 625, 1255,
+    5, 0, 43, 52, 84, 2, 10314, 1155,
+    32, 330, 6554, 465, 29, 948, 8,
+};
+
+const xml_token_t token_hash_slots[] = {
+    445, 2049, 2131, 424, 30, 1706, 716, 2455,
+    1608, 929, 894, 2769, 109, 2627, 597, 2416,
+    3498, 1773, 3069, 2836, 2475, 3283, 1042, 1186,
+    2320, 877, 2666, 3367, 2776, 2489, 2616, 365,
+    2895, 507, 2356, 3060, 1720, 1400, 1010, 2551,
+    3449, 448, 2703, 383, 2552, 2423, 1308, 461,
+    350, 3279, 2862, 2414, 1277, 2180, 587, 1531,
+    3015, 1123, 2263, 2580, 1015, 314, 244, 1106,
+    1858, 809, 1170, 3429, 272, 968, 2785, 1163,
+    1079, 3510, 2211, 817, 287, 505, 557, 2364,
+    3334, 1934, 496, 761, 1201, 1004, 3089, 2188,
+    1547, 3048, 812, 1955, 3460, 11, 1703, 3428,
+    1281, 3492, 2878, 3362, 941, 824, 1249, 1425,
+    1111, 2762, 2712, 135, 588, 3298, 3193, 3384,
+    86, 2355, 1272, 1707, 472, 1352, 1300, 1632,
+    1752, 71, 3370, 3053, 143, 2026, 1697, 2243,
+    735, 2741, 2697, 2123, 2964, 403, 1931, 164,
+    480, 473, 2350, 2919, 3306, 982, 1441, 637,
+    3118, 1881, 1926, 2948, 1491, 2252, 2410, 1946,
+    510, 2408, 2528, 3254, 3441, 1390, 878, 1995,
+    319, 1696, 65, 2458, 1161, 2083, 1159, 915,
+    997, 1293, 2076, 1045, 3447, 1024, 9, 3070,
+    579, 1545, 2824, 453, 2270, 273, 1095, 364,
+    2829, 562, 1928, 1996, 3168, 2533, 1694, 206,
+    450, 546, 1661, 487, 2826, 1330, 292, 2672,
+    376, 3236, 2802, 831, 1307, 3258, 1328, 612,
+    993, 3294, 2761, 1967, 671, 3402, 2153, 1391,
+    2346, 2956, 2139, 256, 1001, 406, 638, 2877,
+    2074, 1297, 1994, 1257, 1082, 2614, 925, 1988,
+    1843, 1437, 307, 2138, 698, 974, 2370, 2898,
+    2162, 1292, 2598, 1173, 1057, 886, 2359, 405,
+    3369, 895, 3264, 2905, 749, 528, 2848, 1317,
+    3062, 1460, 3288, 1758, 2319, 2365, 630, 2111,
+    1680, 748, 7, 1021, 1503, 2189, 2265, 2632,
+    695, 648, 87, 1516, 2972, 331, 2893, 2671,
+    1240, 2174, 2170, 555, 1566, 3198, 294, 161,
+    36, 2206, 1634, 1644, 1982, 1744, 130, 1730,
+    2822, 2039, 1677, 485, 362, 957, 3027, 2069,
+    2843, 1087, 27, 3088, 1652, 334, 1653, 1376,
+    1564, 1434, 1392, 538, 914, 924, 944, 2506,
+    867, 1331, 1377, 1925, 2831, 2091, 1183, 2293,
+    170, 2078, 1234, 3072, 1854, 567, 3260, 2264,
+    1616, 755, 2126, 2130, 2983, 2652, 1228, 1573,
+    68, 2915, 1242, 711, 2230, 2227, 2809, 1787,
+    909, 2950, 3244, 1511, 1788, 1708, 3246, 605,
+    311, 611, 834, 2581, 2019, 581, 2788, 2192,
+    1169, 3392, 1822, 2296, 799, 2456, 2638, 1316,
+    820, 2213, 2453, 2939, 3167, 2337, 1636, 2691,
+    351, 3479, 3317, 2502, 1187, 2651, 2637, 718,
+    1389, 313, 3201, 561, 2868, 2428, 2924, 1850,
+    2262, 1415, 776, 3083, 2746, 293, 2626, 225,
+    191, 1497, 1136, 2234, 807, 988, 3434, 2787,
+    117, 1745, 2137, 2409, 296, 794, 2911, 221,
+    2901, 2897, 559, 2400, 789, 3218, 423, 1466,
+    2169, 2650, 1530, 680, 2571, 1411, 1563, 2849,
+    3353, 3399, 1774, 907, 1294, 2747, 1870, 1582,
+    1945, 3091, 2034, 2735, 920, 2466, 1302, 1710,
+    3365, 1992, 3344, 1687, 2202, 1950, 934, 668,
+    1796, 2765, 2718, 2702, 234, 946, 1525, 2603,
+    803, 633, 692, 1127, 1167, 2088, 2993, 1705,
+    1505, 2166, 3142, 1212, 126, 2867, 1483, 1289,
+    2675, 1139, 2850, 850, 1117, 1688, 2281, 1966,
+    2145, 3130, 493, 283, 2567, 3239, 2419, 1798,
+    1715, 545, 1969, 1258, 2834, 958, 1428, 1374,
+    1747, 2961, 2900, 1791, 1205, 3514, 2745, 602,
+    1369, 2110, 260, 1314, 3375, 2882, 457, 2108,
+    1865, 1157, 2490, 92, 1385, 2705, 1255, 339,
+    2707, 2482, 1721, 1947, 3414, 3006, 1722, 533,
+    2887, 1338, 2770, 1436, 2077, 2617, 1081, 1738,
+    2487, 357, 1561, 972, 132, 2477, 3150, 1223,
+    318, 58, 2276, 2329, 1022, 1718, 308, 328,
+    1386, 2158, 1713, 1782, 571, 733, 2504, 1948,
+    2066, 214, 552, 1513, 240, 634, 1185, 3208,
+    449, 2297, 1175, 2513, 1046, 3422, 2883, 1016,
+    3099, 436, 3304, 1132, 2470, 2634, 1689, 97,
+    843, 1231, 2693, 1780, 2232, 2754, 1591, 582,
+    1535, 3034, 491, 1418, 1664, 1734, 679, 3274,
+    744, 2680, 1088, 216, 3487, 2771, 594, 2920,
+    2216, 2161, 1639, 2608, 3197, 598, 1760, 2431,
+    2619, 408, 1624, 2065, 1709, 389, 2658, 2909,
+    1116, 1637, 1810, 3108, 1197, 520, 1878, 1150,
+    290, 54, 3085, 855, 3155, 1901, 2168, 2182,
+    1427, 2864, 3041, 1519, 2451, 3146, 1053, 3401,
+    2537, 465, 712, 2148, 72, 3330, 1260, 2488,
+    1986, 348, 2164, 746, 2724, 2953, 1470, 2387,
+    2998, 2030, 2381, 2534, 1172, 2512, 2810, 3175,
+    918, 1571, 190, 197, 887, 2951, 1599, 1529,
+    589, 120, 1856, 2259, 738, 360, 1952, 2190,
+    31, 232, 784, 754, 2752, 2701, 2828, 2401,
+    2784, 3440, 2880, 2544, 2921, 1783, 6, 1447,
+    2497, 281, 1704, 3466, 973, 1786, 2853, 1220,
+    3318, 2204, 2187, 676, 1808, 873, 3028, 2560,
+    3100, 2445, 2052, 651, 1126, 295, 394, 1407,
+    3217, 2755, 1245, 3044, 2149, 573, 2154, 2648,
+    956, 490, 1635, 1168, 324, 2653, 1839, 752,
+    5, 1496, 969, 285, 1954, 2916, 2587, 2723,
+    1327, 1867, 583, 1092, 3224, 1836, 2694, 3035,
+    2952, 1898, 2841, 1673, 481, 1360, 607, 1605,
+    995, 3216, 1860, 938, 837, 1114, 1093, 1542,
+    2806, 2664, 2054, 1477, 686, 2758, 1712, 1888,
+    3159, 970, 844, 1493, 2122, 1054, 3259, 845,
+    41, 881, 1690, 2607, 3190, 3319, 3261, 1932,
+    288, 3086, 459, 1581, 2384, 2685, 2219, 672,
+    1286, 497, 2980, 3300, 48, 1882, 1104, 1980,
+    2946, 502, 3241, 1365, 1686, 61, 326, 1585,
+    17, 2336, 1259, 1135, 3481, 3490, 1817, 2079,
+    2185, 168, 2825, 3000, 3194, 1691, 1862, 2768,
+    2670, 2995, 2217, 1883, 1572, 2275, 998, 1751,
+    1048, 662, 2302, 2990, 994, 452, 2279, 1784,
+    1085, 1965, 1224, 1055, 430, 3495, 2805, 584,
+    340, 1011, 386, 1036, 1601, 1402, 537, 3251,
+    1711, 1951, 960, 3511, 2931, 1083, 419, 1501,
+    476, 1762, 3073, 2622, 1802, 1521, 2179, 2679,
+    854, 2521, 3247, 1826, 1343, 233, 2081, 299,
+    806, 1060, 1570, 1238, 1229, 2267, 377, 3499,
+    3345, 111, 1606, 916, 1893, 467, 2086, 70,
+    2070, 856, 2303, 171, 3092, 3094, 372, 2020,
+    422, 2987, 2053, 1524, 1476, 2178, 2002, 1322,
+    901, 3116, 257, 3141, 3350, 451, 1515, 3385,
+    931, 2383, 710, 517, 163, 3418, 1394, 1823,
+    116, 2127, 1149, 1072, 3257, 1154, 564, 675,
+    689, 228, 3307, 3056, 1412, 3081, 2979, 665,
+    1935, 1509, 2640, 1326, 2089, 661, 656, 2530,
+    2654, 550, 2744, 3010, 1804, 3052, 3102, 88,
+    3227, 139, 1906, 2260, 429, 3273, 3388, 1665,
+    2332, 2197, 829, 1119, 2988, 2526, 391, 1262,
+    368, 1480, 2449, 2721, 67, 1355, 1329, 2295,
+    464, 2484, 623, 246, 2641, 1770, 3391, 3448,
+    1284, 1887, 1962, 3046, 3476, 3002, 2917, 720,
+    2700, 1562, 2116, 2244, 3456, 110, 1438, 657,
+    1064, 2071, 1897, 460, 2688, 2251, 1763, 1929,
+    2307, 494, 2797, 1892, 1456, 374, 2781, 1341,
+    1287, 1143, 1679, 2748, 2525, 898, 876, 518,
+    3082, 2015, 2965, 1078, 3284, 2940, 2971, 2239,
+    2540, 3346, 1666, 3329, 1997, 1432, 2317, 1916,
+    730, 1853, 264, 954, 1378, 3413, 2058, 226,
+    193, 474, 1833, 795, 1138, 2815, 1540, 939,
+    1162, 2649, 1678, 2223, 106, 2975, 124, 1975,
+    2728, 2663, 2942, 566, 224, 239, 1120, 2677,
+    395, 2385, 2237, 1080, 312, 2394, 519, 2392,
+    201, 1074, 1133, 2405, 1315, 2172, 2772, 1510,
+    1723, 3240, 2395, 1919, 2140, 418, 1244, 1156,
+    2082, 3376, 1204, 3170, 3437, 2590, 3296, 801,
+    2690, 3446, 2107, 2531, 618, 2330, 2027, 1886,
+    349, 514, 3182, 2468, 1325, 317, 1061, 1058,
+    1006, 921, 2855, 3390, 2635, 1409, 3172, 705,
+    355, 2348, 1904, 2636, 2092, 620, 2818, 94,
+    3219, 84, 2757, 3020, 678, 800, 1280, 1310,
+    417, 93, 1342, 769, 439, 2553, 1271, 330,
+    437, 2186, 2876, 2573, 2886, 212, 2491, 1695,
+    955, 3103, 694, 857, 1795, 2085, 3393, 3166,
+    2872, 1354, 1520, 1567, 942, 1611, 1211, 3419,
+    1911, 1184, 160, 3211, 2774, 1344, 642, 145,
+    1754, 1217, 157, 1005, 3137, 1440, 2021, 3138,
+    913, 1625, 2176, 1596, 1320, 1583, 2316, 1863,
+    2716, 3110, 1461, 1889, 1781, 69, 586, 2041,
+    3263, 3123, 46, 3509, 1059, 1699, 204, 1633,
+    3474, 2759, 1724, 3120, 2874, 1908, 2852, 732,
+    3119, 2417, 1401, 3125, 341, 967, 953, 1371,
+    2342, 3231, 337, 2820, 2930, 3320, 858, 2727,
+    2240, 2278, 274, 306, 1429, 26, 792, 500,
+    1097, 785, 1098, 1364, 2558, 59, 413, 2480,
+    2242, 2011, 1383, 3127, 1612, 2014, 3325, 1811,
+    1494, 2322, 1416, 33, 576, 1443, 3087, 2354,
+    56, 2986, 701, 2624, 725, 3013, 3214, 1685,
+    1523, 2196, 1256, 1569, 853, 1252, 428, 1091,
+    1647, 1410, 261, 1662, 1239, 1999, 1037, 1026,
+    2386, 2856, 2150, 2102, 3453, 540, 2224, 1248,
+    2198, 3209, 2321, 152, 615, 3160, 329, 1693,
+    2291, 677, 1472, 3431, 2816, 13, 504, 2644,
+    1971, 2706, 3031, 3163, 739, 2729, 3433, 1027,
+    1446, 1490, 1830, 1586, 2927, 1457, 2443, 2304,
+    2287, 2678, 1387, 2689, 962, 778, 836, 1473,
+    3012, 2248, 2277, 2132, 2040, 1131, 1603, 2708,
+    1936, 3483, 2866, 2312, 2060, 1486, 1927, 2566,
+    2347, 2631, 1215, 103, 1003, 635, 2592, 74,
+    415, 279, 1417, 1155, 1337, 1761, 2467, 773,
+    1589, 2235, 2969, 2327, 2144, 1230, 1023, 2493,
+    396, 2031, 1130, 1321, 1152, 3381, 2896, 1039,
+    1824, 1576, 2119, 1920, 2734, 3328, 509, 1859,
+    2881, 2692, 1514, 707, 2222, 2859, 2997, 1452,
+    3372, 1063, 2294, 3486, 3303, 2411, 2507, 2483,
+    2334, 1778, 1166, 1628, 1844, 3058, 669, 3501,
+    2057, 3322, 2064, 1305, 2938, 503, 3238, 3148,
+    2310, 2854, 335, 3140, 774, 186, 1049, 303,
+    1990, 2505, 2726, 1983, 899, 315, 1502, 2668,
+    654, 847, 3500, 987, 1424, 591, 1574, 3126,
+    3165, 230, 3421, 1357, 217, 2508, 57, 2500,
+    2438, 3457, 3183, 2851, 3485, 1991, 619, 1413,
+    1379, 2118, 3077, 1498, 892, 683, 575, 777,
+    3162, 2460, 685, 2597, 3287, 2450, 3074, 1849,
+    959, 3397, 1630, 3425, 3364, 2775, 200, 3380,
+    2109, 868, 627, 3315, 1422, 3253, 693, 1047,
+    2892, 2344, 3461, 1643, 2767, 2844, 482, 3454,
+    2494, 626, 1842, 2510, 2538, 966, 1453, 890,
+    1489, 21, 2412, 608, 2586, 984, 2374, 1944,
+    2338, 1835, 371, 884, 2660, 1876, 2357, 788,
+    3504, 1295, 2471, 1598, 2720, 1825, 3156, 3032,
+    2038, 1225, 1737, 1642, 652, 3237, 468, 821,
+    697, 609, 1246, 2361, 3158, 366, 1793, 2094,
+    2958, 945, 3438, 1113, 838, 2962, 551, 1772,
+    1838, 2604, 1099, 723, 753, 862, 1144, 3132,
+    1158, 585, 2846, 2823, 2478, 1469, 3021, 1370,
+    932, 3321, 879, 541, 1648, 2783, 270, 2424,
+    1593, 142, 3505, 767, 2434, 2585, 2501, 3043,
+    79, 2254, 3265, 1464, 3177, 1267, 3112, 726,
+    2719, 2977, 1243, 3022, 1414, 1797, 3107, 1512,
+    2341, 617, 3424, 2072, 2609, 3278, 1676, 2522,
+    1568, 760, 3468, 3267, 2914, 632, 1336, 486,
+    3513, 2740, 2610, 536, 3016, 2333, 2097, 1622,
+    2516, 1191, 1645, 1233, 263, 1214, 363, 842,
+    2923, 2780, 2103, 185, 2695, 194, 2328, 3215,
+    3286, 1142, 3467, 1089, 990, 986, 1518, 2778,
+    2842, 2256, 3050, 592, 2269, 2684, 600, 889,
+    1345, 1332, 2461, 3282, 521, 1534, 3066, 1543,
+    1263, 478, 574, 2800, 1056, 1987, 782, 2113,
+    639, 1038, 2978, 466, 2001, 2665, 3502, 3289,
+    446, 3276, 1533, 653, 2819, 814, 1953, 2669,
+    2379, 3199, 2171, 25, 1431, 107, 2803, 104,
+    1035, 1682, 1213, 1803, 690, 165, 1716, 2193,
+    3229, 1915, 2441, 8, 1672, 3171, 734, 655,
+    1857, 91, 2888, 344, 1118, 2151, 1974, 613,
+    3096, 1013, 2280, 658, 358, 864, 880, 158,
+    2713, 3124, 2121, 3471, 2791, 983, 569, 1626,
+    2191, 2655, 2464, 2448, 1319, 2832, 3024, 63,
+    354, 1454, 793, 441, 535, 2397, 912, 1756,
+    647, 333, 947, 3506, 3443, 1939, 125, 1894,
+    3025, 1538, 2008, 2985, 1279, 1124, 45, 1930,
+    682, 2100, 3067, 1941, 1071, 1638, 2496, 2620,
+    1134, 2299, 765, 320, 180, 2830, 846, 1613,
+    3054, 1353, 1151, 3352, 1384, 3351, 416, 508,
+    3109, 192, 78, 98, 825, 1651, 688, 18,
+    2371, 147, 1278, 12, 3097, 3033, 3153, 3045,
+    1282, 1821, 3427, 2659, 2520, 593, 484, 404,
+    1834, 401, 1160, 3200, 759, 454, 1731, 3115,
+    2550, 2682, 2084, 779, 590, 3293, 3189, 2717,
+    1528, 1025, 2873, 304, 411, 183, 3281, 2393,
+    297, 859, 1657, 3323, 1818, 1301, 1247, 2120,
+    923, 2524, 2827, 1764, 3059, 388, 1273, 3017,
+    215, 85, 1742, 2167, 2563, 2982, 3271, 979,
+    1769, 1594, 1852, 1776, 2050, 1765, 2643, 2527,
+    3363, 2945, 2807, 3409, 1877, 822, 556, 3026,
+    1261, 1101, 189, 1102, 2739, 1729, 3009, 2600,
+    2093, 2687, 3396, 1219, 2231, 1100, 631, 3462,
+    2228, 2673, 2582, 1227, 1650, 1654, 3255, 756,
+    1668, 1399, 1785, 1746, 2606, 387, 3252, 3313,
+    150, 863, 702, 2933, 1864, 248, 3256, 1759,
+    259, 524, 434, 55, 750, 3047, 2059, 2994,
+    3473, 2436, 23, 3030, 2306, 2577, 2255, 1753,
+    3326, 1462, 1421, 1366, 1463, 2315, 2793, 390,
+    1917, 427, 1655, 3340, 841, 1296, 2245, 2751,
+    2492, 2536, 3049, 2889, 2910, 2272, 1408, 719,
+    851, 15, 2006, 3098, 1799, 146, 2532, 2811,
+    2184, 289, 553, 381, 2954, 1096, 827, 717,
+    1040, 2955, 2583, 2212, 367, 2799, 1827, 554,
+    3455, 2022, 3508, 2288, 936, 3430, 195, 2645,
+    2623, 3491, 1792, 2112, 976, 2068, 3312, 1702,
+    2024, 896, 1030, 3297, 3023, 3262, 1532, 1388,
+    2345, 28, 1274, 198, 870, 2981, 783, 3187,
+    3342, 2903, 400, 2519, 1741, 3442, 1174, 1276,
+    1602, 410, 498, 515, 649, 286, 2593, 3459,
+    604, 1202, 2935, 3332, 3291, 1165, 2399, 2099,
+    1861, 908, 2032, 802, 121, 2047, 624, 3389,
+    840, 1768, 2821, 2639, 173, 1592, 2743, 823,
+    2657, 100, 2407, 787, 3512, 1499, 1033, 1614,
+    2871, 3185, 2331, 1112, 32, 1527, 128, 3176,
+    2462, 2869, 1029, 1819, 3106, 3496, 119, 2080,
+    138, 2742, 40, 1961, 2554, 1829, 2457, 1115,
+    2907, 666, 1090, 1306, 2711, 3136, 2028, 833,
+    1009, 231, 965, 640, 1313, 115, 819, 1828,
+    2339, 1924, 3360, 1373, 1232, 2732, 1250, 513,
+    266, 2061, 499, 2043, 2966, 1000, 2529, 2257,
+    2396, 166, 414, 1565, 1801, 3223, 2442, 1981,
+    1732, 149, 3131, 3410, 112, 2561, 1044, 1109,
+    2996, 3145, 2444, 1449, 2967, 1779, 3336, 151,
+    2425, 3003, 3122, 435, 2498, 3270, 1820, 828,
+    2136, 902, 1658, 2363, 743, 2420, 258, 935,
+    2756, 2559, 758, 1077, 101, 3268, 2238, 1179,
+    133, 1869, 2486, 3465, 1193, 1014, 1395, 20,
+    715, 1309, 3299, 236, 167, 1847, 300, 76,
+    2569, 1749, 35, 64, 861, 2429, 323, 1403,
+    412, 1140, 3014, 2128, 2181, 1832, 3423, 24,
+    981, 3436, 952, 1629, 2289, 893, 2366, 2004,
+    2440, 420, 175, 883, 1129, 421, 3057, 1736,
+    1478, 2351, 153, 3188, 154, 1684, 1340, 488,
+    971, 1444, 3018, 1, 2760, 1299, 2373, 3222,
+    1028, 1070, 2305, 1740, 1923, 134, 3472, 2292,
+    2063, 544, 3179, 3366, 3080, 1575, 2605, 1866,
+    3133, 1580, 475, 3184, 3403, 2789, 1933, 2863,
+    2661, 1874, 646, 1346, 1875, 2835, 2249, 1180,
+    52, 904, 2764, 181, 2817, 2367, 664, 1537,
+    3169, 298, 483, 2360, 1467, 3335, 727, 356,
+    2000, 3173, 1840, 3210, 2195, 3196, 2891, 1146,
+    316, 3063, 2200, 1579, 1251, 2472, 543, 1610,
+    2157, 3398, 2906, 1062, 1909, 369, 1500, 2861,
+    2913, 660, 209, 888, 1393, 2463, 1488, 352,
+    606, 980, 910, 1311, 81, 3139, 1536, 3301,
+    156, 2647, 2515, 3310, 2051, 2003, 1043, 3400,
+    1910, 848, 1855, 3302, 2012, 2372, 310, 1620,
+    713, 1147, 790, 1623, 3480, 1145, 1755, 407,
+    409, 927, 2314, 512, 1541, 2984, 1831, 2885,
+    380, 3071, 3051, 911, 3373, 1222, 747, 2369,
+    1442, 2165, 2283, 2949, 2324, 2218, 1588, 1735,
+    3450, 1188, 1728, 1663, 2226, 786, 1298, 625,
+    3121, 2591, 1485, 2929, 1972, 1361, 1084, 182,
+    3250, 3343, 1748, 3144, 2430, 2674, 2301, 3212,
+    3417, 2902, 210, 641, 940, 1176, 2233, 1956,
+    207, 1621, 3266, 781, 933, 3359, 1681, 174,
+    1032, 2838, 1727, 1667, 885, 2481, 3104, 951,
+    762, 2753, 440, 3037, 2415, 208, 577, 3280,
+    1177, 2382, 438, 1757, 2974, 2808, 1200, 1615,
+    123, 1631, 1719, 1800, 3111, 332, 1375, 1922,
+    3084, 1235, 775, 2422, 3233, 770, 1618, 650,
+    2215, 977, 140, 999, 47, 741, 44, 2353,
+    964, 2941, 2840, 709, 2005, 742, 736, 2908,
+    2912, 1976, 3420, 1266, 2796, 2547, 522, 1660,
+    1194, 38, 815, 60, 49, 3357, 2595, 1940,
+    667, 1675, 3464, 2474, 830, 1912, 2427, 1584,
+    1068, 2904, 1554, 2601, 402, 548, 926, 2352,
+    2612, 1435, 572, 2029, 95, 3348, 2025, 309,
+    2899, 1998, 3406, 3129, 2135, 2698, 2313, 42,
+    1380, 1253, 1192, 3356, 2391, 874, 2628, 1208,
+    178, 2311, 137, 269, 2143, 1406, 2786, 1362,
+    2377, 267, 1236, 3203, 2555, 3192, 1905, 578,
+    2934, 2686, 3180, 203, 3090, 3040, 2922, 2134,
+    1190, 2749, 1959, 963, 2611, 118, 2433, 10,
+    2096, 1283, 706, 3295, 1304, 961, 1105, 34,
+    3484, 949, 2589, 2208, 1396, 1065, 917, 768,
+    1890, 2465, 2928, 77, 3383, 3079, 2947, 322,
+    2546, 1069, 1269, 3004, 3272, 3206, 144, 722,
+    3161, 29, 1334, 1471, 1546, 51, 477, 1739,
+    1884, 3249, 2325, 1841, 243, 2286, 3458, 384,
+    1458, 3493, 745, 2326, 1539, 2095, 1465, 985,
+    447, 176, 1879, 162, 1848, 900, 75, 1275,
+    525, 188, 3, 2246, 172, 1960, 2380, 1405,
+    2495, 492, 1221, 568, 1590, 2646, 1508, 2398,
+    816, 155, 1182, 2925, 3039, 3038, 2017, 3164,
+    869, 1107, 1587, 2642, 3068, 1484, 254, 382,
+    1203, 3394, 1367, 229, 1556, 2709, 2575, 321,
+    681, 2541, 3395, 113, 3005, 1050, 3475, 2037,
+    560, 2801, 3408, 1968, 2992, 479, 353, 547,
+    2773, 3234, 22, 2730, 860, 2736, 757, 3494,
+    992, 325, 1526, 1646, 808, 327, 1290, 2403,
+    3470, 2106, 673, 1270, 2446, 1487, 852, 2447,
+    361, 3432, 2473, 2545, 489, 1851, 2812, 2667,
+    2343, 2404, 871, 227, 1517, 1206, 1617, 1086,
+    1094, 3113, 3207, 2865, 2503, 4, 1868, 3205,
+    549, 3305, 849, 3482, 1359, 184, 291, 2160,
+    1181, 379, 2733, 1700, 1963, 2368, 891, 3065,
+    1110, 3507, 1914, 3405, 2205, 603, 1548, 2633,
+    1430, 1958, 2009, 3064, 2163, 2098, 1913, 797,
+    2432, 187, 2959, 455, 1291, 1209, 73, 2229,
+    398, 179, 3213, 1041, 2991, 1942, 3387, 996,
+    3411, 3358, 3230, 1351, 3269, 1312, 1051, 1339,
+    1595, 1775, 2335, 791, 2565, 284, 196, 3285,
+    3275, 813, 1814, 1873, 1439, 2042, 1726, 2290,
+    2105, 3497, 2696, 432, 1237, 1019, 277, 2574,
+    1979, 1216, 2175, 1122, 3379, 2737, 3374, 2209,
+    1692, 1356, 3151, 1397, 670, 511, 1137, 2173,
+    516, 1073, 2194, 1164, 3143, 2207, 2421, 211,
+    558, 643, 2201, 2349, 766, 2564, 2117, 3114,
+    3463, 1900, 1977, 3378, 3147, 235, 2890, 542,
+    122, 2584, 2699, 2710, 2210, 2833, 255, 703,
+    3277, 131, 90, 3135, 1957, 2731, 1189, 1506,
+    839, 1717, 928, 19, 2621, 2221, 265, 2389,
+    1701, 2485, 506, 1559, 2557, 2454, 469, 659,
+    826, 1196, 1195, 2225, 595, 2579, 375, 2268,
+    1398, 3349, 426, 2177, 2469, 252, 1468, 129,
+    1750, 169, 1363, 2016, 1067, 2499, 2087, 102,
+    2918, 1973, 66, 3186, 1125, 262, 37, 897,
+    2007, 1052, 3290, 80, 3338, 2236, 2722, 1816,
+    278, 1445, 1419, 343, 1241, 622, 3292, 3075,
+    302, 1034, 580, 3226, 1544, 3339, 3386, 3008,
+    663, 3488, 3248, 2129, 2214, 1938, 1268, 2479,
+    704, 2435, 3174, 2845, 222, 3195, 3435, 2013,
+    1903, 731, 385, 2067, 1455, 3157, 1141, 1347,
+    3001, 1777, 1921, 1993, 347, 3412, 1937, 919,
+    2309, 2714, 1767, 906, 2152, 1607, 3242, 526,
+    1604, 202, 989, 250, 1420, 674, 1448, 2798,
+    1148, 1348, 2406, 338, 1433, 3407, 2839, 2104,
+    1008, 1557, 3347, 3134, 1949, 2, 3178, 3245,
+    570, 3076, 3243, 1349, 1812, 242, 399, 3095,
+    2957, 2599, 3404, 1017, 3361, 53, 3444, 1766,
+    2517, 3416, 3007, 687, 1714, 3152, 2804, 1404,
+    2968, 3451, 628, 3309, 2715, 1846, 563, 645,
+    1479, 1552, 2375, 3445, 2045, 2418, 3331, 943,
+    1075, 3355, 2999, 346, 1381, 1121, 2960, 2795,
+    780, 433, 3368, 1459, 737, 2203, 14, 3220,
+    2662, 2439, 614, 2548, 237, 2183, 1560, 882,
+    1002, 2630, 247, 1007, 1918, 835, 1627, 2437,
+    2388, 2090, 3371, 456, 2147, 2376, 2358, 991,
+    3228, 1789, 2535, 1199, 397, 213, 2879, 99,
+    305, 3324, 1669, 2539, 1218, 223, 811, 3477,
+    1066, 443, 2056, 105, 2549, 865, 1372, 810,
+    930, 205, 3503, 1805, 1450, 2509, 2284, 696,
+    922, 2115, 3204, 1551, 1725, 1031, 1226, 3341,
+    708, 2142, 740, 1335, 1264, 1288, 2282, 2199,
+    565, 3093, 2476, 3105, 2390, 2220, 2241, 2298,
+    3415, 2300, 1555, 238, 978, 3232, 1907, 2578,
+    764, 1553, 431, 3011, 2511, 1318, 359, 1674,
+    3191, 872, 3154, 2035, 2562, 1790, 3055, 1550,
+    636, 1640, 3042, 629, 1350, 2681, 3337, 345,
+    2075, 1368, 2857, 1896, 937, 1899, 3149, 1619,
+    2318, 798, 2402, 1597, 220, 1880, 2556, 177,
+    1656, 1504, 2629, 495, 621, 691, 751, 2253,
+    3078, 2323, 699, 16, 2588, 3181, 832, 2937,
+    2837, 2413, 1698, 866, 1076, 1895, 721, 1210,
+    1128, 3311, 271, 728, 2101, 763, 1649, 1549,
+    1495, 82, 599, 2576, 245, 3019, 3354, 1964,
+    2782, 3469, 1324, 875, 3128, 127, 804, 2656,
+    1989, 1600, 3117, 1108, 1984, 3377, 3314, 3426,
+    1451, 159, 463, 1743, 1659, 948, 2362, 2048,
+    39, 2943, 2452, 282, 2794, 1871, 280, 2704,
+    2155, 373, 2932, 3202, 2247, 1807, 1020, 1683,
+    1474, 2250, 2763, 2258, 1978, 539, 2274, 796,
+    336, 2847, 2813, 89, 2518, 114, 1265, 43,
+    2514, 534, 1482, 1323, 471, 444, 2523, 393,
+    2973, 1475, 714, 148, 729, 1507, 2936, 616,
+    2340, 1671, 1809, 2044, 2542, 724, 2125, 2055,
+    425, 3316, 530, 684, 50, 1670, 2750, 2683,
+    1609, 2963, 2156, 96, 3382, 1103, 1303, 62,
+    1153, 818, 253, 2266, 700, 975, 1382, 2261,
+    3327, 1733, 2976, 2543, 219, 3235, 1771, 3225,
+    2018, 805, 2568, 2010, 1985, 3308, 2738, 771,
+    2033, 470, 2725, 1333, 2285, 1577, 2615, 458,
+    1171, 772, 3452, 1902, 2989, 251, 2926, 2273,
+    2570, 1522, 83, 523, 2023, 2970, 462, 1845,
+    644, 2426, 199, 392, 3061, 1426, 2602, 2625,
+    2596, 2073, 2779, 218, 1207, 527, 3101, 3439,
+    2124, 2792, 1794, 370, 3036, 2894, 3478, 1012,
+    2146, 2875, 2271, 241, 1285, 1018, 2790, 141,
+    1872, 903, 1198, 2944, 2459, 501, 1492, 275,
+    2858, 1481, 342, 2114, 2618, 905, 3489, 2766,
+    2613, 1943, 2159, 1358, 136, 1178, 950, 3029,
+    601, 1578, 2884, 3333, 2141, 2572, 1815, 1254,
+    1641, 268, 2036, 1813, 2133, 1837, 596, 276,
+    442, 108, 1891, 301, 2308, 1806, 1885, 249,
+    2777, 2046, 2378, 2062, 610, 532, 2870, 529,
+    2594, 531, 2814, 378, 1970, 1558, 2676, 2860,
+    1423, 3221,
+};
+
+const token_hash_table token_hash = {
+    token_hash_displacements, 879, token_hash_slots, 3514
+};
+
@@ -27,11 +27,14 @@
 
 #include "opc_reader.hpp"
 #include "xml_stream_parser.hpp"
+#include "zip_entry_stream.hpp"
 
 #include "ooxml_global.hpp"
 #include "opc_context.hpp"
 #include "ooxml_tokens.hpp"
 
+#include "orcus/import_trace.hpp"
+
 #include <iostream>
 #include <boost/scoped_ptr.hpp>
 
@@ -89,16 +92,21 @@ opc_reader::opc_reader(xmlns_repository& ns_repo, session_context& cxt, part_han
     m_ns_repo(ns_repo),
     m_session_cxt(cxt),
     m_handler(handler),
+    mp_trace(NULL),
     m_opc_rel_handler(new opc_relations_context(m_session_cxt, opc_tokens)) {}
 
 void opc_reader::read_file(const char* fpath)
 {
     cout << "reading " << fpath << endl;
 
-    m_archive_stream.reset(new zip_archive_stream_fd(fpath));
+    m_archive_stream.reset(new zip_archive_stream_mmap(fpath));
     m_archive.reset(new zip_archive(m_archive_stream.get()));
 
-    m_archive->load();
+    {
+        trace_scope scope(mp_trace, trace_phase_zip_read, fpath);
+        m_archive->load();
+        scope.set_bytes(m_archive_stream->size());
+    }
 
     m_dir_stack.push_back(string()); // push root directory.
 
@@ -111,7 +119,18 @@ void opc_reader::read_file(const char* fpath)
 
 bool opc_reader::open_zip_stream(const string& path, vector<unsigned char>& buf)
 {
-    return m_archive->read_file_entry(path.c_str(), buf);
+    trace_scope scope(mp_trace, trace_phase_inflate, path);
+    if (!m_archive->read_file_entry(path.c_str(), buf))
+        return false;
+
+    scope.set_bytes(buf.size());
+    return true;
+}
+
+bool opc_reader::open_zip_stream(const string& path, zip_entry_stream& strm)
+{
+    strm.set_trace(mp_trace);
+    return strm.open(*m_archive, path.c_str());
 }
 
 void opc_reader::read_part(const pstring& path, const schema_t type, const opc_rel_extra* data)
@@ -194,6 +213,11 @@ void opc_reader::check_relation_part(const std::string& file_name, const opc_rel
     for_each(rels.begin(), rels.end(), process_opc_rel(*this, extra));
 }
 
+void opc_reader::set_trace(import_trace* trace)
+{
+    mp_trace = trace;
+}
+
 void opc_reader::list_content() const
 {
     size_t num = m_archive->get_file_entry_count();
@@ -239,6 +263,7 @@ void opc_reader::read_content_types()
         return;
 
     xml_stream_parser parser(m_ns_repo, opc_tokens, reinterpret_cast<const char*>(&buffer[0]), buffer.size(), "[Content_Types].xml");
+    parser.set_trace(mp_trace);
     ::boost::scoped_ptr<xml_simple_stream_handler> handler(
         new xml_simple_stream_handler(new opc_content_types_context(m_session_cxt, opc_tokens)));
     parser.set_handler(handler.get());
@@ -263,6 +288,7 @@ void opc_reader::read_relations(const char* path, vector<opc_rel_t>& rels)
         return;
 
     xml_stream_parser parser(m_ns_repo, opc_tokens, reinterpret_cast<const char*>(&buffer[0]), buffer.size(), filepath);
+    parser.set_trace(mp_trace);
 
     opc_relations_context& context =
         static_cast<opc_relations_context&>(m_opc_rel_handler.get_context());
@@ -43,6 +43,8 @@
 namespace orcus {
 
 class xmlns_repository;
+class zip_entry_stream;
+class import_trace;
 struct session_context;
 struct opc_rel_extra;
 
@@ -84,6 +86,12 @@ public:
     void read_file(const char* fpath);
     bool open_zip_stream(const std::string& path, std::vector<unsigned char>& buf);
 
+    /**
+     * Open an xml part for progressive reading.  The part gets inflated
+     * while it is being parsed.
+     */
+    bool open_zip_stream(const std::string& path, zip_entry_stream& strm);
+
     /**
      * Read an xml part inside package.  The path is relative to the relation
      * file.
@@ -103,6 +111,13 @@ public:
      */
     void check_relation_part(const std::string& file_name, const opc_rel_extras_t* extras);
 
+    /**
+     * Set a trace to record the reading of the package and of its parts on.
+     *
+     * @param trace trace to record on, or NULL to record nothing.
+     */
+    void set_trace(import_trace* trace);
+
 private:
 
     void list_content() const;
@@ -116,6 +131,7 @@ private:
     xmlns_repository& m_ns_repo;
     session_context& m_session_cxt;
     part_handler& m_handler;
+    import_trace* mp_trace;
 
     boost::scoped_ptr<zip_archive> m_archive;
     boost::scoped_ptr<zip_archive_stream> m_archive_stream;
@@ -34,3 +34,18 @@ const char* token_names[] = {
 
 size_t token_name_count = 29;
 
+const unsigned int token_hash_displacements[] = {
+    1, 84, 308, 6, 43, 39, 32,
+};
+
+const xml_token_t token_hash_slots[] = {
+    7, 4, 17, 11, 8, 5, 14, 28,
+    20, 18, 26, 16, 15, 1, 25, 3,
+    21, 23, 22, 27, 24, 19, 2, 12,
+    13, 6, 10, 9,
+};
+
+const token_hash_table token_hash = {
+    token_hash_displacements, 7, token_hash_slots, 28
+};
+
@@ -31,10 +31,21 @@
 #include "orcus/pstring.hpp"
 #include "orcus/global.hpp"
 #include "orcus/stream.hpp"
+#include "orcus/string_pool.hpp"
+#include "orcus/import_trace.hpp"
+#include "orcus/measurement.hpp"
+#include "orcus/parser_global.hpp"
 #include "orcus/spreadsheet/import_interface.hpp"
 
+#include "traced_import_factory.hpp"
+#include "sheet_row_buffer.hpp"
+
 #include <cstring>
 #include <iostream>
+#include <vector>
+
+#include <boost/thread.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
 
 using namespace std;
 
@@ -48,8 +59,17 @@ public:
     csv_handler(spreadsheet::iface::import_factory& factory) :
         m_factory(factory), mp_sheet(NULL), m_row(0), m_col(0) {}
 
+    /**
+     * Constructor for continuing on a sheet that already has rows.
+     */
+    csv_handler(spreadsheet::iface::import_factory& factory, spreadsheet::iface::import_sheet* sheet, spreadsheet::row_t row) :
+        m_factory(factory), mp_sheet(sheet), m_row(row), m_col(0) {}
+
     void begin_parse()
     {
+        if (mp_sheet)
+            return;
+
         const char* sheet_name = "data";
         mp_sheet = m_factory.append_sheet(sheet_name, strlen(sheet_name));
     }
@@ -76,39 +96,394 @@ private:
     spreadsheet::col_t m_col;
 };
 
+/**
+ * Chunks smaller than this are not worth handing over to a worker thread.
+ */
+const size_t min_chunk_size = 64*1024;
+
+csv::parser_config get_parser_config()
+{
+    csv::parser_config config;
+    config.delimiters.push_back(',');
+    config.text_qualifier = '"';
+    return config;
+}
+
+void parse_rows(const char* content, size_t size, csv_handler& handler, import_trace* trace)
+{
+    trace_scope scope(trace, trace_phase_parse, "content");
+    scope.set_bytes(size);
+    csv::parser_config config = get_parser_config();
+    csv_parser<csv_handler> parser(content, size, handler, config);
+    try
+    {
+        parser.parse();
+    }
+    catch (const csv::parse_error& e)
+    {
+        cout << "parse failed: " << e.what() << endl;
+    }
+}
+
+/**
+ * Count the quotes in one slice of the content.
+ */
+class quote_counter
+{
+    const char* mp_begin;
+    const char* mp_end;
+    char m_quote;
+    size_t& m_count;
+
+public:
+    quote_counter(const char* p_begin, const char* p_end, char quote, size_t& count) :
+        mp_begin(p_begin), mp_end(p_end), m_quote(quote), m_count(count) {}
+
+    void operator() ()
+    {
+        m_count = 0;
+        for (const char* p = mp_begin; p != mp_end; ++p, ++m_count)
+        {
+            p = static_cast<const char*>(memchr(p, m_quote, mp_end-p));
+            if (!p)
+                break;
+        }
+    }
+};
+
+/**
+ * Find the start of the first row at or after a position, given whether
+ * that position is inside a quoted cell.  Each quote toggles the state,
+ * which also holds for escaped quotes since they come in pairs.
+ *
+ * @return pointer to the first character of the row, or p_end if there
+ *         are no more rows.
+ */
+const char* find_row_start(const char* p, const char* p_end, char quote, bool quoted)
+{
+    while (p != p_end)
+    {
+        if (quoted)
+        {
+            p = static_cast<const char*>(memchr(p, quote, p_end-p));
+            if (!p)
+                return p_end;
+
+            ++p;
+            quoted = false;
+            continue;
+        }
+
+        const char* p_lf = static_cast<const char*>(memchr(p, '\n', p_end-p));
+        if (!p_lf)
+            return p_end;
+
+        const char* p_quote = static_cast<const char*>(memchr(p, quote, p_lf-p));
+        if (!p_quote)
+            return p_lf + 1;
+
+        p = p_quote + 1;
+        quoted = true;
+    }
+
+    return p_end;
+}
+
+/**
+ * Single cell value of a chunk, along with its numeric value when the
+ * whole value parses as a number the way spreadsheet::sheet::set_auto()
+ * does.
+ */
+struct csv_cell
+{
+    pstring value;
+    double number;
+    bool numeric;
+
+    csv_cell(const pstring& _value) : value(_value), number(0.0), numeric(false) {}
+};
+
+/**
+ * Cells of a single chunk of rows.  The values of all rows are stored
+ * back-to-back, along with the number of cells in each row.  Values point
+ * into the source content except for the ones the parser had to unescape,
+ * which get interned in the chunk's own string pool.
+ */
+struct csv_chunk
+{
+    const char* content;
+    size_t size;
+    std::vector<csv_cell> cells;
+    std::vector<spreadsheet::col_t> row_sizes;
+    string_pool pool;
+    std::string error;
+    bool classify;   /// whether to detect numeric values.
+    bool open_end;   /// whether the last cell runs into the end of the chunk.
+
+    csv_chunk(const char* _content, size_t _size, bool _classify) :
+        content(_content), size(_size), classify(_classify), open_end(false) {}
+};
+
+class csv_chunk_handler
+{
+public:
+    csv_chunk_handler(csv_chunk& chunk) :
+        m_chunk(chunk), m_col(0) {}
+
+    void begin_parse() {}
+    void end_parse() {}
+    void begin_row() {}
+
+    void end_row()
+    {
+        m_chunk.row_sizes.push_back(m_col);
+        m_col = 0;
+    }
+
+    void cell(const char* p, size_t n)
+    {
+        const char* chunk_end = m_chunk.content + m_chunk.size;
+        if (n && (p < m_chunk.content || chunk_end <= p))
+            // This value is stored in the parser's transient buffer.
+            m_chunk.cells.push_back(csv_cell(m_chunk.pool.intern(p, n).first));
+        else
+        {
+            // A value that reaches the end of a chunk that ends with a line
+            // feed is a quoted cell left open.
+            if (p && chunk_end <= p + n)
+                m_chunk.open_end = true;
+
+            m_chunk.cells.push_back(csv_cell(pstring(p, n)));
+        }
+
+        if (m_chunk.classify && n)
+            classify(m_chunk.cells.back());
+
+        ++m_col;
+    }
+
+    /**
+     * Close the current row if it has any cells.  The parser leaves the row
+     * open when it fails.
+     */
+    void flush_row()
+    {
+        if (m_col)
+            end_row();
+    }
+
+private:
+    static void classify(csv_cell& c)
+    {
+        const char* p = c.value.get();
+        const char* p_end = p + c.value.size();
+        while (p != p_end && is_blank(*p))
+            ++p;
+
+        const char* endptr = NULL;
+        double val = to_double(p, p_end, &endptr);
+        if (endptr != p && endptr == p_end)
+        {
+            c.number = val;
+            c.numeric = true;
+        }
+    }
+
+private:
+    csv_chunk& m_chunk;
+    spreadsheet::col_t m_col;
+};
+
+class csv_chunk_worker
+{
+    csv_chunk& m_chunk;
+    const csv::parser_config& m_config;
+    import_trace* mp_trace;
+
+public:
+    csv_chunk_worker(csv_chunk& chunk, const csv::parser_config& config, import_trace* trace) :
+        m_chunk(chunk), m_config(config), mp_trace(trace) {}
+
+    void operator() ()
+    {
+        trace_scope scope(mp_trace, trace_phase_parse, "content");
+        scope.set_bytes(m_chunk.size);
+        csv_chunk_handler handler(m_chunk);
+        csv_parser<csv_chunk_handler> parser(m_chunk.content, m_chunk.size, handler, m_config);
+        try
+        {
+            parser.parse();
+        }
+        catch (const csv::parse_error& e)
+        {
+            handler.flush_row();
+            m_chunk.error = e.what();
+        }
+    }
+};
+
 }
 
 orcus_csv::orcus_csv(spreadsheet::iface::import_factory* factory) : mp_factory(factory) {}
 
+void orcus_csv::set_config(const config& opt)
+{
+    m_config = opt;
+}
+
 void orcus_csv::read_file(const char* filepath)
 {
     cout << "reading " << filepath << endl;
-    string strm;
-    load_file_content(filepath, strm);
-    parse(strm);
+    import_trace_guard trace_guard(mp_factory, m_config.trace);
+    file_content content(filepath);
+    if (m_config.thread_count > 1)
+        parse_parallel(content.data(), content.size());
+    else
+        parse(content.data(), content.size());
 
     mp_factory->finalize();
 }
 
-void orcus_csv::parse(const string& strm)
+void orcus_csv::parse(const char* content, size_t size)
 {
-    if (strm.empty())
+    if (!size)
         return;
 
     csv_handler handler(*mp_factory);
-    csv::parser_config config;
-    config.delimiters.push_back(',');
-    config.text_qualifier = '"';
-    csv_parser<csv_handler> parser(&strm[0], strm.size(), handler, config);
+    parse_rows(content, size, handler, m_config.trace);
+}
+
+void orcus_csv::parse_parallel(const char* content, size_t size)
+{
+    size_t chunk_count = std::min(m_config.thread_count, size / min_chunk_size);
+    if (chunk_count < 2)
+    {
+        parse(content, size);
+        return;
+    }
+
+    csv::parser_config config = get_parser_config();
+    const char* p_end = content + size;
+
+    // Count the quotes of equally sized slices in parallel, to know whether
+    // each split position falls inside a quoted cell.
+    std::vector<size_t> quote_counts(chunk_count, 0);
+    {
+        boost::thread_group counters;
+        for (size_t i = 0; i < chunk_count; ++i)
+        {
+            const char* p_slice = content + size / chunk_count * i;
+            const char* p_slice_end = i+1 == chunk_count ? p_end : content + size / chunk_count * (i+1);
+            counters.create_thread(
+                quote_counter(p_slice, p_slice_end, config.text_qualifier, quote_counts[i]));
+        }
+        counters.join_all();
+    }
+
+    // Split the content at the first row boundary past each split position.
+    // Quotes that don't delimit quoted cells can throw a boundary off; such
+    // a boundary leaves a quoted cell open at the end of the chunk before
+    // it, which gets caught below.
+    spreadsheet::iface::import_shared_strings* sstrings = mp_factory->get_shared_strings();
+    boost::ptr_vector<csv_chunk> chunks;
+    const char* p = content;
+    size_t quote_count = 0;
+    for (size_t i = 1; i <= chunk_count && p != p_end; ++i)
+    {
+        const char* p_chunk = p;
+        quote_count += quote_counts[i-1];
+        if (i == chunk_count)
+            p = p_end;
+        else
+        {
+            const char* p_split = content + size / chunk_count * i;
+            if (p < p_split)
+                p = find_row_start(p_split, p_end, config.text_qualifier, quote_count % 2 != 0);
+        }
+
+        if (p != p_chunk)
+            chunks.push_back(new csv_chunk(p_chunk, p - p_chunk, sstrings != NULL));
+    }
+
+    boost::ptr_vector<boost::thread> workers;
+    for (size_t i = 0; i < chunks.size(); ++i)
+        workers.push_back(new boost::thread(csv_chunk_worker(chunks[i], config, m_config.trace)));
+
+    // Pass the cells to the sheet in row order, starting with each chunk as
+    // soon as its worker is done with it.  Numbers and strings go through
+    // the block setters when the factory has shared strings to put the
+    // strings in; the cells are passed to set_auto() otherwise.
     try
     {
-        parser.parse();
+        const char* sheet_name = "data";
+        spreadsheet::iface::import_sheet* sheet = mp_factory->append_sheet(sheet_name, strlen(sheet_name));
+
+        spreadsheet::row_t row_offset = 0;
+        bool failed = false;
+        for (size_t i = 0; i < chunks.size(); ++i)
+        {
+            workers[i].join();
+            if (failed)
+                continue;
+
+            const csv_chunk& chunk = chunks[i];
+            if (i+1 < chunks.size() && (chunk.open_end || !chunk.error.empty()))
+            {
+                // This chunk doesn't end at a row boundary, or is malformed.
+                // Parse the rest of the content on this thread.
+                csv_handler handler(*mp_factory, sheet, row_offset);
+                parse_rows(chunk.content, p_end - chunk.content, handler, m_config.trace);
+                failed = true;
+                continue;
+            }
+
+            trace_scope scope(m_config.trace, trace_phase_insert, "content");
+            std::vector<csv_cell>::const_iterator it_cell = chunk.cells.begin();
+            if (sstrings)
+            {
+                sheet_row_buffer buf(sheet);
+                for (size_t row = 0, n = chunk.row_sizes.size(); row < n; ++row, ++row_offset)
+                {
+                    for (spreadsheet::col_t col = 0; col < chunk.row_sizes[row]; ++col, ++it_cell)
+                    {
+                        if (it_cell->value.empty())
+                            continue;
+
+                        if (it_cell->numeric)
+                            buf.set_value(row_offset, col, it_cell->number);
+                        else
+                            buf.set_string(
+                                row_offset, col, sstrings->add(it_cell->value.get(), it_cell->value.size()));
+                    }
+                    buf.flush();
+                }
+            }
+            else
+            {
+                for (size_t row = 0, n = chunk.row_sizes.size(); row < n; ++row, ++row_offset)
+                {
+                    for (spreadsheet::col_t col = 0; col < chunk.row_sizes[row]; ++col, ++it_cell)
+                        sheet->set_auto(row_offset, col, it_cell->value.get(), it_cell->value.size());
+                }
+            }
+
+            if (!chunk.error.empty())
+            {
+                cout << "parse failed: " << chunk.error << endl;
+                failed = true;
+            }
+        }
     }
-    catch (const csv::parse_error& e)
+    catch (...)
     {
-        cout << "parse failed: " << e.what() << endl;
+        // The workers must not outlive the chunks they write to.
+        for (size_t i = 0; i < workers.size(); ++i)
+        {
+            if (workers[i].joinable())
+                workers[i].join();
+        }
+        throw;
     }
 }
 
 }
-
@@ -27,12 +27,17 @@
 
 #include "orcus/orcus_gnumeric.hpp"
 #include "orcus/xml_namespace.hpp"
+#include "orcus/exception.hpp"
+#include "orcus/config.hpp"
+#include "orcus/import_trace.hpp"
 
 #include "xml_stream_parser.hpp"
+#include "stream_pipe.hpp"
 #include "gnumeric_handler.hpp"
 #include "gnumeric_tokens.hpp"
 #include "gnumeric_namespace_types.hpp"
 #include "session_context.hpp"
+#include "traced_import_factory.hpp"
 
 #include <zlib.h>
 
@@ -51,14 +56,75 @@ using namespace std;
 
 namespace orcus {
 
+namespace {
+
+/**
+ * Decompressed streams smaller than this are not worth a separate thread.
+ */
+const size_t min_pipe_size = 0x20000;
+
+/**
+ * Get the decompressed size of a gzip-compressed file from its trailer.
+ * The trailer only stores the size modulo 2^32, so a size smaller than the
+ * compressed file itself is taken as having wrapped around and is
+ * rejected.
+ *
+ * @return true if the file is gzip-compressed and its decompressed size is
+ *         known, false otherwise.
+ */
+bool get_gzip_size(const char* fpath, size_t& size)
+{
+    ifstream file(fpath, ios::in | ios::binary);
+    unsigned char header[2];
+    if (!file.read(reinterpret_cast<char*>(header), 2) || header[0] != 0x1f || header[1] != 0x8b)
+        return false;
+
+    unsigned char trailer[4];
+    if (!file.seekg(-4, ios::end) || !file.read(reinterpret_cast<char*>(trailer), 4))
+        return false;
+
+    size_t compressed_size = static_cast<size_t>(file.tellg());
+    size = trailer[0] | (trailer[1] << 8) | (trailer[2] << 16) | (static_cast<size_t>(trailer[3]) << 24);
+    return size >= compressed_size;
+}
+
+/**
+ * Decompresses a gzip stream on the pipe's thread.
+ */
+class gzip_producer : public stream_pipe::producer
+{
+    gzFile m_file;
+    import_trace* mp_trace;
+public:
+    gzip_producer(gzFile file, import_trace* trace) : m_file(file), mp_trace(trace) {}
+
+    virtual size_t produce(char* p, size_t n)
+    {
+        trace_scope scope(mp_trace, trace_phase_inflate, "content.xml");
+        int read_characters = gzread(m_file, p, n);
+        if (read_characters < 0)
+        {
+            int err;
+            throw general_error(gzerror(m_file, &err));
+        }
+
+        scope.set_bytes(read_characters);
+        return read_characters;
+    }
+};
+
+}
+
 struct orcus_gnumeric_impl
 {
     xmlns_repository m_ns_repo;
     session_context m_cxt;
     spreadsheet::iface::import_factory* mp_factory;
+    config m_config;
+    size_t m_skipped_bytes;
 
     orcus_gnumeric_impl(spreadsheet::iface::import_factory* im_factory) :
-        mp_factory(im_factory) {}
+        mp_factory(im_factory), m_skipped_bytes(0) {}
 };
 
 orcus_gnumeric::orcus_gnumeric(spreadsheet::iface::import_factory* factory) :
@@ -72,26 +138,59 @@ orcus_gnumeric::~orcus_gnumeric()
     delete mp_impl;
 }
 
-void orcus_gnumeric::read_content_xml(const char* p, size_t size)
+void orcus_gnumeric::set_config(const config& opt)
 {
-    xml_stream_parser parser(mp_impl->m_ns_repo, gnumeric_tokens, p, size, "content.xml");
+    mp_impl->m_config = opt;
+}
+
+void orcus_gnumeric::read_content_xml(const char* p, size_t size, sax::stream_source* source)
+{
+    ::boost::scoped_ptr<xml_stream_parser> parser;
+    if (source)
+        parser.reset(
+            new xml_stream_parser(mp_impl->m_ns_repo, gnumeric_tokens, p, size, *source, "content.xml"));
+    else
+        parser.reset(new xml_stream_parser(mp_impl->m_ns_repo, gnumeric_tokens, p, size, "content.xml"));
+
     ::boost::scoped_ptr<gnumeric_content_xml_handler> handler(
         new gnumeric_content_xml_handler(mp_impl->m_cxt, gnumeric_tokens, mp_impl->mp_factory));
-    parser.set_handler(handler.get());
-    parser.parse();
+    parser->set_handler(handler.get());
+    parser->set_trace(mp_impl->m_config.trace);
+    parser->parse();
+    mp_impl->m_skipped_bytes += parser->get_skipped_bytes();
+
+    mp_impl->mp_factory->finalize();
 }
 
 void orcus_gnumeric::read_file(const char *fpath)
 {
     cout << "reading " << fpath << endl;
+    import_trace_guard trace_guard(mp_impl->mp_factory, mp_impl->m_config.trace);
+    mp_impl->m_skipped_bytes = 0;
+
+    size_t size = 0;
+    bool pipelined = stream_pipe::enabled() && get_gzip_size(fpath, size) && size >= min_pipe_size;
 
     gzFile file = gzopen(fpath, "rb");
 
     if (!file)
         return;
 
+    if (pipelined)
+    {
+        // Decompress on a separate thread while the content gets parsed.
+        std::vector<char> buffer(size+1, '\0'); // null-terminated
+        gzip_producer producer(file, mp_impl->m_config.trace);
+        stream_pipe pipe(producer, &buffer[0], 0, size);
+        read_content_xml(&buffer[0], 0, &pipe);
+
+        gzclose(file);
+        return;
+    }
+
     std::string file_content;
 
+    trace_scope scope(mp_impl->m_config.trace, trace_phase_inflate, "content.xml");
     while (true)
     {
         char buffer[BUFFER_LENGTH];
@@ -116,12 +215,17 @@ void orcus_gnumeric::read_file(const char *fpath)
             }
         }
     }
+    scope.set_bytes(file_content.size());
+    scope.finish();
 
-    read_content_xml(file_content.c_str(), file_content.length());
-
-    mp_impl->mp_factory->finalize();
+    read_content_xml(file_content.c_str(), file_content.length(), NULL);
 
     gzclose(file);
 }
 
+size_t orcus_gnumeric::get_skipped_bytes() const
+{
+    return mp_impl->m_skipped_bytes;
+}
+
 }
@@ -27,14 +27,18 @@
 
 #include "orcus/orcus_ods.hpp"
 #include "orcus/xml_namespace.hpp"
+#include "orcus/config.hpp"
+#include "orcus/import_trace.hpp"
 #include "orcus/zip_archive.hpp"
 #include "orcus/zip_archive_stream.hpp"
 
 #include "xml_stream_parser.hpp"
+#include "zip_entry_stream.hpp"
 #include "ods_content_xml_handler.hpp"
 #include "odf_tokens.hpp"
 #include "odf_namespace_types.hpp"
 #include "session_context.hpp"
+#include "traced_import_factory.hpp"
 
 #include <cstdlib>
 #include <iostream>
@@ -51,9 +55,11 @@ struct orcus_ods_impl
     xmlns_repository m_ns_repo;
     session_context m_cxt;
     spreadsheet::iface::import_factory* mp_factory;
+    config m_config;
+    size_t m_skipped_bytes;
 
     orcus_ods_impl(spreadsheet::iface::import_factory* im_factory) :
-        mp_factory(im_factory) {}
+        mp_factory(im_factory), m_skipped_bytes(0) {}
 };
 
 orcus_ods::orcus_ods(spreadsheet::iface::import_factory* factory) :
@@ -67,6 +73,11 @@ orcus_ods::~orcus_ods()
     delete mp_impl;
 }
 
+void orcus_ods::set_config(const config& opt)
+{
+    mp_impl->m_config = opt;
+}
+
 void orcus_ods::list_content(const zip_archive& archive)
 {
     size_t num = archive.get_file_entry_count();
@@ -84,23 +95,25 @@ void orcus_ods::list_content(const zip_archive& archive)
 
 void orcus_ods::read_content(const zip_archive& archive)
 {
-    vector<unsigned char> buf;
-    if (!archive.read_file_entry("content.xml", buf))
+    zip_entry_stream strm;
+    strm.set_trace(mp_impl->m_config.trace);
+    if (!strm.open(archive, "content.xml"))
     {
         cout << "failed to get stat on content.xml" << endl;
         return;
     }
 
-    read_content_xml(&buf[0], buf.size());
-}
+    if (strm.empty())
+        return;
 
-void orcus_ods::read_content_xml(const unsigned char* p, size_t size)
-{
-    xml_stream_parser parser(mp_impl->m_ns_repo, odf_tokens, reinterpret_cast<const char*>(p), size, "content.xml");
+    strm.start_background_inflate();
+    xml_stream_parser parser(mp_impl->m_ns_repo, odf_tokens, strm.data(), strm.filled(), strm, "content.xml");
     ::boost::scoped_ptr<ods_content_xml_handler> handler(
         new ods_content_xml_handler(mp_impl->m_cxt, odf_tokens, mp_impl->mp_factory));
     parser.set_handler(handler.get());
+    parser.set_trace(mp_impl->m_config.trace);
     parser.parse();
+    mp_impl->m_skipped_bytes += parser.get_skipped_bytes();
 }
 
 bool orcus_ods::detect(const unsigned char* blob, size_t size)
@@ -141,13 +154,24 @@ bool orcus_ods::detect(const unsigned char* blob, size_t size)
 void orcus_ods::read_file(const char* fpath)
 {
     cout << "reading " << fpath << endl;
-    zip_archive_stream_fd stream(fpath);
+    import_trace_guard trace_guard(mp_impl->mp_factory, mp_impl->m_config.trace);
+    mp_impl->m_skipped_bytes = 0;
+    zip_archive_stream_mmap stream(fpath);
     zip_archive archive(&stream);
-    archive.load();
+    {
+        trace_scope scope(mp_impl->m_config.trace, trace_phase_zip_read, fpath);
+        archive.load();
+        scope.set_bytes(stream.size());
+    }
     list_content(archive);
     read_content(archive);
 
     mp_impl->mp_factory->finalize();
 }
 
+size_t orcus_ods::get_skipped_bytes() const
+{
+    return mp_impl->m_skipped_bytes;
+}
+
 }
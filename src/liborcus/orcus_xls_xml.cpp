@@ -28,10 +28,12 @@
 #include "orcus/orcus_xls_xml.hpp"
 #include "orcus/stream.hpp"
 #include "orcus/xml_namespace.hpp"
+#include "orcus/config.hpp"
 
 #include "xml_stream_parser.hpp"
 #include "xls_xml_handler.hpp"
 #include "session_context.hpp"
+#include "traced_import_factory.hpp"
 #include "xls_xml_tokens.hpp"
 #include "xls_xml_namespace_types.hpp"
 
@@ -52,6 +54,7 @@ struct orcus_xls_xml_impl
     xmlns_repository m_ns_repo;
     session_context m_cxt;
     spreadsheet::iface::import_factory* mp_factory;
+    config m_config;
 
     orcus_xls_xml_impl(spreadsheet::iface::import_factory* factory) : mp_factory(factory) {}
 };
@@ -67,21 +70,27 @@ orcus_xls_xml::~orcus_xls_xml()
     delete mp_impl;
 }
 
+void orcus_xls_xml::set_config(const config& opt)
+{
+    mp_impl->m_config = opt;
+}
+
 void orcus_xls_xml::read_file(const char* fpath)
 {
 #if ORCUS_DEBUG_XLS_XML_FILTER
     cout << "reading " << fpath << endl;
 #endif
 
-    string strm;
-    load_file_content(fpath, strm);
-    if (strm.empty())
+    import_trace_guard trace_guard(mp_impl->mp_factory, mp_impl->m_config.trace);
+    file_content content(fpath);
+    if (content.empty())
         return;
 
-    xml_stream_parser parser(mp_impl->m_ns_repo, xls_xml_tokens, &strm[0], strm.size(), "content");
+    xml_stream_parser parser(mp_impl->m_ns_repo, xls_xml_tokens, content.data(), content.size(), "content");
     boost::scoped_ptr<xls_xml_handler> handler(
         new xls_xml_handler(mp_impl->m_cxt, xls_xml_tokens, mp_impl->mp_factory));
     parser.set_handler(handler.get());
+    parser.set_trace(mp_impl->m_config.trace);
     parser.parse();
 }
 
@@ -29,6 +29,11 @@
 
 #include "orcus/xml_namespace.hpp"
 #include "orcus/global.hpp"
+#include "orcus/config.hpp"
+#include "orcus/exception.hpp"
+#include "orcus/zip_archive.hpp"
+#include "orcus/zip_archive_stream.hpp"
+#include "orcus/import_trace.hpp"
 #include "orcus/spreadsheet/import_interface.hpp"
 
 #include "xlsx_types.hpp"
@@ -43,7 +48,11 @@
 #include "ooxml_namespace_types.hpp"
 #include "session_context.hpp"
 #include "opc_context.hpp"
+#include "import_sheet_buffer.hpp"
+#include "traced_import_factory.hpp"
+#include "zip_entry_stream.hpp"
 
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 #include <string>
@@ -53,6 +62,7 @@
 #include <boost/shared_ptr.hpp>
 #include <boost/scoped_ptr.hpp>
 #include <boost/ptr_container/ptr_vector.hpp>
+#include <boost/thread.hpp>
 
 using namespace std;
 
@@ -69,6 +79,158 @@ struct print_sheet_info : unary_function<pair<pstring, const opc_rel_extra*>, vo
     }
 };
 
+/**
+ * Sheet stream whose parsing is deferred so that it can run on a worker
+ * thread.  The worker records the sheet content into the buffer, which then
+ * gets replayed onto the real sheet on the calling thread.
+ */
+struct xlsx_sheet_task
+{
+    std::string filepath;
+    std::string file_name;
+    std::string sheet_name;
+    import_sheet_buffer buffer;
+    std::string error;
+    size_t skipped_bytes;
+    bool empty:1;
+    bool done:1;
+
+    xlsx_sheet_task(const std::string& _filepath, const std::string& _file_name, const pstring& _sheet_name) :
+        filepath(_filepath), file_name(_file_name), sheet_name(_sheet_name.str()),
+        skipped_bytes(0), empty(false), done(false) {}
+};
+
+typedef boost::ptr_vector<xlsx_sheet_task> xlsx_sheet_tasks_type;
+
+/**
+ * State shared between the calling thread and the worker threads.
+ */
+struct xlsx_sheet_task_queue
+{
+    boost::mutex mtx;
+    boost::condition_variable cond;
+    xlsx_sheet_tasks_type& tasks;
+    size_t next;
+
+    xlsx_sheet_task_queue(xlsx_sheet_tasks_type& _tasks) : tasks(_tasks), next(0) {}
+
+    /**
+     * @return next task to process, or NULL if there are no more tasks.
+     */
+    xlsx_sheet_task* pop()
+    {
+        boost::mutex::scoped_lock lock(mtx);
+        if (next >= tasks.size())
+            return NULL;
+
+        return &tasks[next++];
+    }
+
+    /**
+     * Make all workers stop once they finish their current tasks.
+     */
+    void cancel()
+    {
+        boost::mutex::scoped_lock lock(mtx);
+        next = tasks.size();
+    }
+
+    void set_done(xlsx_sheet_task& task)
+    {
+        boost::mutex::scoped_lock lock(mtx);
+        task.done = true;
+        cond.notify_all();
+    }
+
+    void wait(xlsx_sheet_task& task)
+    {
+        boost::mutex::scoped_lock lock(mtx);
+        while (!task.done)
+            cond.wait(lock);
+    }
+};
+
+/**
+ * Worker that inflates and parses sheet streams until the task queue runs
+ * dry.  Each worker opens its own zip archive instance and namespace
+ * repository since neither is safe to share between threads.
+ */
+class xlsx_sheet_worker
+{
+    const std::string& m_archive_path;
+    xlsx_sheet_task_queue& m_queue;
+    import_trace* mp_trace;
+
+public:
+    xlsx_sheet_worker(const std::string& archive_path, xlsx_sheet_task_queue& queue, import_trace* trace) :
+        m_archive_path(archive_path), m_queue(queue), mp_trace(trace) {}
+
+    void operator() ()
+    {
+        xlsx_sheet_task* task = m_queue.pop();
+        if (!task)
+            return;
+
+        try
+        {
+            zip_archive_stream_mmap stream(m_archive_path.c_str());
+            zip_archive archive(&stream);
+            {
+                trace_scope scope(mp_trace, trace_phase_zip_read, m_archive_path);
+                archive.load();
+                scope.set_bytes(stream.size());
+            }
+
+            xmlns_repository ns_repo;
+            ns_repo.add_predefined_values(NS_ooxml_all);
+            ns_repo.add_predefined_values(NS_opc_all);
+            session_context cxt;
+
+            for (; task; task = m_queue.pop())
+            {
+                run(*task, archive, ns_repo, cxt);
+                m_queue.set_done(*task);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            // Failed to open the archive.
+            for (; task; task = m_queue.pop())
+            {
+                task->error = e.what();
+                m_queue.set_done(*task);
+            }
+        }
+    }
+
+private:
+    void run(xlsx_sheet_task& task, zip_archive& archive, xmlns_repository& ns_repo, session_context& cxt)
+    {
+        try
+        {
+            zip_entry_stream strm;
+            strm.set_trace(mp_trace);
+            if (!strm.open(archive, task.filepath.c_str()) || strm.empty())
+            {
+                task.empty = true;
+                return;
+            }
+
+            xml_stream_parser parser(
+                ns_repo, ooxml_tokens, strm.data(), strm.filled(), strm, task.file_name);
+            xlsx_sheet_xml_handler handler(cxt, ooxml_tokens, &task.buffer);
+            parser.set_handler(&handler);
+            parser.set_trace(mp_trace);
+            parser.parse();
+            task.skipped_bytes = parser.get_skipped_bytes();
+        }
+        catch (const std::exception& e)
+        {
+            task.error = e.what();
+        }
+    }
+};
+
 }
 
 class xlsx_opc_handler : public opc_reader::part_handler
@@ -113,11 +275,69 @@ struct orcus_xlsx_impl
     spreadsheet::iface::import_factory* mp_factory;
     xlsx_opc_handler m_opc_handler;
     opc_reader m_opc_reader;
+    config m_config;
+    std::string m_file_path;
+    xlsx_sheet_tasks_type m_sheet_tasks;
+    size_t m_skipped_bytes;
 
     orcus_xlsx_impl(spreadsheet::iface::import_factory* factory, orcus_xlsx& parent) :
-        mp_factory(factory), m_opc_handler(parent), m_opc_reader(m_ns_repo, m_cxt, m_opc_handler) {}
+        mp_factory(factory), m_opc_handler(parent), m_opc_reader(m_ns_repo, m_cxt, m_opc_handler),
+        m_skipped_bytes(0) {}
+
+    void run_sheet_tasks();
 };
 
+void orcus_xlsx_impl::run_sheet_tasks()
+{
+    if (m_sheet_tasks.empty())
+        return;
+
+    xlsx_sheet_task_queue queue(m_sheet_tasks);
+    size_t thread_count = std::min(m_config.thread_count, m_sheet_tasks.size());
+    boost::thread_group workers;
+    for (size_t i = 0; i < thread_count; ++i)
+        workers.create_thread(xlsx_sheet_worker(m_file_path, queue, m_config.trace));
+
+    try
+    {
+        // Replay the sheets in their original order as they become ready.
+        xlsx_sheet_tasks_type::iterator it = m_sheet_tasks.begin(), it_end = m_sheet_tasks.end();
+        for (; it != it_end; ++it)
+        {
+            xlsx_sheet_task& task = *it;
+            queue.wait(task);
+
+            if (!task.error.empty())
+                throw general_error(task.filepath + ": " + task.error);
+
+            m_skipped_bytes += task.skipped_bytes;
+
+            if (task.empty)
+                continue;
+
+            spreadsheet::iface::import_sheet* sheet =
+                mp_factory->append_sheet(task.sheet_name.data(), task.sheet_name.size());
+            if (sheet)
+            {
+                trace_scope scope(m_config.trace, trace_phase_insert, task.filepath);
+                task.buffer.replay(*sheet);
+            }
+
+            task.buffer.clear();
+        }
+    }
+    catch (...)
+    {
+        queue.cancel();
+        workers.join_all();
+        m_sheet_tasks.clear();
+        throw;
+    }
+
+    workers.join_all();
+    m_sheet_tasks.clear();
+}
+
 orcus_xlsx::orcus_xlsx(spreadsheet::iface::import_factory* factory) :
     mp_impl(new orcus_xlsx_impl(factory, *this))
 {
@@ -176,12 +396,27 @@ bool orcus_xlsx::detect(const unsigned char* blob, size_t size)
     return std::find(parts.begin(), parts.end(), workbook_part) != parts.end();
 }
 
+void orcus_xlsx::set_config(const config& opt)
+{
+    mp_impl->m_config = opt;
+}
+
 void orcus_xlsx::read_file(const char* fpath)
 {
+    import_trace_guard trace_guard(mp_impl->mp_factory, mp_impl->m_config.trace);
+    mp_impl->m_opc_reader.set_trace(mp_impl->m_config.trace);
+    mp_impl->m_file_path = fpath;
+    mp_impl->m_skipped_bytes = 0;
     mp_impl->m_opc_reader.read_file(fpath);
+    mp_impl->run_sheet_tasks();
     mp_impl->mp_factory->finalize();
 }
 
+size_t orcus_xlsx::get_skipped_bytes() const
+{
+    return mp_impl->m_skipped_bytes;
+}
+
 void orcus_xlsx::read_workbook(const string& dir_path, const string& file_name)
 {
     string filepath = dir_path + file_name;
@@ -199,7 +434,9 @@ void orcus_xlsx::read_workbook(const string& dir_path, const string& file_name)
 
     xml_stream_parser parser(mp_impl->m_ns_repo, ooxml_tokens, reinterpret_cast<const char*>(&buffer[0]), buffer.size(), filepath);
     parser.set_handler(handler.get());
+    parser.set_trace(mp_impl->m_config.trace);
     parser.parse();
+    mp_impl->m_skipped_bytes += parser.get_skipped_bytes();
 
     // Get sheet info from the context instance.
     xlsx_workbook_context& context =
@@ -217,11 +454,20 @@ void orcus_xlsx::read_sheet(const string& dir_path, const string& file_name, con
     string filepath = dir_path + file_name;
     cout << "read_sheet: file path = " << filepath << endl;
 
-    vector<unsigned char> buffer;
-    if (!mp_impl->m_opc_reader.open_zip_stream(filepath, buffer))
+    if (mp_impl->m_config.thread_count > 1)
+    {
+        // Defer parsing of the sheet stream until all the other parts have
+        // been read, so that all sheets can be parsed in parallel.
+        mp_impl->m_sheet_tasks.push_back(new xlsx_sheet_task(filepath, file_name, data->name));
+        mp_impl->m_opc_reader.check_relation_part(file_name, NULL);
         return;
+    }
 
-    if (buffer.empty())
+    zip_entry_stream strm;
+    if (!mp_impl->m_opc_reader.open_zip_stream(filepath, strm))
+        return;
+
+    if (strm.empty())
         return;
 
     if (data)
@@ -230,11 +476,14 @@ void orcus_xlsx::read_sheet(const string& dir_path, const string& file_name, con
         cout << "  sheet name: " << data->name << "  sheet ID: " << data->id << endl;
     }
 
-    xml_stream_parser parser(mp_impl->m_ns_repo, ooxml_tokens, reinterpret_cast<const char*>(&buffer[0]), buffer.size(), file_name);
+    strm.start_background_inflate();
+    xml_stream_parser parser(mp_impl->m_ns_repo, ooxml_tokens, strm.data(), strm.filled(), strm, file_name);
     spreadsheet::iface::import_sheet* sheet = mp_impl->mp_factory->append_sheet(data->name.get(), data->name.size());
     ::boost::scoped_ptr<xlsx_sheet_xml_handler> handler(new xlsx_sheet_xml_handler(mp_impl->m_cxt, ooxml_tokens, sheet));
     parser.set_handler(handler.get());
+    parser.set_trace(mp_impl->m_config.trace);
     parser.parse();
+    mp_impl->m_skipped_bytes += parser.get_skipped_bytes();
 
     mp_impl->m_opc_reader.check_relation_part(file_name, NULL);
 }
@@ -245,19 +494,22 @@ void orcus_xlsx::read_shared_strings(const string& dir_path, const string& file_
     string filepath = dir_path + file_name;
     cout << "read_shared_strings: file path = " << filepath << endl;
 
-    vector<unsigned char> buffer;
-    if (!mp_impl->m_opc_reader.open_zip_stream(filepath, buffer))
+    zip_entry_stream strm;
+    if (!mp_impl->m_opc_reader.open_zip_stream(filepath, strm))
         return;
 
-    if (buffer.empty())
+    if (strm.empty())
         return;
 
-    xml_stream_parser parser(mp_impl->m_ns_repo, ooxml_tokens, reinterpret_cast<const char*>(&buffer[0]), buffer.size(), file_name);
+    strm.start_background_inflate();
+    xml_stream_parser parser(mp_impl->m_ns_repo, ooxml_tokens, strm.data(), strm.filled(), strm, file_name);
     ::boost::scoped_ptr<xml_simple_stream_handler> handler(
         new xml_simple_stream_handler(
             new xlsx_shared_strings_context(mp_impl->m_cxt, ooxml_tokens, mp_impl->mp_factory->get_shared_strings())));
     parser.set_handler(handler.get());
+    parser.set_trace(mp_impl->m_config.trace);
     parser.parse();
+    mp_impl->m_skipped_bytes += parser.get_skipped_bytes();
 }
 
 void orcus_xlsx::read_styles(const string& dir_path, const string& file_name)
@@ -285,7 +537,9 @@ void orcus_xlsx::read_styles(const string& dir_path, const string& file_name)
 //      xlsx_styles_context& context =
 //          static_cast<xlsx_styles_context&>(handler->get_context());
     parser.set_handler(handler.get());
+    parser.set_trace(mp_impl->m_config.trace);
     parser.parse();
+    mp_impl->m_skipped_bytes += parser.get_skipped_bytes();
 }
 
 }
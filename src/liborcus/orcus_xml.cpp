@@ -32,8 +32,11 @@
 #include "orcus/spreadsheet/export_interface.hpp"
 #include "orcus/xml_namespace.hpp"
 #include "orcus/stream.hpp"
+#include "orcus/config.hpp"
+#include "orcus/import_trace.hpp"
 
 #include "xml_map_tree.hpp"
+#include "traced_import_factory.hpp"
 
 #define ORCUS_DEBUG_XML 0
 
@@ -43,6 +46,7 @@
 
 #include <vector>
 #include <boost/ptr_container/ptr_vector.hpp>
+#include <boost/scoped_ptr.hpp>
 #include <fstream>
 
 using namespace std;
@@ -468,8 +472,10 @@ struct orcus_xml_impl
     spreadsheet::iface::import_factory* mp_import_factory;
     spreadsheet::iface::export_factory* mp_export_factory;
 
+    config m_config;
+
     /** original xml data stream. */
-    string m_data_strm;
+    boost::scoped_ptr<file_content> mp_data_strm;
 
     /** xml namespace repository for the whole session. */
     xmlns_repository& m_ns_repo;
@@ -542,13 +548,19 @@ void orcus_xml::append_sheet(const pstring& name)
     mp_impl->mp_import_factory->append_sheet(name.get(), name.size());
 }
 
+void orcus_xml::set_config(const config& opt)
+{
+    mp_impl->m_config = opt;
+}
+
 void orcus_xml::read_file(const char* filepath)
 {
 #if ORCUS_DEBUG_XML
     cout << "reading file " << filepath << endl;
 #endif
-    string& strm = mp_impl->m_data_strm;
-    load_file_content(filepath, strm);
+    import_trace_guard trace_guard(mp_impl->mp_import_factory, mp_impl->m_config.trace);
+    mp_impl->mp_data_strm.reset(new file_content(filepath));
+    const file_content& strm = *mp_impl->mp_data_strm;
     if (strm.empty())
         return;
 
@@ -588,7 +600,9 @@ void orcus_xml::read_file(const char* filepath)
     xml_data_sax_handler handler(
        *mp_impl->mp_import_factory, mp_impl->m_link_positions, mp_impl->m_map_tree);
 
-    sax_ns_parser<xml_data_sax_handler> parser(strm.c_str(), strm.size(), ns_cxt, handler);
+    trace_scope scope(mp_impl->m_config.trace, trace_phase_parse, filepath);
+    scope.set_bytes(strm.size());
+    sax_ns_parser<xml_data_sax_handler> parser(strm.data(), strm.size(), ns_cxt, handler);
     parser.parse();
 }
 
@@ -611,7 +625,7 @@ void orcus_xml::write_file(const char* filepath)
         // We can't export data witout export factory.
         return;
 
-    if (mp_impl->m_data_strm.empty())
+    if (!mp_impl->mp_data_strm || mp_impl->mp_data_strm->empty())
         // Original xml stream is missing.  We need it.
         return;
 
@@ -638,7 +652,8 @@ void orcus_xml::write_file(const char* filepath)
     dump_links(links);
 #endif
 
-    const char* begin_pos = &mp_impl->m_data_strm[0];
+    const file_content& strm = *mp_impl->mp_data_strm;
+    const char* begin_pos = strm.data();
     for (; it != it_end; ++it)
     {
         const xml_map_tree::element& elem = **it;
@@ -708,7 +723,7 @@ void orcus_xml::write_file(const char* filepath)
     }
 
     // Flush the remaining stream.
-    const char* strm_end = &mp_impl->m_data_strm[mp_impl->m_data_strm.size()-1];
+    const char* strm_end = strm.data() + strm.size() - 1;
     file << pstring(begin_pos, strm_end-begin_pos);
 }
 
@@ -0,0 +1,149 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+#include "sheet_row_buffer.hpp"
+
+#include "orcus/spreadsheet/import_interface.hpp"
+
+namespace orcus {
+
+using namespace spreadsheet;
+
+sheet_row_buffer::sheet_row_buffer(iface::import_sheet* sheet) :
+    mp_sheet(sheet), m_type(run_none), m_row(0), m_col(0), m_size(0),
+    m_format_row(0), m_format_col(0), m_format_size(0), m_format_index(0) {}
+
+sheet_row_buffer::~sheet_row_buffer()
+{
+    flush();
+}
+
+void sheet_row_buffer::set_sheet(iface::import_sheet* sheet)
+{
+    flush();
+    mp_sheet = sheet;
+}
+
+void sheet_row_buffer::set_value(row_t row, col_t col, double value)
+{
+    prepare(run_value, row, col);
+    m_values[m_size++] = value;
+}
+
+void sheet_row_buffer::set_string(row_t row, col_t col, size_t sindex)
+{
+    prepare(run_string, row, col);
+    m_sindices[m_size++] = sindex;
+}
+
+void sheet_row_buffer::set_bool(row_t row, col_t col, bool value)
+{
+    prepare(run_bool, row, col);
+    m_bools[m_size++] = value;
+}
+
+void sheet_row_buffer::set_format(row_t row, col_t col, size_t xf_index)
+{
+    if (m_format_size)
+    {
+        if (xf_index == m_format_index && row == m_format_row &&
+            col == m_format_col + static_cast<col_t>(m_format_size))
+        {
+            ++m_format_size;
+            return;
+        }
+
+        flush_format();
+    }
+
+    m_format_row = row;
+    m_format_col = col;
+    m_format_index = xf_index;
+    m_format_size = 1;
+}
+
+void sheet_row_buffer::flush()
+{
+    flush_values();
+    flush_format();
+}
+
+void sheet_row_buffer::flush_values()
+{
+    if (!m_size)
+        return;
+
+    switch (m_type)
+    {
+        case run_value:
+            mp_sheet->set_values(m_row, m_col, m_values, m_size);
+        break;
+        case run_string:
+            mp_sheet->set_strings(m_row, m_col, m_sindices, m_size);
+        break;
+        case run_bool:
+            mp_sheet->set_bools(m_row, m_col, m_bools, m_size);
+        break;
+        default:
+            ;
+    }
+
+    m_type = run_none;
+    m_size = 0;
+}
+
+void sheet_row_buffer::prepare(run_type type, row_t row, col_t col)
+{
+    if (m_size)
+    {
+        if (type == m_type && row == m_row && col == m_col + static_cast<col_t>(m_size) && m_size < max_run_size)
+            return;
+
+        flush_values();
+    }
+
+    m_type = type;
+    m_row = row;
+    m_col = col;
+}
+
+void sheet_row_buffer::flush_format()
+{
+    if (!m_format_size)
+        return;
+
+    if (m_format_size == 1)
+        mp_sheet->set_format(m_format_row, m_format_col, m_format_index);
+    else
+        mp_sheet->set_format_range(
+            m_format_row, m_format_col,
+            m_format_row, m_format_col + static_cast<col_t>(m_format_size) - 1, m_format_index);
+
+    m_format_size = 0;
+}
+
+}
@@ -0,0 +1,124 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+#ifndef ORCUS_SHEET_ROW_BUFFER_HPP
+#define ORCUS_SHEET_ROW_BUFFER_HPP
+
+#include "orcus/spreadsheet/types.hpp"
+
+#include <cstdlib>
+
+namespace orcus {
+
+namespace spreadsheet { namespace iface {
+    class import_sheet;
+}}
+
+/**
+ * Collects numeric, string and boolean cells that are next to each other in
+ * the same row, and passes each run of same-typed cells to the sheet with a
+ * single block setter call.  A run ends when a cell of a different type or
+ * at a non-adjacent position arrives, when the run is full, or when the
+ * caller flushes the buffer, which it must do at the end of each row and
+ * before the sheet goes away.
+ *
+ * Cell formats are collected the same way, independently of the values,
+ * so that adjacent cells sharing the same format reach the sheet as one
+ * range.
+ */
+class sheet_row_buffer
+{
+    sheet_row_buffer(const sheet_row_buffer&); // disabled
+    sheet_row_buffer& operator=(const sheet_row_buffer&); // disabled
+
+    enum run_type
+    {
+        run_none,
+        run_value,
+        run_string,
+        run_bool
+    };
+
+    /**
+     * Maximum number of cells in a single run.
+     */
+    static const size_t max_run_size = 128;
+
+public:
+    sheet_row_buffer(spreadsheet::iface::import_sheet* sheet);
+
+    /**
+     * The destructor flushes the pending run.
+     */
+    ~sheet_row_buffer();
+
+    /**
+     * Flush the pending run, and direct all subsequent cells to another
+     * sheet.
+     */
+    void set_sheet(spreadsheet::iface::import_sheet* sheet);
+
+    void set_value(spreadsheet::row_t row, spreadsheet::col_t col, double value);
+    void set_string(spreadsheet::row_t row, spreadsheet::col_t col, size_t sindex);
+    void set_bool(spreadsheet::row_t row, spreadsheet::col_t col, bool value);
+    void set_format(spreadsheet::row_t row, spreadsheet::col_t col, size_t xf_index);
+
+    /**
+     * Pass the pending runs to the sheet.
+     */
+    void flush();
+
+private:
+    /**
+     * Make sure the cell at the specified position can be appended to the
+     * pending run, by flushing it and starting a new one if it cannot.
+     */
+    void prepare(run_type type, spreadsheet::row_t row, spreadsheet::col_t col);
+
+    void flush_values();
+    void flush_format();
+
+private:
+    spreadsheet::iface::import_sheet* mp_sheet;
+    run_type m_type;
+    spreadsheet::row_t m_row;
+    spreadsheet::col_t m_col; /// column of the first cell in the run.
+    size_t m_size;
+
+    double m_values[max_run_size];
+    size_t m_sindices[max_run_size];
+    bool m_bools[max_run_size];
+
+    spreadsheet::row_t m_format_row;
+    spreadsheet::col_t m_format_col; /// column of the first cell in the format run.
+    size_t m_format_size;
+    size_t m_format_index;
+};
+
+}
+
+#endif
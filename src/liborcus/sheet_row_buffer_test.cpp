@@ -0,0 +1,168 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+#include "sheet_row_buffer.hpp"
+#include "mock_spreadsheet.hpp"
+
+#include <cstdlib>
+#include <cassert>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace orcus;
+using namespace std;
+using namespace orcus::spreadsheet;
+using namespace orcus::spreadsheet::mock;
+
+namespace {
+
+/**
+ * Records each block setter call as a string.
+ */
+class mock_sheet : public import_sheet
+{
+public:
+    virtual void set_values(row_t row, col_t col, const double* values, size_t n)
+    {
+        ostringstream os;
+        os << "values " << row << ' ' << col << ':';
+        for (size_t i = 0; i < n; ++i)
+            os << ' ' << values[i];
+        m_calls.push_back(os.str());
+    }
+
+    virtual void set_strings(row_t row, col_t col, const size_t* sindices, size_t n)
+    {
+        ostringstream os;
+        os << "strings " << row << ' ' << col << ':';
+        for (size_t i = 0; i < n; ++i)
+            os << ' ' << sindices[i];
+        m_calls.push_back(os.str());
+    }
+
+    virtual void set_bools(row_t row, col_t col, const bool* values, size_t n)
+    {
+        ostringstream os;
+        os << "bools " << row << ' ' << col << ':';
+        for (size_t i = 0; i < n; ++i)
+            os << ' ' << values[i];
+        m_calls.push_back(os.str());
+    }
+
+    const vector<string>& get_calls() const { return m_calls; }
+
+private:
+    vector<string> m_calls;
+};
+
+}
+
+void test_runs()
+{
+    mock_sheet sheet;
+    {
+        sheet_row_buffer buf(&sheet);
+        buf.set_value(0, 0, 1.5);
+        buf.set_value(0, 1, 2.0);
+        buf.set_value(0, 2, 3.0);
+        buf.set_string(0, 3, 10); // different type
+        buf.set_string(0, 4, 11);
+        buf.set_string(0, 6, 12); // gap
+        buf.set_bool(0, 7, true);
+        buf.set_bool(1, 8, false); // different row
+        buf.set_value(1, 9, 4.0);
+        buf.flush();
+        assert(sheet.get_calls().size() == 6);
+
+        buf.set_value(2, 0, 5.0);
+        // The destructor flushes the pending run.
+    }
+
+    const vector<string>& calls = sheet.get_calls();
+    assert(calls.size() == 7);
+    assert(calls[0] == "values 0 0: 1.5 2 3");
+    assert(calls[1] == "strings 0 3: 10 11");
+    assert(calls[2] == "strings 0 6: 12");
+    assert(calls[3] == "bools 0 7: 1");
+    assert(calls[4] == "bools 1 8: 0");
+    assert(calls[5] == "values 1 9: 4");
+    assert(calls[6] == "values 2 0: 5");
+}
+
+void test_long_run()
+{
+    // A long run gets split into several blocks.
+    mock_sheet sheet;
+    sheet_row_buffer buf(&sheet);
+    for (col_t col = 0; col < 1000; ++col)
+        buf.set_value(0, col, col);
+    buf.flush();
+
+    const vector<string>& calls = sheet.get_calls();
+    assert(calls.size() > 1);
+    col_t next_col = 0;
+    for (size_t i = 0; i < calls.size(); ++i)
+    {
+        istringstream is(calls[i]);
+        string type;
+        row_t row;
+        col_t col;
+        char colon;
+        is >> type >> row >> col >> colon;
+        assert(type == "values");
+        assert(col == next_col);
+        double val;
+        for (; is >> val; ++next_col)
+            assert(val == next_col);
+    }
+    assert(next_col == 1000);
+}
+
+void test_set_sheet()
+{
+    mock_sheet sheet1, sheet2;
+    sheet_row_buffer buf(&sheet1);
+    buf.set_value(0, 0, 1.0);
+    buf.set_sheet(&sheet2);
+    buf.set_value(0, 1, 2.0);
+    buf.flush();
+
+    assert(sheet1.get_calls().size() == 1);
+    assert(sheet1.get_calls()[0] == "values 0 0: 1");
+    assert(sheet2.get_calls().size() == 1);
+    assert(sheet2.get_calls()[0] == "values 0 1: 2");
+}
+
+int main()
+{
+    test_runs();
+    test_long_run();
+    test_set_sheet();
+
+    return EXIT_SUCCESS;
+}
@@ -43,10 +43,51 @@ import_sheet_properties* import_sheet::get_sheet_properties()
     return NULL;
 }
 
+void import_sheet::set_values(row_t row, col_t col, const double* values, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+        set_value(row, col + static_cast<col_t>(i), values[i]);
+}
+
+void import_sheet::set_strings(row_t row, col_t col, const size_t* sindices, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+        set_string(row, col + static_cast<col_t>(i), sindices[i]);
+}
+
+void import_sheet::set_bools(row_t row, col_t col, const bool* values, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+        set_bool(row, col + static_cast<col_t>(i), values[i]);
+}
+
+void import_sheet::set_value_range(row_t row1, col_t col1, row_t row2, col_t col2, double value)
+{
+    for (row_t row = row1; row <= row2; ++row)
+        for (col_t col = col1; col <= col2; ++col)
+            set_value(row, col, value);
+}
+
+void import_sheet::set_string_range(row_t row1, col_t col1, row_t row2, col_t col2, size_t sindex)
+{
+    for (row_t row = row1; row <= row2; ++row)
+        for (col_t col = col1; col <= col2; ++col)
+            set_string(row, col, sindex);
+}
+
+void import_sheet::set_format_range(row_t row1, col_t col1, row_t row2, col_t col2, size_t xf_index)
+{
+    for (row_t row = row1; row <= row2; ++row)
+        for (col_t col = col1; col <= col2; ++col)
+            set_format(row, col, xf_index);
+}
+
 import_global_settings::~import_global_settings() {}
 
 import_factory::~import_factory() {}
 
+void import_factory::set_trace(import_trace*) {}
+
 export_sheet::~export_sheet() {}
 
 export_factory::~export_factory() {}
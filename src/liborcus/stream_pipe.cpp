@@ -0,0 +1,124 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+#include "stream_pipe.hpp"
+
+#include "orcus/exception.hpp"
+
+#include <algorithm>
+
+namespace orcus {
+
+namespace {
+
+/**
+ * Number of bytes the producer writes before the parser gets notified.
+ */
+const size_t stream_pipe_segment_size = 65536;
+
+}
+
+stream_pipe::producer::~producer() {}
+
+stream_pipe::stream_pipe(producer& prod, char* buffer, size_t filled, size_t size) :
+    m_producer(prod),
+    mp_buffer(buffer),
+    m_size(size),
+    m_filled(filled),
+    m_done(false),
+    m_cancelled(false)
+{
+    mp_thread.reset(new boost::thread(&stream_pipe::run, this));
+}
+
+stream_pipe::~stream_pipe()
+{
+    {
+        boost::mutex::scoped_lock lock(m_mtx);
+        m_cancelled = true;
+    }
+
+    mp_thread->join();
+}
+
+size_t stream_pipe::fill(size_t size)
+{
+    boost::mutex::scoped_lock lock(m_mtx);
+    while (m_filled <= size && !m_done)
+        m_cond.wait(lock);
+
+    if (m_filled <= size && !m_error.empty())
+        throw general_error(m_error);
+
+    return m_filled;
+}
+
+bool stream_pipe::enabled()
+{
+    return boost::thread::hardware_concurrency() > 1;
+}
+
+void stream_pipe::run()
+{
+    try
+    {
+        // Only this thread modifies m_filled; the lock is needed for
+        // publishing it to the parser.
+        size_t filled = m_filled;
+        while (filled < m_size)
+        {
+            {
+                boost::mutex::scoped_lock lock(m_mtx);
+                if (m_cancelled)
+                    break;
+            }
+
+            size_t n = std::min(stream_pipe_segment_size, m_size - filled);
+            n = m_producer.produce(mp_buffer + filled, n);
+            if (!n)
+                // The stream ended early.
+                break;
+
+            filled += n;
+
+            boost::mutex::scoped_lock lock(m_mtx);
+            m_filled = filled;
+            m_cond.notify_one();
+        }
+    }
+    catch (const std::exception& e)
+    {
+        boost::mutex::scoped_lock lock(m_mtx);
+        m_error = e.what();
+    }
+
+    boost::mutex::scoped_lock lock(m_mtx);
+    m_done = true;
+    m_cond.notify_one();
+}
+
+}
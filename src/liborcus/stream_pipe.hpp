@@ -0,0 +1,124 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+#ifndef __ORCUS_STREAM_PIPE_HPP__
+#define __ORCUS_STREAM_PIPE_HPP__
+
+#include "orcus/sax_parser_base.hpp"
+
+#include <string>
+
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread.hpp>
+
+namespace orcus {
+
+/**
+ * Source that writes the stream into the parser's buffer on a dedicated
+ * thread, so that producing the stream (typically decompressing it) and
+ * parsing it overlap.  The producer writes one segment at a time, and runs
+ * ahead of the parser as far as the buffer goes; the parser only waits when
+ * it catches up with the producer.
+ *
+ * The buffer must be allocated to the full size of the stream up front so
+ * that it never moves while being parsed.
+ */
+class stream_pipe : public sax::stream_source, private boost::noncopyable
+{
+public:
+    /**
+     * Writes the stream, called on the pipe's own thread.
+     */
+    class producer
+    {
+    public:
+        virtual ~producer() = 0;
+
+        /**
+         * Write the next part of the stream.
+         *
+         * @param p position to write to.
+         * @param n maximum number of bytes to write.
+         *
+         * @return number of bytes written.  0 indicates the end of the
+         *         stream.
+         */
+        virtual size_t produce(char* p, size_t n) = 0;
+    };
+
+    /**
+     * Start the producer thread.
+     *
+     * @param prod producer that writes the stream.  It must outlive the
+     *             pipe.
+     * @param buffer buffer to write the stream into.
+     * @param filled number of bytes already in the buffer.
+     * @param size total size of the stream.
+     */
+    stream_pipe(producer& prod, char* buffer, size_t filled, size_t size);
+
+    /**
+     * Stop the producer at the next segment boundary and wait for its
+     * thread to finish.
+     */
+    virtual ~stream_pipe();
+
+    /**
+     * Wait until the producer has written past the given size or has
+     * finished.  An error that the producer has run into is thrown as a
+     * general_error once the parser reaches the point of failure.
+     */
+    virtual size_t fill(size_t size);
+
+    /**
+     * @return true if it is worth running a producer on its own thread on
+     *         this system, that is, if it has more than one hardware
+     *         thread.
+     */
+    static bool enabled();
+
+private:
+    void run();
+
+private:
+    producer& m_producer;
+    char* mp_buffer;
+    size_t m_size;
+    size_t m_filled;
+    std::string m_error;
+    bool m_done:1;
+    bool m_cancelled:1;
+
+    boost::mutex m_mtx;
+    boost::condition_variable m_cond;
+    boost::scoped_ptr<boost::thread> mp_thread;
+};
+
+}
+
+#endif
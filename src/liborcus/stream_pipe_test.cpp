@@ -0,0 +1,181 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+#include "stream_pipe.hpp"
+
+#include "orcus/sax_parser.hpp"
+#include "orcus/exception.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iostream>
+
+using namespace std;
+using namespace orcus;
+
+namespace {
+
+/**
+ * Copies a string into the pipe's buffer a few bytes at a time, optionally
+ * failing at a given position.
+ */
+class string_producer : public stream_pipe::producer
+{
+    const string& m_src;
+    size_t m_pos;
+    size_t m_step;
+    size_t m_fail_pos;
+public:
+    string_producer(const string& src, size_t step, size_t fail_pos = string::npos) :
+        m_src(src), m_pos(0), m_step(step), m_fail_pos(fail_pos) {}
+
+    virtual size_t produce(char* p, size_t n)
+    {
+        if (m_pos >= m_fail_pos)
+            throw general_error("producer failed.");
+
+        n = min(n, min(m_step, m_src.size() - m_pos));
+        memcpy(p, &m_src[m_pos], n);
+        m_pos += n;
+        return n;
+    }
+
+    size_t pos() const { return m_pos; }
+};
+
+class counting_handler
+{
+    size_t m_elem_count;
+    size_t m_char_bytes;
+public:
+    counting_handler() : m_elem_count(0), m_char_bytes(0) {}
+
+    void doctype(const sax::doctype_declaration&) {}
+    void start_declaration(const pstring&) {}
+    void end_declaration(const pstring&) {}
+    void start_element(const sax::parser_element&) { ++m_elem_count; }
+    void end_element(const sax::parser_element&) {}
+    void characters(const pstring& val, bool) { m_char_bytes += val.size(); }
+    void attribute(const sax::parser_attribute&) {}
+
+    size_t elem_count() const { return m_elem_count; }
+    size_t char_bytes() const { return m_char_bytes; }
+};
+
+string make_stream(size_t elem_count)
+{
+    ostringstream os;
+    os << "<?xml version=\"1.0\"?><r>";
+    for (size_t i = 0; i < elem_count; ++i)
+        os << "<c a=\"" << i << "\">" << (i * 7) << "</c>";
+    os << "</r>";
+    return os.str();
+}
+
+}
+
+void test_parse_through_pipe()
+{
+    const size_t elem_count = 50000;
+    string strm = make_stream(elem_count);
+
+    size_t steps[] = { 1, 7, 4096, 100000 };
+    for (size_t i = 0; i < sizeof(steps)/sizeof(steps[0]); ++i)
+    {
+        vector<char> buffer(strm.size()+1, '\0');
+        string_producer producer(strm, steps[i]);
+        stream_pipe pipe(producer, &buffer[0], 0, strm.size());
+        counting_handler hdl;
+        sax_parser<counting_handler> parser(&buffer[0], 0, pipe, hdl);
+        parser.parse();
+
+        assert(hdl.elem_count() == elem_count + 1);
+        assert(string(&buffer[0], strm.size()) == strm);
+    }
+}
+
+void test_producer_error()
+{
+    string strm = make_stream(1000);
+    vector<char> buffer(strm.size()+1, '\0');
+    string_producer producer(strm, 100, 5000);
+    stream_pipe pipe(producer, &buffer[0], 0, strm.size());
+    counting_handler hdl;
+    sax_parser<counting_handler> parser(&buffer[0], 0, pipe, hdl);
+    try
+    {
+        parser.parse();
+        assert(!"general_error was not thrown.");
+    }
+    catch (const general_error& e)
+    {
+        cout << "expected error: " << e.what() << endl;
+    }
+
+    // Everything before the point of failure has been parsed.
+    assert(hdl.elem_count() > 0);
+}
+
+void test_short_stream()
+{
+    // The producer ends before reaching the declared size.  The parser sees
+    // the end of the stream there.
+    string strm = "<?xml version=\"1.0\"?><r><c>1</c></r>";
+    vector<char> buffer(strm.size()+100, '\0');
+    string_producer producer(strm, 3);
+    stream_pipe pipe(producer, &buffer[0], 0, strm.size()+99);
+    counting_handler hdl;
+    sax_parser<counting_handler> parser(&buffer[0], 0, pipe, hdl);
+    parser.parse();
+    assert(hdl.elem_count() == 2);
+}
+
+void test_early_destruction()
+{
+    // Destroying the pipe before the stream is consumed stops the producer.
+    string strm = make_stream(100000);
+    vector<char> buffer(strm.size()+1, '\0');
+    string_producer producer(strm, 1);
+    {
+        stream_pipe pipe(producer, &buffer[0], 0, strm.size());
+        assert(pipe.fill(0) > 0);
+    }
+    assert(producer.pos() <= strm.size());
+}
+
+int main()
+{
+    test_parse_through_pipe();
+    test_producer_error();
+    test_short_stream();
+    test_early_destruction();
+    return EXIT_SUCCESS;
+}
@@ -28,13 +28,74 @@
 #include "orcus/tokens.hpp"
 #include "orcus/pstring.hpp"
 
+#include <cstring>
+
+#include <boost/cstdint.hpp>
+
 using namespace std;
 
 namespace orcus {
 
+namespace {
+
+using boost::uint32_t;
+using boost::uint64_t;
+
+/**
+ * The hash functions below must be kept in sync with the ones in
+ * misc/token_util.py, which generates the perfect hash tables.
+ */
+inline uint32_t hash_mix(uint32_t h)
+{
+    h ^= h >> 16;
+    h *= 0x7FEB352D;
+    h ^= h >> 15;
+    h *= 0x846CA68B;
+    h ^= h >> 16;
+    return h;
+}
+
+uint32_t hash_token_name(const char* p, size_t n)
+{
+    const unsigned char* u = reinterpret_cast<const unsigned char*>(p);
+    uint32_t h = static_cast<uint32_t>(n) * 0x9E3779B1;
+
+    // Consume 4 bytes at a time in little endian order.
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        uint32_t w = u[i] | (u[i+1] << 8) | (u[i+2] << 16) | (static_cast<uint32_t>(u[i+3]) << 24);
+        h = (h ^ w) * 0x85EBCA6B;
+        h ^= h >> 13;
+    }
+
+    if (i < n)
+    {
+        uint32_t w = 0;
+        for (size_t j = 0; i < n; ++i, j += 8)
+            w |= static_cast<uint32_t>(u[i]) << j;
+
+        h = (h ^ w) * 0x85EBCA6B;
+        h ^= h >> 13;
+    }
+
+    return hash_mix(h);
+}
+
+/**
+ * Map a 32-bit hash value onto [0, n) without a division.
+ */
+inline size_t hash_range(uint32_t h, size_t n)
+{
+    return static_cast<size_t>((static_cast<uint64_t>(h) * n) >> 32);
+}
+
+}
+
 tokens::tokens(const char** token_names, size_t token_name_count) :
-    m_token_names(token_names), 
-    m_token_name_count(token_name_count)
+    m_token_names(token_names),
+    m_token_name_count(token_name_count),
+    mp_hash_table(NULL)
 {
     for (size_t i = 0; i < m_token_name_count; ++i)
     {
@@ -44,6 +105,13 @@ tokens::tokens(const char** token_names, size_t token_name_count) :
     }
 }
 
+tokens::tokens(const char** token_names, size_t token_name_count, const token_hash_table& hash_table) :
+    m_token_names(token_names),
+    m_token_name_count(token_name_count),
+    mp_hash_table(&hash_table)
+{
+}
+
 bool tokens::is_valid_token(xml_token_t token) const
 {
     return token != XML_UNKNOWN_TOKEN;
@@ -51,6 +119,26 @@ bool tokens::is_valid_token(xml_token_t token) const
 
 xml_token_t tokens::get_token(const pstring& name) const
 {
+    if (mp_hash_table)
+    {
+        const token_hash_table& ht = *mp_hash_table;
+        if (!ht.slot_count)
+            return XML_UNKNOWN_TOKEN;
+
+        uint32_t h = hash_token_name(name.get(), name.size());
+        uint32_t d = ht.displacements[hash_range(h, ht.bucket_count)];
+        xml_token_t token = ht.slots[hash_range(hash_mix(h ^ d), ht.slot_count)];
+
+        // The slot may hold a different token when the name is not one of
+        // the tokens.  Compare the lengths first, as the name may contain
+        // a null character and be longer than the stored name.
+        const char* p = m_token_names[token];
+        if (strlen(p) != name.size() || memcmp(p, name.get(), name.size()))
+            return XML_UNKNOWN_TOKEN;
+
+        return token;
+    }
+
     token_map_type::const_iterator itr = m_tokens.find(name);
     if (itr == m_tokens.end())
         return XML_UNKNOWN_TOKEN;
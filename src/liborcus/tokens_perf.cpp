@@ -0,0 +1,119 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+#include "orcus/tokens.hpp"
+#include "orcus/pstring.hpp"
+#include "orcus/parser_global.hpp"
+
+#include "ooxml_tokens.hpp"
+#include "odf_tokens.hpp"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <iostream>
+
+using namespace std;
+using namespace orcus;
+
+namespace {
+
+const size_t lookup_count = 20000000;
+
+/**
+ * Look up the names in a round-robin fashion, and report the number of
+ * lookups per second.
+ */
+void run(const string& label, const tokens& tks, const vector<pstring>& names)
+{
+    size_t found = 0;
+    double start = get_current_time();
+    for (size_t i = 0, j = 0; i < lookup_count; ++i, ++j)
+    {
+        if (j == names.size())
+            j = 0;
+
+        if (tks.get_token(names[j]) != XML_UNKNOWN_TOKEN)
+            ++found;
+    }
+    double duration = get_current_time() - start;
+
+    cout << label << ": " << (lookup_count / duration / 1000000.0) << " million lookups/s"
+        << " (" << found << " found)" << endl;
+}
+
+void run_token_set(const string& label, const tokens& tks, const char** typical_names)
+{
+    // Build the same token set without the perfect hash table, to compare
+    // it against the hash map lookup.
+    vector<const char*> token_names(1, "??");
+    for (const char* p = tks.get_token_name(1); *p; p = tks.get_token_name(token_names.size()))
+        token_names.push_back(p);
+
+    tokens map_tks(&token_names[0], token_names.size());
+
+    // All token names, plus the same number of names that are not tokens.
+    vector<string> buf;
+    buf.reserve(token_names.size() * 2);
+    for (size_t i = 1; i < token_names.size(); ++i)
+    {
+        buf.push_back(token_names[i]);
+        buf.push_back(string(token_names[i]) + "_");
+    }
+
+    vector<pstring> all_names;
+    for (size_t i = 0; i < buf.size(); ++i)
+        all_names.push_back(pstring(buf[i].c_str(), buf[i].size()));
+
+    // Names that occur the most often in actual documents.
+    vector<pstring> hot_names;
+    for (; *typical_names; ++typical_names)
+        hot_names.push_back(pstring(*typical_names));
+
+    run(label + " all names (hash map)", map_tks, all_names);
+    run(label + " all names (perfect hash)", tks, all_names);
+    run(label + " typical names (hash map)", map_tks, hot_names);
+    run(label + " typical names (perfect hash)", tks, hot_names);
+}
+
+const char* typical_ooxml_names[] = {
+    "row", "c", "r", "s", "t", "v", "f", "spans", "ht", "customHeight", NULL
+};
+
+const char* typical_odf_names[] = {
+    "table-row", "table-cell", "p", "style-name", "value-type", "value",
+    "number-columns-repeated", "formula", NULL
+};
+
+}
+
+int main()
+{
+    run_token_set("ooxml", ooxml_tokens, typical_ooxml_names);
+    run_token_set("odf", odf_tokens, typical_odf_names);
+    return EXIT_SUCCESS;
+}
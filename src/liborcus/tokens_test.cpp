@@ -0,0 +1,113 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+#include <cstdlib>
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <set>
+
+#include "orcus/tokens.hpp"
+#include "orcus/pstring.hpp"
+
+#include "ooxml_tokens.hpp"
+#include "odf_tokens.hpp"
+#include "gnumeric_tokens.hpp"
+#include "xls_xml_tokens.hpp"
+
+using namespace std;
+using namespace orcus;
+
+namespace {
+
+struct token_set
+{
+    const char* name;
+    const tokens* tks;
+};
+
+const token_set token_sets[] = {
+    { "ooxml", &ooxml_tokens },
+    { "opc", &opc_tokens },
+    { "odf", &odf_tokens },
+    { "gnumeric", &gnumeric_tokens },
+    { "xls-xml", &xls_xml_tokens },
+};
+
+}
+
+void test_perfect_hash()
+{
+    for (size_t i = 0; i < sizeof(token_sets)/sizeof(token_sets[0]); ++i)
+    {
+        const tokens& tks = *token_sets[i].tks;
+
+        // Every token name must map back to its own token value.
+        set<string> names;
+        xml_token_t token = 1;
+        for (const char* p = tks.get_token_name(token); *p; p = tks.get_token_name(++token))
+        {
+            assert(tks.get_token(pstring(p)) == token);
+            names.insert(p);
+        }
+
+        cout << token_sets[i].name << ": " << names.size() << " tokens" << endl;
+        assert(!names.empty());
+
+        // Names that are not tokens must not be mistaken for one, including
+        // ones that differ from a token only by their last character.
+        assert(tks.get_token(pstring()) == XML_UNKNOWN_TOKEN);
+        assert(tks.get_token(pstring("??")) == XML_UNKNOWN_TOKEN);
+        assert(tks.get_token(pstring("no-such-token")) == XML_UNKNOWN_TOKEN);
+
+        set<string>::const_iterator it = names.begin(), it_end = names.end();
+        for (; it != it_end; ++it)
+        {
+            string s = *it + "x";
+            if (!names.count(s))
+                assert(tks.get_token(pstring(s.c_str())) == XML_UNKNOWN_TOKEN);
+
+            s = it->substr(0, it->size()-1);
+            if (!names.count(s))
+                assert(tks.get_token(pstring(s.c_str())) == XML_UNKNOWN_TOKEN);
+
+            // A token name followed by a null character is not the token.
+            s = *it;
+            s.push_back('\0');
+            assert(tks.get_token(pstring(s.data(), s.size())) == XML_UNKNOWN_TOKEN);
+            s.push_back('x');
+            assert(tks.get_token(pstring(s.data(), s.size())) == XML_UNKNOWN_TOKEN);
+        }
+    }
+}
+
+int main()
+{
+    test_perfect_hash();
+    return EXIT_SUCCESS;
+}
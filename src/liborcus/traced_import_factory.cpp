@@ -0,0 +1,282 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+
+#include "traced_import_factory.hpp"
+
+#include "orcus/import_trace.hpp"
+
+namespace orcus {
+
+namespace {
+
+size_t range_size(spreadsheet::row_t row1, spreadsheet::col_t col1, spreadsheet::row_t row2, spreadsheet::col_t col2)
+{
+    if (row2 < row1 || col2 < col1)
+        return 0;
+
+    return static_cast<size_t>(row2 - row1 + 1) * static_cast<size_t>(col2 - col1 + 1);
+}
+
+}
+
+/**
+ * Sheet that passes all calls on to another sheet, and counts the cells
+ * it receives on the trace.
+ */
+class traced_import_sheet : public spreadsheet::iface::import_sheet
+{
+    spreadsheet::iface::import_sheet& m_sheet;
+    import_trace& m_trace;
+
+public:
+    traced_import_sheet(spreadsheet::iface::import_sheet& sheet, import_trace& trace) :
+        m_sheet(sheet), m_trace(trace) {}
+
+    virtual ~traced_import_sheet() {}
+
+    spreadsheet::iface::import_sheet* get_target() { return &m_sheet; }
+
+    virtual spreadsheet::iface::import_sheet_properties* get_sheet_properties()
+    {
+        return m_sheet.get_sheet_properties();
+    }
+
+    virtual void set_auto(spreadsheet::row_t row, spreadsheet::col_t col, const char* p, size_t n)
+    {
+        m_trace.add_cells(1);
+        m_sheet.set_auto(row, col, p, n);
+    }
+
+    virtual void set_string(spreadsheet::row_t row, spreadsheet::col_t col, size_t sindex)
+    {
+        m_trace.add_cells(1);
+        m_sheet.set_string(row, col, sindex);
+    }
+
+    virtual void set_value(spreadsheet::row_t row, spreadsheet::col_t col, double value)
+    {
+        m_trace.add_cells(1);
+        m_sheet.set_value(row, col, value);
+    }
+
+    virtual void set_bool(spreadsheet::row_t row, spreadsheet::col_t col, bool value)
+    {
+        m_trace.add_cells(1);
+        m_sheet.set_bool(row, col, value);
+    }
+
+    virtual void set_values(spreadsheet::row_t row, spreadsheet::col_t col, const double* values, size_t n)
+    {
+        m_trace.add_cells(n);
+        m_sheet.set_values(row, col, values, n);
+    }
+
+    virtual void set_strings(spreadsheet::row_t row, spreadsheet::col_t col, const size_t* sindices, size_t n)
+    {
+        m_trace.add_cells(n);
+        m_sheet.set_strings(row, col, sindices, n);
+    }
+
+    virtual void set_bools(spreadsheet::row_t row, spreadsheet::col_t col, const bool* values, size_t n)
+    {
+        m_trace.add_cells(n);
+        m_sheet.set_bools(row, col, values, n);
+    }
+
+    virtual void set_value_range(
+        spreadsheet::row_t row1, spreadsheet::col_t col1,
+        spreadsheet::row_t row2, spreadsheet::col_t col2, double value)
+    {
+        m_trace.add_cells(range_size(row1, col1, row2, col2));
+        m_sheet.set_value_range(row1, col1, row2, col2, value);
+    }
+
+    virtual void set_string_range(
+        spreadsheet::row_t row1, spreadsheet::col_t col1,
+        spreadsheet::row_t row2, spreadsheet::col_t col2, size_t sindex)
+    {
+        m_trace.add_cells(range_size(row1, col1, row2, col2));
+        m_sheet.set_string_range(row1, col1, row2, col2, sindex);
+    }
+
+    virtual void set_date_time(
+        spreadsheet::row_t row, spreadsheet::col_t col,
+        int year, int month, int day, int hour, int minute, double second)
+    {
+        m_trace.add_cells(1);
+        m_sheet.set_date_time(row, col, year, month, day, hour, minute, second);
+    }
+
+    virtual void set_format(spreadsheet::row_t row, spreadsheet::col_t col, size_t xf_index)
+    {
+        m_sheet.set_format(row, col, xf_index);
+    }
+
+    virtual void set_format_range(
+        spreadsheet::row_t row1, spreadsheet::col_t col1,
+        spreadsheet::row_t row2, spreadsheet::col_t col2, size_t xf_index)
+    {
+        m_sheet.set_format_range(row1, col1, row2, col2, xf_index);
+    }
+
+    virtual void set_formula(
+        spreadsheet::row_t row, spreadsheet::col_t col, spreadsheet::formula_grammar_t grammar,
+        const char* p, size_t n)
+    {
+        m_trace.add_cells(1);
+        m_sheet.set_formula(row, col, grammar, p, n);
+    }
+
+    virtual void set_shared_formula(
+        spreadsheet::row_t row, spreadsheet::col_t col, spreadsheet::formula_grammar_t grammar,
+        size_t sindex, const char* p_formula, size_t n_formula, const char* p_range, size_t n_range)
+    {
+        m_trace.add_cells(1);
+        m_sheet.set_shared_formula(row, col, grammar, sindex, p_formula, n_formula, p_range, n_range);
+    }
+
+    virtual void set_shared_formula(
+        spreadsheet::row_t row, spreadsheet::col_t col, spreadsheet::formula_grammar_t grammar,
+        size_t sindex, const char* p_formula, size_t n_formula)
+    {
+        m_trace.add_cells(1);
+        m_sheet.set_shared_formula(row, col, grammar, sindex, p_formula, n_formula);
+    }
+
+    virtual void set_shared_formula(spreadsheet::row_t row, spreadsheet::col_t col, size_t sindex)
+    {
+        m_trace.add_cells(1);
+        m_sheet.set_shared_formula(row, col, sindex);
+    }
+
+    virtual void set_formula_result(spreadsheet::row_t row, spreadsheet::col_t col, const char* p, size_t n)
+    {
+        m_sheet.set_formula_result(row, col, p, n);
+    }
+
+    virtual void set_array_formula(
+        spreadsheet::row_t row, spreadsheet::col_t col, spreadsheet::formula_grammar_t grammar,
+        const char* p, size_t n, spreadsheet::row_t array_rows, spreadsheet::col_t array_cols)
+    {
+        m_trace.add_cells(1);
+        m_sheet.set_array_formula(row, col, grammar, p, n, array_rows, array_cols);
+    }
+
+    virtual void set_array_formula(
+        spreadsheet::row_t row, spreadsheet::col_t col, spreadsheet::formula_grammar_t grammar,
+        const char* p, size_t n, const char* p_range, size_t n_range)
+    {
+        m_trace.add_cells(1);
+        m_sheet.set_array_formula(row, col, grammar, p, n, p_range, n_range);
+    }
+};
+
+traced_import_factory::traced_import_factory(spreadsheet::iface::import_factory& factory, import_trace& trace) :
+    m_factory(factory), m_trace(trace) {}
+
+traced_import_factory::~traced_import_factory()
+{
+    for (size_t i = 0; i < m_sheets.size(); ++i)
+        delete m_sheets[i];
+}
+
+spreadsheet::iface::import_global_settings* traced_import_factory::get_global_settings()
+{
+    return m_factory.get_global_settings();
+}
+
+spreadsheet::iface::import_shared_strings* traced_import_factory::get_shared_strings()
+{
+    return m_factory.get_shared_strings();
+}
+
+spreadsheet::iface::import_styles* traced_import_factory::get_styles()
+{
+    return m_factory.get_styles();
+}
+
+spreadsheet::iface::import_sheet* traced_import_factory::append_sheet(const char* sheet_name, size_t sheet_name_length)
+{
+    return wrap_sheet(m_factory.append_sheet(sheet_name, sheet_name_length));
+}
+
+spreadsheet::iface::import_sheet* traced_import_factory::get_sheet(const char* sheet_name, size_t sheet_name_length)
+{
+    return wrap_sheet(m_factory.get_sheet(sheet_name, sheet_name_length));
+}
+
+void traced_import_factory::finalize()
+{
+    trace_scope scope(&m_trace, trace_phase_finalize, "finalize");
+    m_factory.finalize();
+}
+
+void traced_import_factory::set_trace(import_trace* trace)
+{
+    m_factory.set_trace(trace);
+}
+
+spreadsheet::iface::import_sheet* traced_import_factory::wrap_sheet(spreadsheet::iface::import_sheet* sheet)
+{
+    if (!sheet)
+        return NULL;
+
+    // A sheet may be requested more than once; always hand out the same
+    // wrapper for it.
+    for (size_t i = 0; i < m_sheets.size(); ++i)
+    {
+        if (m_sheets[i]->get_target() == sheet)
+            return m_sheets[i];
+    }
+
+    m_sheets.push_back(new traced_import_sheet(*sheet, m_trace));
+    return m_sheets.back();
+}
+
+import_trace_guard::import_trace_guard(spreadsheet::iface::import_factory*& factory, import_trace* trace) :
+    mp_factory(factory), mp_original(factory), mp_traced(NULL)
+{
+    if (!trace || !mp_original)
+        return;
+
+    mp_traced = new traced_import_factory(*mp_original, *trace);
+    mp_original->set_trace(trace);
+    mp_factory = mp_traced;
+}
+
+import_trace_guard::~import_trace_guard()
+{
+    if (!mp_traced)
+        return;
+
+    mp_original->set_trace(NULL);
+    mp_factory = mp_original;
+    delete mp_traced;
+}
+
+}
@@ -0,0 +1,92 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+
+#ifndef ORCUS_TRACED_IMPORT_FACTORY_HPP
+#define ORCUS_TRACED_IMPORT_FACTORY_HPP
+
+#include "orcus/spreadsheet/import_interface.hpp"
+
+#include <vector>
+
+namespace orcus {
+
+class import_trace;
+class traced_import_sheet;
+
+/**
+ * Import factory implementation that passes all calls on to another
+ * factory, and counts on the trace the cells that get inserted into its
+ * sheets.  Filters only put it in front of the client's factory while a
+ * trace is set, so that the counting costs nothing otherwise.
+ */
+class traced_import_factory : public spreadsheet::iface::import_factory
+{
+    spreadsheet::iface::import_factory& m_factory;
+    import_trace& m_trace;
+    std::vector<traced_import_sheet*> m_sheets;
+
+public:
+    traced_import_factory(spreadsheet::iface::import_factory& factory, import_trace& trace);
+    virtual ~traced_import_factory();
+
+    virtual spreadsheet::iface::import_global_settings* get_global_settings();
+    virtual spreadsheet::iface::import_shared_strings* get_shared_strings();
+    virtual spreadsheet::iface::import_styles* get_styles();
+    virtual spreadsheet::iface::import_sheet* append_sheet(const char* sheet_name, size_t sheet_name_length);
+    virtual spreadsheet::iface::import_sheet* get_sheet(const char* sheet_name, size_t sheet_name_length);
+    virtual void finalize();
+    virtual void set_trace(import_trace* trace);
+
+private:
+    spreadsheet::iface::import_sheet* wrap_sheet(spreadsheet::iface::import_sheet* sheet);
+};
+
+/**
+ * Attaches a trace to the factory of a filter for the duration of an
+ * import.  When the trace is set, the filter's factory pointer gets
+ * replaced by a traced_import_factory in front of the original factory,
+ * and the original factory is given the trace.  Both are restored on
+ * destruction.
+ */
+class import_trace_guard
+{
+    spreadsheet::iface::import_factory*& mp_factory;
+    spreadsheet::iface::import_factory* mp_original;
+    traced_import_factory* mp_traced;
+
+    import_trace_guard(const import_trace_guard&); // disabled
+    import_trace_guard& operator= (const import_trace_guard&); // disabled
+
+public:
+    import_trace_guard(spreadsheet::iface::import_factory*& factory, import_trace* trace);
+    ~import_trace_guard();
+};
+
+}
+
+#endif
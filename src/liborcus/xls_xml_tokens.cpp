@@ -35,6 +35,6 @@ namespace {
 
 }
 
-tokens xls_xml_tokens = tokens(token_names, token_name_count);
+tokens xls_xml_tokens = tokens(token_names, token_name_count, token_hash);
 
 }
@@ -988,3 +988,167 @@ const char* token_names[] = {
 
 size_t token_name_count = 983;
 
+const unsigned int token_hash_displacements[] = {
+    53, 103, 3, 90, 250, 9, 3, 1,
+    0, 3, 25, 11, 25, 124, 18, 4,
+    5, 0, 23, 14, 10, 40, 37, 59,
+    34, 0, 1, 37, 30, 107, 2, 203,
+    46, 7, 3, 0, 3, 24, 0, 62,
+    240, 43, 10, 373, 21, 0, 98, 1,
+    539, 81, 43, 81, 31, 34, 84, 31,
+    140, 0, 0, 9, 0, 44, 22, 0,
+    1, 2, 0, 63, 13, 4, 36, 241,
+    139, 2, 61, 32, 105, 29, 0, 15,
+    2, 796, 120, 40, 7, 2, 184, 150,
+    169, 15, 74, 42, 66, 4, 3, 5,
+    32, 0, 594, 99, 27, 282, 0, 5,
+    222, 370, 116, 297, 549, 4, 15, 2426,
+    10, 1667, 44, 227, 571, 43, 313, 75,
+    27, 0, 10, 0, 111, 9, 3, 2,
+    908, 12, 2, 386, 990, 480, 0, 1,
+    88, 162, 368, 24, 39, 0, 85, 296,
+    72, 0, 1, 3, 795, 1, 31, 201,
+    658, 557, 69, 0, 13, 1, 7, 71,
+    0, 82, 0, 10, 87, 1, 0, 1643,
+    33, 70, 1141, 2, 1094, 0, 17, 20,
+    82, 165, 56, 4, 36, 279, 206, 1823,
+    1321, 29, 363, 2152, 128, 0, 3, 346,
+    241, 0, 219, 1, 8850, 9, 18, 107,
+    11, 44, 4, 609, 328, 28, 68, 0,
+    0, 519, 38, 501, 167, 0, 1895, 118,
+    166, 49, 878, 50, 241, 113, 79, 35,
+    218, 818, 39, 180, 683, 13, 211, 829,
+    1203, 2, 2157, 10, 2978, 60, 1, 138,
+    0, 1573, 0, 282, 1891, 1,
+};
+
+const xml_token_t token_hash_slots[] = {
+    792, 242, 825, 534, 623, 726, 342, 704,
+    447, 334, 713, 972, 687, 882, 952, 210,
+    49, 788, 745, 562, 192, 81, 673, 50,
+    278, 301, 498, 315, 865, 28, 798, 226,
+    399, 217, 902, 423, 58, 660, 32, 408,
+    273, 302, 355, 906, 837, 845, 546, 648,
+    151, 572, 165, 904, 744, 83, 122, 846,
+    215, 136, 341, 74, 52, 10, 564, 289,
+    352, 347, 859, 276, 435, 547, 87, 394,
+    317, 195, 39, 593, 37, 740, 132, 674,
+    93, 815, 876, 476, 531, 539, 104, 96,
+    202, 1, 340, 287, 643, 622, 559, 816,
+    376, 520, 193, 139, 667, 62, 927, 809,
+    796, 366, 785, 699, 221, 138, 766, 543,
+    118, 970, 91, 967, 171, 173, 962, 29,
+    156, 774, 494, 458, 621, 178, 965, 349,
+    131, 472, 878, 680, 717, 495, 771, 592,
+    907, 848, 871, 370, 526, 146, 362, 595,
+    354, 474, 540, 5, 776, 753, 393, 784,
+    880, 33, 538, 331, 527, 701, 913, 812,
+    386, 179, 515, 452, 777, 647, 747, 937,
+    496, 16, 198, 404, 923, 508, 610, 170,
+    504, 353, 649, 383, 735, 257, 614, 148,
+    218, 959, 76, 222, 150, 734, 322, 121,
+    814, 262, 654, 60, 715, 53, 805, 755,
+    206, 767, 536, 803, 795, 469, 350, 313,
+    681, 781, 391, 280, 541, 633, 259, 560,
+    549, 48, 78, 561, 327, 141, 553, 582,
+    511, 392, 161, 686, 659, 102, 196, 424,
+    802, 453, 477, 925, 892, 441, 18, 253,
+    208, 951, 312, 510, 112, 189, 544, 852,
+    640, 884, 339, 619, 225, 292, 706, 205,
+    361, 636, 895, 223, 551, 966, 867, 601,
+    521, 548, 401, 134, 661, 509, 184, 773,
+    418, 294, 92, 369, 690, 201, 421, 961,
+    525, 88, 443, 56, 956, 411, 346, 861,
+    482, 577, 389, 752, 948, 351, 863, 829,
+    316, 924, 518, 188, 429, 665, 501, 950,
+    110, 835, 694, 388, 8, 360, 624, 710,
+    64, 707, 153, 499, 638, 140, 159, 284,
+    691, 116, 400, 889, 900, 211, 960, 77,
+    103, 163, 934, 733, 80, 697, 682, 246,
+    438, 580, 513, 746, 254, 42, 570, 252,
+    926, 445, 931, 416, 599, 420, 851, 791,
+    24, 465, 98, 646, 630, 688, 500, 634,
+    834, 912, 21, 381, 274, 281, 143, 596,
+    671, 68, 635, 439, 491, 783, 868, 34,
+    235, 463, 460, 99, 827, 822, 920, 957,
+    727, 236, 588, 849, 789, 382, 105, 708,
+    693, 813, 69, 799, 61, 874, 390, 955,
+    419, 862, 794, 714, 830, 417, 808, 359,
+    840, 348, 922, 945, 264, 364, 109, 969,
+    6, 602, 155, 41, 709, 749, 473, 384,
+    684, 213, 899, 410, 490, 916, 263, 335,
+    765, 677, 928, 743, 245, 40, 567, 480,
+    978, 100, 337, 324, 283, 204, 804, 732,
+    318, 626, 466, 321, 954, 533, 464, 308,
+    711, 573, 758, 977, 976, 135, 718, 589,
+    611, 903, 403, 365, 616, 329, 85, 405,
+    678, 379, 310, 720, 762, 459, 268, 522,
+    763, 3, 736, 303, 328, 893, 396, 716,
+    909, 479, 446, 506, 652, 980, 658, 811,
+    483, 568, 11, 332, 481, 22, 579, 730,
+    412, 72, 807, 149, 101, 97, 860, 615,
+    7, 780, 712, 557, 847, 120, 751, 467,
+    600, 137, 345, 938, 641, 581, 670, 214,
+    933, 779, 757, 901, 627, 25, 502, 183,
+    529, 642, 231, 651, 397, 107, 203, 229,
+    883, 20, 819, 594, 587, 908, 47, 514,
+    45, 451, 450, 232, 66, 300, 793, 220,
+    406, 958, 216, 722, 267, 949, 444, 478,
+    31, 207, 266, 23, 528, 323, 857, 919,
+    67, 764, 147, 128, 363, 57, 971, 820,
+    778, 158, 59, 833, 632, 436, 725, 279,
+    113, 644, 770, 26, 437, 929, 470, 516,
+    219, 737, 319, 832, 106, 910, 194, 427,
+    255, 731, 896, 911, 606, 979, 689, 838,
+    357, 177, 387, 307, 239, 575, 782, 297,
+    953, 71, 94, 941, 620, 251, 185, 333,
+    935, 19, 668, 574, 885, 126, 917, 398,
+    442, 585, 385, 864, 290, 605, 186, 569,
+    942, 243, 108, 590, 844, 656, 4, 448,
+    698, 947, 434, 402, 512, 639, 356, 157,
+    591, 343, 842, 440, 133, 89, 212, 724,
+    86, 17, 265, 114, 891, 946, 578, 964,
+    818, 879, 739, 930, 872, 338, 306, 314,
+    944, 769, 82, 530, 897, 940, 505, 164,
+    484, 655, 894, 532, 375, 241, 609, 679,
+    462, 692, 79, 190, 30, 368, 456, 742,
+    806, 144, 768, 12, 545, 46, 286, 738,
+    939, 597, 748, 584, 657, 371, 44, 15,
+    244, 968, 787, 168, 160, 293, 367, 963,
+    247, 760, 35, 703, 330, 461, 650, 454,
+    637, 145, 723, 801, 915, 117, 169, 296,
+    702, 586, 475, 625, 320, 63, 209, 309,
+    695, 256, 854, 489, 75, 669, 154, 336,
+    552, 432, 285, 27, 843, 249, 167, 43,
+    921, 471, 326, 275, 127, 65, 576, 974,
+    258, 556, 800, 675, 90, 645, 936, 759,
+    821, 877, 395, 555, 378, 197, 705, 583,
+    631, 817, 875, 841, 372, 613, 662, 973,
+    497, 227, 890, 672, 426, 839, 277, 433,
+    180, 129, 873, 831, 700, 898, 629, 230,
+    750, 237, 756, 250, 503, 664, 14, 51,
+    181, 810, 870, 73, 111, 115, 455, 428,
+    425, 598, 858, 344, 125, 617, 228, 248,
+    696, 828, 869, 70, 162, 887, 918, 291,
+    130, 233, 374, 457, 172, 565, 666, 728,
+    772, 826, 270, 914, 604, 866, 13, 554,
+    407, 653, 608, 54, 612, 234, 422, 850,
+    36, 603, 537, 492, 415, 238, 982, 200,
+    55, 409, 298, 721, 380, 797, 187, 881,
+    124, 790, 823, 175, 176, 663, 325, 855,
+    975, 535, 507, 886, 377, 943, 729, 271,
+    786, 299, 295, 563, 566, 119, 304, 741,
+    685, 524, 2, 853, 488, 123, 836, 493,
+    191, 888, 517, 84, 282, 358, 311, 683,
+    754, 142, 856, 485, 414, 152, 95, 905,
+    224, 269, 9, 449, 272, 240, 775, 719,
+    431, 558, 571, 824, 550, 519, 628, 618,
+    413, 523, 373, 607, 305, 981, 182, 261,
+    166, 199, 487, 260, 761, 676, 174, 932,
+    288, 486, 542, 38, 430, 468,
+};
+
+const token_hash_table token_hash = {
+    token_hash_displacements, 246, token_hash_slots, 982
+};
+
@@ -34,6 +34,7 @@
 #include "xml_context_global.hpp"
 
 #include "orcus/global.hpp"
+#include "orcus/measurement.hpp"
 #include "orcus/tokens.hpp"
 #include "orcus/spreadsheet/import_interface.hpp"
 
@@ -60,10 +61,10 @@ public:
         switch (attr.name)
         {
             case XML_count:
-                m_count = strtoul(attr.value.get(), NULL, 10);
+                m_count = to_long(attr.value);
             break;
             case XML_uniqueCount:
-                m_unique_count = strtoul(attr.value.get(), NULL, 10);
+                m_unique_count = to_long(attr.value);
             break;
         }
     }
@@ -147,7 +148,7 @@ void xlsx_shared_strings_context::start_element(xmlns_id_t ns, xml_token_t name,
             // font size
             xml_element_expected(parent, NS_ooxml_xlsx, XML_rPr);
             pstring s = for_each(attrs.begin(), attrs.end(), single_attr_getter(m_pool, NS_ooxml_xlsx, XML_val)).get_value();
-            double point = strtod(s.get(), NULL);
+            double point = to_double(s);
             mp_strings->set_segment_font_size(point);
         }
         break;
@@ -182,6 +183,8 @@ void xlsx_shared_strings_context::start_element(xmlns_id_t ns, xml_token_t name,
         break;
         default:
             warn_unhandled();
+            // e.g. phonetic runs, whose text must not end up in the string.
+            skip_subtree();
     }
 }
 
@@ -262,13 +265,13 @@ public:
             break;
             case XML_xfId:
             {
-                size_t n = strtoul(attr.value.get(), NULL, 10);
+                size_t n = to_long(attr.value);
                 m_styles.set_cell_style_xf(n);
             }
             break;
             case XML_builtinId:
             {
-                size_t n = strtoul(attr.value.get(), NULL, 10);
+                size_t n = to_long(attr.value);
                 m_styles.set_cell_style_builtin(n);
             }
             break;
@@ -289,31 +292,31 @@ public:
         {
             case XML_borderId:
             {
-                size_t n = strtoul(attr.value.get(), NULL, 10);
+                size_t n = to_long(attr.value);
                 m_styles.set_xf_border(n);
             }
             break;
             case XML_fillId:
             {
-                size_t n = strtoul(attr.value.get(), NULL, 10);
+                size_t n = to_long(attr.value);
                 m_styles.set_xf_fill(n);
             }
             break;
             case XML_fontId:
             {
-                size_t n = strtoul(attr.value.get(), NULL, 10);
+                size_t n = to_long(attr.value);
                 m_styles.set_xf_font(n);
             }
             break;
             case XML_numFmtId:
             {
-                size_t n = strtoul(attr.value.get(), NULL, 10);
+                size_t n = to_long(attr.value);
                 m_styles.set_xf_number_format(n);
             }
             break;
             case XML_xfId:
             {
-                size_t n = strtoul(attr.value.get(), NULL, 10);
+                size_t n = to_long(attr.value);
                 m_styles.set_xf_style_xf(n);
             }
             break;
@@ -398,13 +401,13 @@ public:
         {
             case XML_hidden:
             {
-                bool b = strtoul(attr.value.get(), NULL, 10) != 0;
+                bool b = to_long(attr.value) != 0;
                 m_styles.set_cell_hidden(b);
             }
             break;
             case XML_locked:
             {
-                bool b = strtoul(attr.value.get(), NULL, 10) != 0;
+                bool b = to_long(attr.value) != 0;
                 m_styles.set_cell_locked(b);
             }
             break;
@@ -449,7 +452,7 @@ void xlsx_styles_context::start_element(xmlns_id_t ns, xml_token_t name, const x
         {
             xml_element_expected(parent, NS_ooxml_xlsx, XML_styleSheet);
             pstring ps = for_each(attrs.begin(), attrs.end(), single_attr_getter(m_pool, NS_ooxml_xlsx, XML_count)).get_value();
-            size_t font_count = strtoul(ps.get(), NULL, 10);
+            size_t font_count = to_long(ps);
             mp_styles->set_font_count(font_count);
         }
         break;
@@ -482,7 +485,7 @@ void xlsx_styles_context::start_element(xmlns_id_t ns, xml_token_t name, const x
         {
             xml_element_expected(parent, NS_ooxml_xlsx, XML_font);
             pstring ps = for_each(attrs.begin(), attrs.end(), single_attr_getter(m_pool, NS_ooxml_xlsx, XML_val)).get_value();
-            double font_size = strtod(ps.get(), NULL);
+            double font_size = to_double(ps);
             mp_styles->set_font_size(font_size);
         }
         break;
@@ -515,7 +518,7 @@ void xlsx_styles_context::start_element(xmlns_id_t ns, xml_token_t name, const x
         {
             xml_element_expected(parent, NS_ooxml_xlsx, XML_styleSheet);
             pstring ps = for_each(attrs.begin(), attrs.end(), single_attr_getter(m_pool, NS_ooxml_xlsx, XML_count)).get_value();
-            size_t fill_count = strtoul(ps.get(), NULL, 10);
+            size_t fill_count = to_long(ps);
             mp_styles->set_fill_count(fill_count);
         }
         break;
@@ -545,7 +548,7 @@ void xlsx_styles_context::start_element(xmlns_id_t ns, xml_token_t name, const x
         {
             xml_element_expected(parent, NS_ooxml_xlsx, XML_styleSheet);
             pstring ps = for_each(attrs.begin(), attrs.end(), single_attr_getter(m_pool, NS_ooxml_xlsx, XML_count)).get_value();
-            size_t border_count = strtoul(ps.get(), NULL, 10);
+            size_t border_count = to_long(ps);
             mp_styles->set_border_count(border_count);
         }
         break;
@@ -592,7 +595,7 @@ void xlsx_styles_context::start_element(xmlns_id_t ns, xml_token_t name, const x
             xml_element_expected(parent, NS_ooxml_xlsx, XML_styleSheet);
             pstring ps = for_each(
                 attrs.begin(), attrs.end(), single_attr_getter(m_pool, NS_ooxml_xlsx, XML_count)).get_value();
-            size_t n = strtoul(ps.get(), NULL, 10);
+            size_t n = to_long(ps);
             mp_styles->set_cell_style_xf_count(n);
             m_cell_style_xf = true;
         }
@@ -603,7 +606,7 @@ void xlsx_styles_context::start_element(xmlns_id_t ns, xml_token_t name, const x
             xml_element_expected(parent, NS_ooxml_xlsx, XML_styleSheet);
             pstring ps = for_each(
                 attrs.begin(), attrs.end(), single_attr_getter(m_pool, NS_ooxml_xlsx, XML_count)).get_value();
-            size_t n = strtoul(ps.get(), NULL, 10);
+            size_t n = to_long(ps);
             mp_styles->set_cell_xf_count(n);
             m_cell_style_xf = false;
         }
@@ -613,7 +616,7 @@ void xlsx_styles_context::start_element(xmlns_id_t ns, xml_token_t name, const x
             xml_element_expected(parent, NS_ooxml_xlsx, XML_styleSheet);
             pstring ps = for_each(
                 attrs.begin(), attrs.end(), single_attr_getter(m_pool, NS_ooxml_xlsx, XML_count)).get_value();
-            size_t n = strtoul(ps.get(), NULL, 10);
+            size_t n = to_long(ps);
             mp_styles->set_cell_style_count(n);
         }
         break;
@@ -642,6 +645,12 @@ void xlsx_styles_context::start_element(xmlns_id_t ns, xml_token_t name, const x
             for_each(attrs.begin(), attrs.end(), cell_protection_attr_parser(*mp_styles));
         }
         break;
+        case XML_tableStyles:
+        case XML_extLst:
+            // We don't import these.  Their content would otherwise be
+            // mistaken for the cell style elements of the same names.
+            skip_subtree();
+        break;
         default:
             warn_unhandled();
     }
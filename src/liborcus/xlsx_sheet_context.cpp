@@ -111,7 +111,7 @@ public:
             {
                 // row index
                 m_row = static_cast<spreadsheet::row_t>(
-                    strtoul(attr.value.str().c_str(), NULL, 10));
+                    to_long(attr.value));
                 if (!m_row)
                     throw xml_structure_error("row number can never be zero!");
 
@@ -181,7 +181,7 @@ public:
             break;
             case XML_s:
                 // cell style
-                m_xf = strtoul(attr.value.get(), NULL, 10);
+                m_xf = to_long(attr.value);
             break;
         }
     }
@@ -271,7 +271,7 @@ public:
                 m_ref = attr.value;
             break;
             case XML_si:
-                m_shared_index = strtoul(attr.value.get(), NULL, 10);
+                m_shared_index = to_long(attr.value);
             break;
         }
     }
@@ -286,6 +286,7 @@ public:
 xlsx_sheet_context::xlsx_sheet_context(session_context& session_cxt, const tokens& tokens, spreadsheet::iface::import_sheet* sheet) :
     xml_context_base(session_cxt, tokens),
     mp_sheet(sheet),
+    m_row_buffer(sheet),
     m_cur_row(-1),
     m_cur_col(-1),
     m_cur_cell_type(cell_type_value),
@@ -431,6 +432,8 @@ void xlsx_sheet_context::start_element(xmlns_id_t ns, xml_token_t name, const xm
         break;
         default:
             warn_unhandled();
+            // Nothing below an unhandled element is of any use to us.
+            skip_subtree();
     }
 
 }
@@ -442,6 +445,10 @@ bool xlsx_sheet_context::end_element(xmlns_id_t ns, xml_token_t name)
         case XML_c:
             end_element_cell();
         break;
+        case XML_row:
+        case XML_sheetData:
+            m_row_buffer.flush();
+        break;
         case XML_f:
         {
 #if 0
@@ -501,11 +508,14 @@ void xlsx_sheet_context::end_element_cell()
                 m_cur_row, m_cur_col, spreadsheet::xlsx_2007, m_cur_formula_str.get(),
                 m_cur_formula_str.size());
         }
+
+        set_formula_result();
     }
     else if (m_cur_formula_type == "shared" && m_cur_shared_formula_id >= 0)
     {
         // shared formula without formula expression
         mp_sheet->set_shared_formula(m_cur_row, m_cur_col, m_cur_shared_formula_id);
+        set_formula_result();
     }
     else if (!m_cur_value.empty())
     {
@@ -514,22 +524,22 @@ void xlsx_sheet_context::end_element_cell()
             case cell_type_string:
             {
                 // string cell
-                size_t str_id = strtoul(m_cur_value.get(), NULL, 10);
-                mp_sheet->set_string(m_cur_row, m_cur_col, str_id);
+                size_t str_id = to_long(m_cur_value);
+                m_row_buffer.set_string(m_cur_row, m_cur_col, str_id);
             }
             break;
             case cell_type_value:
             {
                 // value cell
-                double val = strtod(m_cur_value.get(), NULL);
-                mp_sheet->set_value(m_cur_row, m_cur_col, val);
+                double val = to_double(m_cur_value);
+                m_row_buffer.set_value(m_cur_row, m_cur_col, val);
             }
             break;
             case cell_type_boolean:
             {
                 // boolean cell
-                bool val = strtoul(m_cur_value.get(), NULL, 10) != 0;
-                mp_sheet->set_bool(m_cur_row, m_cur_col, val);
+                bool val = to_long(m_cur_value) != 0;
+                m_row_buffer.set_bool(m_cur_row, m_cur_col, val);
             }
             break;
             default:
@@ -538,7 +548,7 @@ void xlsx_sheet_context::end_element_cell()
     }
 
     if (m_cur_cell_xf)
-        mp_sheet->set_format(m_cur_row, m_cur_col, m_cur_cell_xf);
+        m_row_buffer.set_format(m_cur_row, m_cur_col, m_cur_cell_xf);
 
     // reset cell related parameters.
     m_cur_value.clear();
@@ -548,4 +558,11 @@ void xlsx_sheet_context::end_element_cell()
     m_cur_shared_formula_id = -1;
 }
 
+void xlsx_sheet_context::set_formula_result()
+{
+    // The cell value stored alongside a formula is its cached result.
+    if (!m_cur_value.empty())
+        mp_sheet->set_formula_result(m_cur_row, m_cur_col, m_cur_value.get(), m_cur_value.size());
+}
+
 }
@@ -29,6 +29,7 @@
 #define __ORCUS_XLSX_SHEET_CONTEXT_HPP__
 
 #include "xml_context_base.hpp"
+#include "sheet_row_buffer.hpp"
 #include "orcus/spreadsheet/types.hpp"
 
 namespace orcus {
@@ -67,9 +68,11 @@ public:
 
 private:
     void end_element_cell();
+    void set_formula_result();
 
 private:
     spreadsheet::iface::import_sheet* mp_sheet; /// sheet model instance for the loaded document.
+    sheet_row_buffer m_row_buffer; /// collects the value cells of the current row.
     spreadsheet::row_t m_cur_row;
     spreadsheet::col_t m_cur_col;
     cell_type    m_cur_cell_type;
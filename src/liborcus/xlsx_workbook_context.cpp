@@ -33,6 +33,7 @@
 #include "session_context.hpp"
 
 #include "orcus/global.hpp"
+#include "orcus/measurement.hpp"
 
 using namespace std;
 
@@ -53,7 +54,7 @@ public:
         {
             const pstring& val = attr.value;
             if (!val.empty())
-                m_sheet.id = strtoul(val.str().c_str(), NULL, 10);
+                m_sheet.id = to_long(val);
         }
         else if (attr.ns == NS_ooxml_r && attr.name == XML_id)
         {
@@ -118,6 +119,7 @@ void xlsx_workbook_context::start_element(xmlns_id_t ns, xml_token_t name, const
         break;
         default:
             warn_unhandled();
+            skip_subtree();
     }
 }
 
@@ -54,12 +54,24 @@ void print_stack(const tokens& tokens, const xml_elem_stack_t& elem_stack)
 }
 
 xml_context_base::xml_context_base(session_context& session_cxt, const tokens& tokens) :
-    m_session_cxt(session_cxt), m_tokens(tokens) {}
+    m_session_cxt(session_cxt), m_tokens(tokens), m_skip_subtree(false) {}
 
 xml_context_base::~xml_context_base()
 {
 }
 
+bool xml_context_base::pop_skip_request()
+{
+    bool skip = m_skip_subtree;
+    m_skip_subtree = false;
+    return skip;
+}
+
+void xml_context_base::skip_subtree()
+{
+    m_skip_subtree = true;
+}
+
 session_context& xml_context_base::get_session_context()
 {
     return m_session_cxt;
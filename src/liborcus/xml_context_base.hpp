@@ -72,6 +72,13 @@ public:
      */
     virtual void characters(const pstring& str, bool transient) = 0;
 
+    /**
+     * @return true if the context has asked for the content of the element
+     *         it has just started to be skipped.  The request is cleared
+     *         on return.
+     */
+    bool pop_skip_request();
+
 protected:
     session_context& get_session_context();
     const tokens& get_tokens() const;
@@ -85,6 +92,13 @@ protected:
     void warn_unexpected() const;
     void warn(const char* msg) const;
 
+    /**
+     * Ask the parser to skip the content of the element being started
+     * without parsing it.  Call this only from within start_element().  The
+     * context still receives the end_element() call for the element.
+     */
+    void skip_subtree();
+
     /**
      * Check if observed element equals expected element.  If not, it throws an
      * xml_structure_error exception.
@@ -105,6 +119,7 @@ private:
     session_context& m_session_cxt;
     const tokens& m_tokens;
     xml_elem_stack_t m_stack;
+    bool m_skip_subtree;
 };
 
 
@@ -57,7 +57,10 @@ void xml_simple_stream_handler::end_document()
 
 void xml_simple_stream_handler::start_element(const sax_token_parser_element& elem)
 {
-    get_current_context().start_element(elem.ns, elem.name, elem.attrs);
+    xml_context_base& cxt = get_current_context();
+    cxt.start_element(elem.ns, elem.name, elem.attrs);
+    if (cxt.pop_skip_request())
+        skip_subtree();
 }
 
 void xml_simple_stream_handler::end_element(const sax_token_parser_element& elem)
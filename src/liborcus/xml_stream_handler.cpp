@@ -29,11 +29,12 @@
 #include "xml_context_base.hpp"
 
 #include "orcus/exception.hpp"
+#include "orcus/tokens.hpp"
 
 namespace orcus {
 
 xml_stream_handler::xml_stream_handler(xml_context_base* root_context) :
-    mp_root_context(root_context)
+    mp_root_context(root_context), mp_parser(NULL)
 {
     m_context_stack.push_back(root_context);
 }
@@ -49,7 +50,10 @@ void xml_stream_handler::start_element(const sax_token_parser_element& elem)
     if (!cur.can_handle_element(elem.ns, elem.name))
         m_context_stack.push_back(cur.create_child_context(elem.ns, elem.name));
 
-    get_current_context().start_element(elem.ns, elem.name, elem.attrs);
+    xml_context_base& cxt = get_current_context();
+    cxt.start_element(elem.ns, elem.name, elem.attrs);
+    if (cxt.pop_skip_request())
+        skip_subtree();
 }
 
 void xml_stream_handler::end_element(const sax_token_parser_element& elem)
@@ -78,6 +82,17 @@ void xml_stream_handler::characters(const pstring& str, bool transient)
     get_current_context().characters(str, transient);
 }
 
+void xml_stream_handler::set_parser(parser_type* parser)
+{
+    mp_parser = parser;
+}
+
+void xml_stream_handler::skip_subtree()
+{
+    if (mp_parser)
+        mp_parser->skip_subtree();
+}
+
 xml_context_base& xml_stream_handler::get_current_context()
 {
     if (m_context_stack.empty())
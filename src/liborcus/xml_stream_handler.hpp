@@ -37,18 +37,34 @@
 namespace orcus {
 
 class xml_context_base;
+class tokens;
 
 class xml_stream_handler
 {
+public:
+    /**
+     * All the streams parsed through this handler are parts of machine
+     * generated documents, hence the lean parser config.
+     */
+    typedef sax_token_parser<xml_stream_handler, tokens, sax_parser_lean_config> parser_type;
+
+private:
     xml_context_base* mp_root_context;
     typedef std::vector<xml_context_base*> context_stack_type;
     context_stack_type m_context_stack;
+    parser_type* mp_parser;
 
     xml_stream_handler(); // disabled
 public:
     xml_stream_handler(xml_context_base* root_context);
     virtual ~xml_stream_handler() = 0;
 
+    /**
+     * Set the parser that drives this handler, to forward the skip
+     * requests from the contexts to.
+     */
+    void set_parser(parser_type* parser);
+
     virtual void start_document() = 0;
     virtual void end_document() = 0;
 
@@ -59,6 +75,11 @@ public:
 protected:
     xml_context_base& get_current_context();
 
+    /**
+     * Have the parser skip the content of the element being started.
+     */
+    void skip_subtree();
+
 };
 
 }
@@ -30,6 +30,7 @@
 
 #include "orcus/tokens.hpp"
 #include "orcus/sax_token_parser.hpp"
+#include "orcus/import_trace.hpp"
 
 #include <iostream>
 #include <vector>
@@ -39,6 +40,58 @@ using namespace std;
 
 namespace orcus {
 
+namespace {
+
+/**
+ * Let the handler know of the parser for the duration of the parsing, so
+ * that it can pass on the skip requests of its contexts.
+ */
+class handler_parser_scope
+{
+    xml_stream_handler& m_handler;
+public:
+    handler_parser_scope(xml_stream_handler& handler, xml_stream_handler::parser_type& parser) :
+        m_handler(handler)
+    {
+        m_handler.set_parser(&parser);
+    }
+
+    ~handler_parser_scope()
+    {
+        m_handler.set_parser(NULL);
+    }
+};
+
+/**
+ * Stream source that passes the requests on to another source, and keeps
+ * track of how much of the stream has been made available.
+ */
+class size_tracking_source : public sax::stream_source
+{
+    sax::stream_source& m_source;
+    size_t m_size;
+public:
+    size_tracking_source(sax::stream_source& source, size_t size) :
+        m_source(source), m_size(size) {}
+
+    virtual size_t fill(size_t size)
+    {
+        m_size = m_source.fill(size);
+        return m_size;
+    }
+
+    size_t size() const { return m_size; }
+};
+
+size_t run_parser(xml_stream_handler::parser_type& sax, xml_stream_handler& handler)
+{
+    handler_parser_scope scope(handler, sax);
+    sax.parse();
+    return sax.get_skipped_bytes();
+}
+
+}
+
 // ============================================================================
 
 xml_stream_parser::parse_error::parse_error(const string& msg) :
@@ -57,6 +110,24 @@ xml_stream_parser::xml_stream_parser(xmlns_repository& ns_repo, const tokens& to
     mp_handler(NULL),
     m_content(content),
     m_size(size),
+    mp_source(NULL),
+    m_skipped_bytes(0),
+    mp_trace(NULL),
+    m_name(name)
+{
+}
+
+xml_stream_parser::xml_stream_parser(
+    xmlns_repository& ns_repo, const tokens& tokens, const char* content, size_t size,
+    sax::stream_source& source, const string& name) :
+    m_ns_cxt(ns_repo.create_context()),
+    m_tokens(tokens),
+    mp_handler(NULL),
+    m_content(content),
+    m_size(size),
+    mp_source(&source),
+    m_skipped_bytes(0),
+    mp_trace(NULL),
     m_name(name)
 {
 }
@@ -70,8 +141,20 @@ void xml_stream_parser::parse()
     if (!mp_handler)
         return;
 
-    sax_token_parser<xml_stream_handler, tokens> sax(m_content, m_size, m_tokens, m_ns_cxt, *mp_handler);
-    sax.parse();
+    trace_scope scope(mp_trace, trace_phase_parse, m_name);
+
+    if (mp_source)
+    {
+        size_tracking_source source(*mp_source, m_size);
+        xml_stream_handler::parser_type sax(m_content, m_size, source, m_tokens, m_ns_cxt, *mp_handler);
+        m_skipped_bytes = run_parser(sax, *mp_handler);
+        scope.set_bytes(source.size());
+        return;
+    }
+
+    xml_stream_handler::parser_type sax(m_content, m_size, m_tokens, m_ns_cxt, *mp_handler);
+    m_skipped_bytes = run_parser(sax, *mp_handler);
+    scope.set_bytes(m_size);
 }
 
 void xml_stream_parser::set_handler(xml_stream_handler* handler)
@@ -84,4 +167,14 @@ xml_stream_handler* xml_stream_parser::get_handler() const
     return mp_handler;
 }
 
+size_t xml_stream_parser::get_skipped_bytes() const
+{
+    return m_skipped_bytes;
+}
+
+void xml_stream_parser::set_trace(import_trace* trace)
+{
+    mp_trace = trace;
+}
+
 }
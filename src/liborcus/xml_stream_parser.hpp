@@ -36,6 +36,9 @@
 
 namespace orcus {
 
+namespace sax { class stream_source; }
+
+class import_trace;
 class xml_stream_handler;
 class tokens;
 
@@ -58,6 +61,15 @@ public:
     };
 
     xml_stream_parser(xmlns_repository& ns_repo, const tokens& tokens, const char* content, size_t size, const ::std::string& name);
+
+    /**
+     * Constructor for a stream whose content is made available
+     * progressively while it gets parsed.  The content pointer is the
+     * buffer the stream source writes the stream into.
+     */
+    xml_stream_parser(
+        xmlns_repository& ns_repo, const tokens& tokens, const char* content, size_t size,
+        sax::stream_source& source, const ::std::string& name);
     ~xml_stream_parser();
 
     void parse();
@@ -65,6 +77,19 @@ public:
     void set_handler(xml_stream_handler* handler);
     xml_stream_handler* get_handler() const;
 
+    /**
+     * @return number of bytes of the stream that were skipped without being
+     *         parsed, at the request of the handler.
+     */
+    size_t get_skipped_bytes() const;
+
+    /**
+     * Set a trace to record the parsing of the stream on.
+     *
+     * @param trace trace to record on, or NULL to record nothing.
+     */
+    void set_trace(import_trace* trace);
+
 private:
     xml_stream_parser(); // disabled
 
@@ -73,6 +98,9 @@ private:
     xml_stream_handler* mp_handler;
     const char* m_content;
     size_t m_size;
+    sax::stream_source* mp_source;
+    size_t m_skipped_bytes;
+    import_trace* mp_trace;
     ::std::string m_name;  // stream name
 };
 
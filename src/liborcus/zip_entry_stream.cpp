@@ -0,0 +1,154 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+#include "zip_entry_stream.hpp"
+
+#include "orcus/import_trace.hpp"
+
+#include <algorithm>
+
+namespace orcus {
+
+namespace {
+
+/**
+ * Number of bytes to inflate each time the parser asks for more.
+ */
+const size_t zip_entry_segment_size = 65536;
+
+}
+
+zip_entry_stream::zip_entry_stream() : mp_data(NULL), m_filled(0), mp_trace(NULL) {}
+
+zip_entry_stream::~zip_entry_stream() {}
+
+bool zip_entry_stream::open(const zip_archive& archive, const pstring& entry_name)
+{
+    mp_pipe.reset();
+    mp_data = NULL;
+    m_filled = 0;
+    if (!m_reader.open(archive, entry_name))
+        return false;
+
+    if (mp_trace)
+        m_name = entry_name.str();
+
+    const unsigned char* p = m_reader.data();
+    if (p && p[m_reader.size()] == '\0')
+    {
+        // The whole entry is available in memory as is, and happens to be
+        // followed by a null byte as the parser requires.
+        std::vector<char>().swap(m_buffer);
+        mp_data = reinterpret_cast<const char*>(p);
+        m_filled = m_reader.size();
+        return true;
+    }
+
+    std::vector<char> buf(m_reader.size()+1, '\0'); // null-terminated
+    m_buffer.swap(buf);
+    mp_data = &m_buffer[0];
+
+    if (p)
+    {
+        // The entry is in memory but is followed by whatever comes next in
+        // the archive, typically the next local header.  Copy it in one go
+        // to have it null-terminated.
+        std::copy(p, p + m_reader.size(), m_buffer.begin());
+        m_filled = m_reader.size();
+    }
+
+    return true;
+}
+
+const char* zip_entry_stream::data() const
+{
+    return mp_data;
+}
+
+size_t zip_entry_stream::filled() const
+{
+    return m_filled;
+}
+
+bool zip_entry_stream::empty() const
+{
+    return m_reader.size() == 0;
+}
+
+void zip_entry_stream::start_background_inflate()
+{
+    if (m_buffer.empty() || mp_pipe)
+        // Not compressed, or already started.
+        return;
+
+    if (m_reader.size() - m_filled <= zip_entry_segment_size)
+        // Not worth a thread.
+        return;
+
+    if (!stream_pipe::enabled())
+        return;
+
+    mp_pipe.reset(new stream_pipe(*this, &m_buffer[0], m_filled, m_reader.size()));
+}
+
+void zip_entry_stream::set_trace(import_trace* trace)
+{
+    mp_trace = trace;
+}
+
+size_t zip_entry_stream::fill(size_t size)
+{
+    if (mp_pipe)
+        return mp_pipe->fill(size);
+
+    size_t n = std::min(zip_entry_segment_size, m_reader.size() - m_filled);
+    if (!n)
+        // End of the stream.
+        return m_filled;
+
+    trace_scope scope(mp_trace, trace_phase_inflate, m_name);
+    if (m_reader.read(reinterpret_cast<unsigned char*>(&m_buffer[m_filled]), n) < n)
+        throw zip_error("data stream is shorter than its declared size.");
+
+    scope.set_bytes(n);
+    m_filled += n;
+    return m_filled;
+}
+
+size_t zip_entry_stream::produce(char* p, size_t n)
+{
+    // Called on the pipe's thread.  The entry's size is known, so a short
+    // read means the data is truncated.
+    trace_scope scope(mp_trace, trace_phase_inflate, m_name);
+    if (m_reader.read(reinterpret_cast<unsigned char*>(p), n) < n)
+        throw zip_error("data stream is shorter than its declared size.");
+
+    scope.set_bytes(n);
+    return n;
+}
+
+}
@@ -0,0 +1,118 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+#ifndef __ORCUS_ZIP_ENTRY_STREAM_HPP__
+#define __ORCUS_ZIP_ENTRY_STREAM_HPP__
+
+#include "orcus/zip_archive.hpp"
+#include "orcus/sax_parser_base.hpp"
+#include "stream_pipe.hpp"
+
+#include <vector>
+#include <string>
+
+#include <boost/scoped_ptr.hpp>
+
+namespace orcus {
+
+class import_trace;
+
+/**
+ * Source that makes the content of a zip file entry available to the sax
+ * parser progressively.  The entry gets inflated one segment at a time each
+ * time the parser reaches the end of what has been inflated so far, so that
+ * each segment is parsed while it is still hot in the cache, and the
+ * compressed data stream is never held in memory in its entirety.  An
+ * entry stored without compression in a memory-mapped archive is copied
+ * from the mapping in one go, or passed to the parser straight from the
+ * mapping in the rare case it is followed by a null byte.
+ *
+ * Alternatively the entry can be inflated on a dedicated thread while the
+ * parser consumes it; see start_background_inflate().
+ */
+class zip_entry_stream : public sax::stream_source, private stream_pipe::producer
+{
+    zip_file_entry_reader m_reader;
+    std::vector<char> m_buffer;
+    const char* mp_data;
+    size_t m_filled;
+    boost::scoped_ptr<stream_pipe> mp_pipe;
+    import_trace* mp_trace;
+    std::string m_name;
+
+public:
+    zip_entry_stream();
+    virtual ~zip_entry_stream();
+
+    /**
+     * Open a file entry and allocate the buffer to inflate it into.
+     *
+     * @return true if the entry is found and is readable, false otherwise.
+     */
+    bool open(const zip_archive& archive, const pstring& entry_name);
+
+    /**
+     * @return pointer to the buffer the entry gets inflated into.
+     */
+    const char* data() const;
+
+    /**
+     * @return number of bytes available in the buffer so far.
+     */
+    size_t filled() const;
+
+    /**
+     * @return true if the entry has no content, false otherwise.
+     */
+    bool empty() const;
+
+    /**
+     * Inflate the rest of the entry on a dedicated thread from this point
+     * on, so that inflating and parsing overlap.  This does nothing if the
+     * entry is not compressed, is too small to be worth it, or if the system
+     * has only one hardware thread.  Call it after open() and before the
+     * parsing starts.
+     */
+    void start_background_inflate();
+
+    /**
+     * Set a trace to record the inflation of each segment of the entry on.
+     * Call it before open().
+     *
+     * @param trace trace to record on, or NULL to record nothing.
+     */
+    void set_trace(import_trace* trace);
+
+    virtual size_t fill(size_t size);
+
+private:
+    virtual size_t produce(char* p, size_t n);
+};
+
+}
+
+#endif
@@ -0,0 +1,652 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+
+#include "orcus/spreadsheet/document.hpp"
+#include "orcus/spreadsheet/factory.hpp"
+#include "orcus/spreadsheet/import_interface.hpp"
+#include "orcus/config.hpp"
+#include "orcus/format_detection.hpp"
+#include "orcus/import_trace.hpp"
+#include "orcus/orcus_csv.hpp"
+#include "orcus/orcus_xml.hpp"
+#include "orcus/stream.hpp"
+#include "orcus/xml_namespace.hpp"
+
+#ifdef ORCUS_BENCH_WITH_XLSX
+#include "orcus/orcus_xlsx.hpp"
+#endif
+#ifdef ORCUS_BENCH_WITH_ODS
+#include "orcus/orcus_ods.hpp"
+#endif
+#ifdef ORCUS_BENCH_WITH_GNUMERIC
+#include "orcus/orcus_gnumeric.hpp"
+#endif
+#ifdef ORCUS_BENCH_WITH_XLS_XML
+#include "orcus/orcus_xls_xml.hpp"
+#endif
+
+#include "xml_map_sax_handler.hpp"
+
+#include <boost/scoped_ptr.hpp>
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace orcus;
+
+namespace {
+
+/**
+ * @return peak resident set size of the process so far, in kilobytes.
+ */
+long get_peak_rss()
+{
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage))
+        return 0;
+    return usage.ru_maxrss;
+}
+
+enum bench_format
+{
+    bench_format_unknown,
+    bench_format_xlsx,
+    bench_format_ods,
+    bench_format_gnumeric,
+    bench_format_xls_xml,
+    bench_format_csv,
+    bench_format_xml_mapped
+};
+
+const char* get_format_name(bench_format format)
+{
+    switch (format)
+    {
+        case bench_format_xlsx:
+            return "xlsx";
+        case bench_format_ods:
+            return "ods";
+        case bench_format_gnumeric:
+            return "gnumeric";
+        case bench_format_xls_xml:
+            return "xls-xml";
+        case bench_format_csv:
+            return "csv";
+        case bench_format_xml_mapped:
+            return "xml-mapped";
+        default:
+            ;
+    }
+    return "unknown";
+}
+
+bool ends_with(const string& s, const char* suffix)
+{
+    size_t n = strlen(suffix);
+    return s.size() >= n && s.compare(s.size()-n, n, suffix) == 0;
+}
+
+bool file_exists(const string& path)
+{
+    ifstream file(path.c_str());
+    return file.good();
+}
+
+/**
+ * @return path of the map file that goes with a mapped xml file, which is
+ *         the path of the xml file with its extension replaced by '.map'.
+ */
+string get_map_path(const string& path)
+{
+    return path.substr(0, path.size()-4) + ".map";
+}
+
+/**
+ * Determine the format of a file from its name, and from its content when
+ * the name is not conclusive.  An xml file is taken as a mapped xml file
+ * when a map file sits next to it, and as an Excel 2003 XML file otherwise.
+ */
+bench_format detect_format(const string& path)
+{
+    if (ends_with(path, ".xlsx"))
+        return bench_format_xlsx;
+    if (ends_with(path, ".ods"))
+        return bench_format_ods;
+    if (ends_with(path, ".gnumeric"))
+        return bench_format_gnumeric;
+    if (ends_with(path, ".csv"))
+        return bench_format_csv;
+    if (ends_with(path, ".xml"))
+        return file_exists(get_map_path(path)) ? bench_format_xml_mapped : bench_format_xls_xml;
+
+    string content;
+    load_file_content(path.c_str(), content);
+    if (content.empty())
+        return bench_format_unknown;
+
+    switch (detect(reinterpret_cast<const unsigned char*>(&content[0]), content.size()))
+    {
+        case format_xlsx:
+            return bench_format_xlsx;
+        case format_ods:
+            return bench_format_ods;
+        case format_gnumeric:
+            return bench_format_gnumeric;
+        case format_xls_xml:
+            return bench_format_xls_xml;
+        case format_csv:
+            return bench_format_csv;
+        default:
+            ;
+    }
+    return bench_format_unknown;
+}
+
+bool is_filter_available(bench_format format)
+{
+    switch (format)
+    {
+        case bench_format_csv:
+        case bench_format_xml_mapped:
+            return true;
+#ifdef ORCUS_BENCH_WITH_XLSX
+        case bench_format_xlsx:
+            return true;
+#endif
+#ifdef ORCUS_BENCH_WITH_ODS
+        case bench_format_ods:
+            return true;
+#endif
+#ifdef ORCUS_BENCH_WITH_GNUMERIC
+        case bench_format_gnumeric:
+            return true;
+#endif
+#ifdef ORCUS_BENCH_WITH_XLS_XML
+        case bench_format_xls_xml:
+            return true;
+#endif
+        default:
+            ;
+    }
+    return false;
+}
+
+/**
+ * Factory that passes everything on to the factory of the document model,
+ * and notes whether the filter has finalized the document.  Some filters
+ * leave that to the caller.
+ */
+class bench_factory : public spreadsheet::iface::import_factory
+{
+    spreadsheet::iface::import_factory& m_factory;
+    bool m_finalized;
+
+public:
+    bench_factory(spreadsheet::iface::import_factory& factory) :
+        m_factory(factory), m_finalized(false) {}
+
+    virtual ~bench_factory() {}
+
+    virtual spreadsheet::iface::import_global_settings* get_global_settings()
+    {
+        return m_factory.get_global_settings();
+    }
+
+    virtual spreadsheet::iface::import_shared_strings* get_shared_strings()
+    {
+        return m_factory.get_shared_strings();
+    }
+
+    virtual spreadsheet::iface::import_styles* get_styles()
+    {
+        return m_factory.get_styles();
+    }
+
+    virtual spreadsheet::iface::import_sheet* append_sheet(const char* sheet_name, size_t sheet_name_length)
+    {
+        return m_factory.append_sheet(sheet_name, sheet_name_length);
+    }
+
+    virtual spreadsheet::iface::import_sheet* get_sheet(const char* sheet_name, size_t sheet_name_length)
+    {
+        return m_factory.get_sheet(sheet_name, sheet_name_length);
+    }
+
+    virtual void finalize()
+    {
+        m_factory.finalize();
+        m_finalized = true;
+    }
+
+    virtual void set_trace(import_trace* trace)
+    {
+        m_factory.set_trace(trace);
+    }
+
+    bool is_finalized() const { return m_finalized; }
+};
+
+/**
+ * Result of a single import.  The time of each phase is the time spent in
+ * its events, less the time spent in the events nested in them, summed
+ * over all threads.
+ */
+struct import_result
+{
+    double total;
+    vector<double> phases;
+    size_t cells;
+
+    import_result() : total(0.0), phases(trace_phase_count, 0.0), cells(0) {}
+};
+
+struct event_start_less : binary_function<trace_event, trace_event, bool>
+{
+    bool operator() (const trace_event& l, const trace_event& r) const
+    {
+        if (l.start != r.start)
+            return l.start < r.start;
+
+        // Enclosing events first.
+        return l.duration > r.duration;
+    }
+};
+
+/**
+ * Add up the time spent in each phase, excluding the events nested in
+ * other events on the same thread, so that no time is counted twice.
+ */
+void get_phase_times(const vector<trace_event>& events, vector<double>& phases)
+{
+    typedef map<size_t, vector<trace_event> > thread_events_type;
+    thread_events_type thread_events;
+    for (size_t i = 0; i < events.size(); ++i)
+        thread_events[events[i].thread].push_back(events[i]);
+
+    thread_events_type::iterator it = thread_events.begin(), it_end = thread_events.end();
+    for (; it != it_end; ++it)
+    {
+        vector<trace_event>& evs = it->second;
+        sort(evs.begin(), evs.end(), event_start_less());
+
+        // Events that enclose the current one.
+        vector<const trace_event*> stack;
+        for (size_t i = 0; i < evs.size(); ++i)
+        {
+            const trace_event& ev = evs[i];
+            while (!stack.empty() && stack.back()->start + stack.back()->duration <= ev.start)
+                stack.pop_back();
+
+            if (!stack.empty())
+                phases[stack.back()->phase] -= ev.duration;
+
+            phases[ev.phase] += ev.duration;
+            stack.push_back(&ev);
+        }
+    }
+}
+
+void read_with_filter(
+    bench_format format, const string& path, bench_factory& factory, size_t thread_count, import_trace& trace)
+{
+    config opt;
+    opt.thread_count = thread_count;
+    opt.trace = &trace;
+
+    switch (format)
+    {
+#ifdef ORCUS_BENCH_WITH_XLSX
+        case bench_format_xlsx:
+        {
+            orcus_xlsx app(&factory);
+            app.set_config(opt);
+            app.read_file(path.c_str());
+            break;
+        }
+#endif
+#ifdef ORCUS_BENCH_WITH_ODS
+        case bench_format_ods:
+        {
+            orcus_ods app(&factory);
+            app.set_config(opt);
+            app.read_file(path.c_str());
+            break;
+        }
+#endif
+#ifdef ORCUS_BENCH_WITH_GNUMERIC
+        case bench_format_gnumeric:
+        {
+            orcus_gnumeric app(&factory);
+            app.set_config(opt);
+            app.read_file(path.c_str());
+            break;
+        }
+#endif
+#ifdef ORCUS_BENCH_WITH_XLS_XML
+        case bench_format_xls_xml:
+        {
+            orcus_xls_xml app(&factory);
+            app.set_config(opt);
+            app.read_file(path.c_str());
+            break;
+        }
+#endif
+        case bench_format_csv:
+        {
+            orcus_csv app(&factory);
+            app.set_config(opt);
+            app.read_file(path.c_str());
+            break;
+        }
+        case bench_format_xml_mapped:
+        {
+            xmlns_repository repo;
+            orcus_xml app(repo, &factory, NULL);
+            app.set_config(opt);
+            read_map_file(app, get_map_path(path).c_str());
+            app.read_file(path.c_str());
+            break;
+        }
+        default:
+            throw runtime_error("no filter available for this format");
+    }
+}
+
+/**
+ * Import the file into a fresh document with a trace attached.  The
+ * filters that leave the document unfinalized get it finalized here, so
+ * that the formula calculation is measured for every format.
+ */
+import_result measure_import(bench_format format, const string& path, size_t thread_count)
+{
+    boost::scoped_ptr<spreadsheet::document> doc(new spreadsheet::document);
+    boost::scoped_ptr<spreadsheet::import_factory> doc_factory(new spreadsheet::import_factory(doc.get()));
+    bench_factory factory(*doc_factory);
+    import_trace trace;
+
+    // Silence the progress messages written by the filters.
+    ostringstream sink;
+    streambuf* old_buf = cout.rdbuf(sink.rdbuf());
+
+    import_result res;
+    try
+    {
+        double start = trace.now();
+        read_with_filter(format, path, factory, thread_count, trace);
+        if (!factory.is_finalized())
+        {
+            doc->set_trace(&trace);
+            trace_scope scope(&trace, trace_phase_finalize, "finalize");
+            factory.finalize();
+        }
+        res.total = trace.now() - start;
+    }
+    catch (...)
+    {
+        cout.rdbuf(old_buf);
+        throw;
+    }
+
+    cout.rdbuf(old_buf);
+    get_phase_times(trace.get_events(), res.phases);
+    res.cells = trace.get_cell_count();
+    return res;
+}
+
+struct bench_result
+{
+    string path;
+    bench_format format;
+    size_t size;
+    size_t cells;
+    vector<double> phases;
+    double total;
+    long peak_rss;
+    string error;
+
+    bench_result() :
+        format(bench_format_unknown), size(0), cells(0),
+        phases(trace_phase_count, 0.0), total(0.0), peak_rss(0) {}
+};
+
+/**
+ * Benchmark one file.  The phase times reported are those of the fastest
+ * import.
+ */
+void run_bench(const string& path, size_t repeat, size_t thread_count, bench_result& res)
+{
+    res.path = path;
+    res.format = detect_format(path);
+    if (!is_filter_available(res.format))
+        throw runtime_error("no filter available for this format");
+
+    {
+        file_content content(path.c_str());
+        res.size = content.size();
+    }
+
+    for (size_t i = 0; i < repeat; ++i)
+    {
+        import_result imp = measure_import(res.format, path, thread_count);
+        if (!i || imp.total < res.total)
+        {
+            res.total = imp.total;
+            res.phases = imp.phases;
+        }
+        res.cells = imp.cells;
+    }
+
+    res.peak_rss = get_peak_rss();
+}
+
+void write_json_string(ostream& os, const string& s)
+{
+    os << '"';
+    for (string::const_iterator it = s.begin(), it_end = s.end(); it != it_end; ++it)
+    {
+        unsigned char c = *it;
+        if (c == '"' || c == '\\')
+            os << '\\' << c;
+        else if (c < 0x20)
+        {
+            char buf[8];
+            snprintf(buf, sizeof(buf), "\\u%04x", c);
+            os << buf;
+        }
+        else
+            os << c;
+    }
+    os << '"';
+}
+
+double get_rate(double amount, double seconds)
+{
+    return seconds > 0.0 ? amount / seconds : 0.0;
+}
+
+void write_json(ostream& os, const vector<bench_result>& results, size_t repeat, size_t thread_count)
+{
+    os << "{" << endl;
+    os << "  \"repeat\": " << repeat << "," << endl;
+    os << "  \"threads\": " << thread_count << "," << endl;
+    os << "  \"results\": [";
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const bench_result& res = results[i];
+        os << (i ? "," : "") << endl;
+        os << "    {" << endl;
+        os << "      \"file\": ";
+        write_json_string(os, res.path);
+        os << "," << endl;
+        os << "      \"format\": \"" << get_format_name(res.format) << "\"," << endl;
+
+        if (!res.error.empty())
+        {
+            os << "      \"error\": ";
+            write_json_string(os, res.error);
+            os << endl << "    }";
+            continue;
+        }
+
+        os << "      \"size\": " << res.size << "," << endl;
+        os << "      \"cells\": " << res.cells << "," << endl;
+        os << "      \"seconds\": {" << endl;
+        for (size_t j = 0; j < trace_phase_count; ++j)
+            os << "        \"" << get_trace_phase_name(static_cast<trace_phase_t>(j)) << "\": " << res.phases[j] << "," << endl;
+        os << "        \"total\": " << res.total << endl;
+        os << "      }," << endl;
+        os << "      \"mb_per_sec\": " << get_rate(res.size / (1024.0*1024.0), res.total) << "," << endl;
+        os << "      \"cells_per_sec\": " << get_rate(res.cells, res.total) << "," << endl;
+        os << "      \"peak_rss_kb\": " << res.peak_rss << endl;
+        os << "    }";
+    }
+
+    os << endl << "  ]" << endl;
+    os << "}" << endl;
+}
+
+void print_help()
+{
+    cout << "Usage: orcus-bench [options] FILE..." << endl;
+    cout << endl;
+    cout << "Import each file into the spreadsheet document model, and report the time" << endl;
+    cout << "spent in each phase of the import as JSON." << endl;
+    cout << endl;
+    cout << "Options:" << endl;
+    cout << "  --repeat=N    number of runs per file; the fastest run is reported (default: 3)" << endl;
+    cout << "  --threads=N   number of threads the filters may use (default: 1)" << endl;
+    cout << "  --output=FILE file to write the report to (default: standard output)" << endl;
+    cout << endl;
+    cout << "The format of each file is determined from its extension.  A .xml file with a" << endl;
+    cout << ".map file of the same base name next to it is imported as mapped xml, any" << endl;
+    cout << "other .xml file as Excel 2003 XML.  Use orcus-bench-corpus to generate files" << endl;
+    cout << "of every format with the same content." << endl;
+    cout << endl;
+    cout << "The phases are timed with the import trace the filters record.  The time of" << endl;
+    cout << "each phase excludes the events nested in it, such as on-demand inflation" << endl;
+    cout << "during parsing, and is summed over all threads, so with more than one thread" << endl;
+    cout << "the phases can add up to more than the total.  Filters that insert cells" << endl;
+    cout << "while parsing account for the insertion under the parse phase.  The peak RSS" << endl;
+    cout << "is that of the whole process up to the end of the file's runs, so it never" << endl;
+    cout << "goes down from one file to the next." << endl;
+}
+
+bool get_option(const char* arg, const char* name, string& value)
+{
+    size_t n = strlen(name);
+    if (strncmp(arg, "--", 2) || strncmp(arg+2, name, n) || arg[n+2] != '=')
+        return false;
+
+    value = arg + n + 3;
+    return true;
+}
+
+}
+
+/**
+ * Benchmark the import of spreadsheet files across all supported formats.
+ *
+ * usage: orcus-bench [--repeat=N] [--threads=N] [--output=FILE] FILE...
+ */
+int main(int argc, char** argv)
+{
+    size_t repeat = 3;
+    size_t thread_count = 1;
+    string output;
+    vector<string> paths;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        string v;
+        if (get_option(argv[i], "repeat", v))
+            repeat = strtoul(v.c_str(), NULL, 10);
+        else if (get_option(argv[i], "threads", v))
+            thread_count = strtoul(v.c_str(), NULL, 10);
+        else if (get_option(argv[i], "output", v))
+            output = v;
+        else if (!strncmp(argv[i], "--", 2))
+        {
+            print_help();
+            return EXIT_FAILURE;
+        }
+        else
+            paths.push_back(argv[i]);
+    }
+
+    if (paths.empty() || !repeat)
+    {
+        print_help();
+        return EXIT_FAILURE;
+    }
+
+    bool success = true;
+    vector<bench_result> results(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i)
+    {
+        bench_result& res = results[i];
+        try
+        {
+            run_bench(paths[i], repeat, thread_count, res);
+        }
+        catch (const std::exception& e)
+        {
+            res.path = paths[i];
+            res.error = e.what();
+            success = false;
+        }
+    }
+
+    if (output.empty())
+        write_json(cout, results, repeat, thread_count);
+    else
+    {
+        ofstream file(output.c_str());
+        if (!file)
+        {
+            cerr << "failed to open " << output << endl;
+            return EXIT_FAILURE;
+        }
+        write_json(file, results, repeat, thread_count);
+    }
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,876 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+
+#include <boost/cstdint.hpp>
+#include <zlib.h>
+
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+using boost::uint16_t;
+using boost::uint32_t;
+using boost::uint64_t;
+
+namespace {
+
+/**
+ * Parameters of the generated corpus.
+ */
+struct corpus_params
+{
+    size_t rows;
+    size_t cols;
+    size_t sheets;
+    size_t unique_strings;
+    double string_ratio;
+    double formula_ratio;
+    uint64_t seed;
+    string output_dir;
+    string name;
+
+    corpus_params() :
+        rows(1000), cols(10), sheets(1), unique_strings(1000),
+        string_ratio(0.2), formula_ratio(0.1), seed(1), output_dir(".") {}
+};
+
+/**
+ * Pseudo-random number generator with a fixed algorithm, so that the same
+ * seed gives the same corpus on every platform and with every standard
+ * library.
+ */
+class rng
+{
+    uint64_t m_state;
+public:
+    rng(uint64_t seed) : m_state(seed) {}
+
+    uint32_t next()
+    {
+        m_state = m_state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<uint32_t>(m_state >> 33);
+    }
+
+    /**
+     * @return value in the range of [0, 1).
+     */
+    double next_unit()
+    {
+        return next() / 2147483648.0;
+    }
+};
+
+enum cell_kind { cell_number, cell_string, cell_formula };
+
+struct cell_plan
+{
+    cell_kind kind;
+    double value;  // value of a number cell, or cached result of a formula cell.
+    size_t sid;    // string id of a string cell.
+};
+
+/**
+ * Content of a single sheet, laid out row by row.  Each formula cell sums
+ * all the cells to its left in the same row.
+ */
+class sheet_plan
+{
+    size_t m_rows;
+    size_t m_cols;
+    vector<cell_plan> m_cells;
+
+public:
+    sheet_plan(const corpus_params& params, rng& gen) :
+        m_rows(params.rows), m_cols(params.cols), m_cells(params.rows*params.cols)
+    {
+        vector<cell_plan>::iterator it = m_cells.begin();
+        for (size_t row = 0; row < m_rows; ++row)
+        {
+            double row_sum = 0.0;
+            for (size_t col = 0; col < m_cols; ++col, ++it)
+            {
+                cell_plan& cell = *it;
+                double u = gen.next_unit();
+                if (u < params.string_ratio)
+                {
+                    cell.kind = cell_string;
+                    cell.value = 0.0;
+                    cell.sid = gen.next() % params.unique_strings;
+                    continue;
+                }
+
+                cell.sid = 0;
+                if (col > 0 && u < params.string_ratio + params.formula_ratio)
+                {
+                    cell.kind = cell_formula;
+                    cell.value = row_sum;
+                }
+                else
+                {
+                    cell.kind = cell_number;
+                    cell.value = (gen.next() % 10000000) / 100.0;
+                }
+                row_sum += cell.value;
+            }
+        }
+    }
+
+    size_t rows() const { return m_rows; }
+    size_t cols() const { return m_cols; }
+
+    const cell_plan& get(size_t row, size_t col) const
+    {
+        return m_cells[row*m_cols+col];
+    }
+};
+
+typedef vector<sheet_plan*> sheet_plans_type;
+
+// ----------------------------------------------------------------------------
+// Content writing helpers.
+
+void append_uint(string& buf, size_t v)
+{
+    char s[32];
+    sprintf(s, "%lu", static_cast<unsigned long>(v));
+    buf += s;
+}
+
+void append_value(string& buf, const cell_plan& cell)
+{
+    char s[64];
+    if (cell.kind == cell_number)
+        sprintf(s, "%.2f", cell.value);
+    else
+        sprintf(s, "%.15g", cell.value);
+    buf += s;
+}
+
+void append_string(string& buf, size_t sid)
+{
+    buf += "text-";
+    append_uint(buf, sid);
+}
+
+/**
+ * Append the column name in the A1 reference style.
+ */
+void append_col_name(string& buf, size_t col)
+{
+    char s[8];
+    char* p = s + sizeof(s);
+    *--p = '\0';
+    ++col;
+    while (col)
+    {
+        --col;
+        *--p = 'A' + col % 26;
+        col /= 26;
+    }
+    buf += p;
+}
+
+void append_address(string& buf, size_t row, size_t col)
+{
+    append_col_name(buf, col);
+    append_uint(buf, row+1);
+}
+
+/**
+ * Append the formula expression of the cell at the specified position, in
+ * the A1 reference style without the leading '='.
+ */
+void append_formula_a1(string& buf, size_t row, size_t col)
+{
+    buf += "SUM(A";
+    append_uint(buf, row+1);
+    buf += ':';
+    append_address(buf, row, col-1);
+    buf += ')';
+}
+
+string get_sheet_name(size_t sheet)
+{
+    string name = "Sheet";
+    append_uint(name, sheet+1);
+    return name;
+}
+
+// ----------------------------------------------------------------------------
+// Zip archive and gzip writers.
+
+void write_u16(string& buf, uint16_t v)
+{
+    buf += static_cast<char>(v & 0xFF);
+    buf += static_cast<char>((v >> 8) & 0xFF);
+}
+
+void write_u32(string& buf, uint32_t v)
+{
+    for (int i = 0; i < 4; ++i, v >>= 8)
+        buf += static_cast<char>(v & 0xFF);
+}
+
+/**
+ * Minimal zip archive writer.  Entries are either stored or compressed
+ * with raw deflate.  No zip64 support.
+ */
+class zip_writer
+{
+    struct entry
+    {
+        string name;
+        uint32_t crc;
+        uint32_t compressed_size;
+        uint32_t size;
+        uint32_t offset;
+        uint16_t method;
+    };
+
+    ofstream m_file;
+    vector<entry> m_entries;
+    uint32_t m_offset;
+
+    void write(const string& buf)
+    {
+        m_file.write(buf.data(), buf.size());
+        m_offset += buf.size();
+    }
+
+    static string deflate_raw(const string& data)
+    {
+        z_stream zs;
+        memset(&zs, 0, sizeof(zs));
+        if (deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+            throw runtime_error("failed to initialize deflate.");
+
+        string out(deflateBound(&zs, data.size()), '\0');
+        zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+        zs.avail_in = data.size();
+        zs.next_out = reinterpret_cast<Bytef*>(&out[0]);
+        zs.avail_out = out.size();
+        int ret = deflate(&zs, Z_FINISH);
+        deflateEnd(&zs);
+        if (ret != Z_STREAM_END)
+            throw runtime_error("failed to deflate.");
+
+        out.resize(zs.total_out);
+        return out;
+    }
+
+public:
+    zip_writer(const string& filepath) :
+        m_file(filepath.c_str(), ios::out | ios::binary), m_offset(0)
+    {
+        if (!m_file)
+            throw runtime_error("failed to create " + filepath);
+    }
+
+    void add(const string& name, const string& data, bool compress = true)
+    {
+        if (data.size() >= 0xFFFFFFFFUL)
+            throw runtime_error(name + " is too large for a zip archive without zip64.");
+
+        entry e;
+        e.name = name;
+        e.crc = crc32(crc32(0, Z_NULL, 0), reinterpret_cast<const Bytef*>(data.data()), data.size());
+        e.size = data.size();
+        e.offset = m_offset;
+        e.method = compress ? 8 : 0;
+
+        string compressed;
+        if (compress)
+            compressed = deflate_raw(data);
+        const string& payload = compress ? compressed : data;
+        e.compressed_size = payload.size();
+
+        string header;
+        write_u32(header, 0x04034b50);
+        write_u16(header, 20);       // version needed to extract
+        write_u16(header, 0);        // flags
+        write_u16(header, e.method);
+        write_u16(header, 0);        // time
+        write_u16(header, 0x21);     // date (1980-01-01)
+        write_u32(header, e.crc);
+        write_u32(header, e.compressed_size);
+        write_u32(header, e.size);
+        write_u16(header, name.size());
+        write_u16(header, 0);        // extra field length
+        header += name;
+        write(header);
+        write(payload);
+
+        m_entries.push_back(e);
+    }
+
+    void close()
+    {
+        uint32_t cd_offset = m_offset;
+        string cd;
+        for (size_t i = 0; i < m_entries.size(); ++i)
+        {
+            const entry& e = m_entries[i];
+            write_u32(cd, 0x02014b50);
+            write_u16(cd, 20);       // version made by
+            write_u16(cd, 20);       // version needed to extract
+            write_u16(cd, 0);        // flags
+            write_u16(cd, e.method);
+            write_u16(cd, 0);        // time
+            write_u16(cd, 0x21);     // date
+            write_u32(cd, e.crc);
+            write_u32(cd, e.compressed_size);
+            write_u32(cd, e.size);
+            write_u16(cd, e.name.size());
+            write_u16(cd, 0);        // extra field length
+            write_u16(cd, 0);        // comment length
+            write_u16(cd, 0);        // disk number
+            write_u16(cd, 0);        // internal attributes
+            write_u32(cd, 0);        // external attributes
+            write_u32(cd, e.offset);
+            cd += e.name;
+        }
+        write(cd);
+
+        string eocd;
+        write_u32(eocd, 0x06054b50);
+        write_u16(eocd, 0);
+        write_u16(eocd, 0);
+        write_u16(eocd, m_entries.size());
+        write_u16(eocd, m_entries.size());
+        write_u32(eocd, cd.size());
+        write_u32(eocd, cd_offset);
+        write_u16(eocd, 0);
+        write(eocd);
+        m_file.close();
+    }
+};
+
+void write_file(const string& filepath, const string& content)
+{
+    ofstream file(filepath.c_str(), ios::out | ios::binary);
+    if (!file)
+        throw runtime_error("failed to create " + filepath);
+    file.write(content.data(), content.size());
+}
+
+void write_gzip_file(const string& filepath, const string& content)
+{
+    gzFile file = gzopen(filepath.c_str(), "wb");
+    if (!file)
+        throw runtime_error("failed to create " + filepath);
+
+    const char* p = content.data();
+    size_t remaining = content.size();
+    while (remaining)
+    {
+        unsigned int n = remaining < (1u << 30) ? remaining : (1u << 30);
+        if (gzwrite(file, p, n) != static_cast<int>(n))
+        {
+            gzclose(file);
+            throw runtime_error("failed to write " + filepath);
+        }
+        p += n;
+        remaining -= n;
+    }
+    gzclose(file);
+}
+
+// ----------------------------------------------------------------------------
+// Format writers.
+
+void write_xlsx(const string& filepath, const sheet_plans_type& sheets, size_t unique_strings)
+{
+    const char* ns_main = "http://schemas.openxmlformats.org/spreadsheetml/2006/main";
+    const char* ns_rel = "http://schemas.openxmlformats.org/officeDocument/2006/relationships";
+
+    // Shared string indices in the order of first use.
+    vector<long> sst_index(unique_strings, -1);
+    string sst_items;
+    size_t sst_count = 0, sst_unique = 0;
+
+    zip_writer zip(filepath);
+
+    string content_types =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+        "<Types xmlns=\"http://schemas.openxmlformats.org/package/2006/content-types\">"
+        "<Default Extension=\"rels\" ContentType=\"application/vnd.openxmlformats-package.relationships+xml\"/>"
+        "<Default Extension=\"xml\" ContentType=\"application/xml\"/>"
+        "<Override PartName=\"/xl/workbook.xml\" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.sheet.main+xml\"/>"
+        "<Override PartName=\"/xl/sharedStrings.xml\" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.sharedStrings+xml\"/>";
+    string workbook =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+        "<workbook xmlns=\"" + string(ns_main) + "\" xmlns:r=\"" + ns_rel + "\"><sheets>";
+    string workbook_rels =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+        "<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">"
+        "<Relationship Id=\"rId0\" Type=\"" + string(ns_rel) + "/sharedStrings\" Target=\"sharedStrings.xml\"/>";
+
+    for (size_t i = 0; i < sheets.size(); ++i)
+    {
+        const sheet_plan& sheet = *sheets[i];
+        string part = "worksheets/sheet";
+        append_uint(part, i+1);
+        part += ".xml";
+        string rid = "rId";
+        append_uint(rid, i+1);
+
+        content_types += "<Override PartName=\"/xl/" + part +
+            "\" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.worksheet+xml\"/>";
+        workbook += "<sheet name=\"" + get_sheet_name(i) + "\" sheetId=\"";
+        append_uint(workbook, i+1);
+        workbook += "\" r:id=\"" + rid + "\"/>";
+        workbook_rels += "<Relationship Id=\"" + rid + "\" Type=\"" + ns_rel + "/worksheet\" Target=\"" + part + "\"/>";
+
+        string buf =
+            "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+            "<worksheet xmlns=\"" + string(ns_main) + "\" xmlns:r=\"" + ns_rel + "\">";
+        buf += "<dimension ref=\"A1:";
+        append_address(buf, sheet.rows()-1, sheet.cols()-1);
+        buf += "\"/><sheetData>";
+        for (size_t row = 0; row < sheet.rows(); ++row)
+        {
+            buf += "<row r=\"";
+            append_uint(buf, row+1);
+            buf += "\" spans=\"1:";
+            append_uint(buf, sheet.cols());
+            buf += "\">";
+            for (size_t col = 0; col < sheet.cols(); ++col)
+            {
+                const cell_plan& cell = sheet.get(row, col);
+                buf += "<c r=\"";
+                append_address(buf, row, col);
+                switch (cell.kind)
+                {
+                    case cell_string:
+                    {
+                        long& index = sst_index[cell.sid];
+                        if (index < 0)
+                        {
+                            index = sst_unique++;
+                            sst_items += "<si><t>";
+                            append_string(sst_items, cell.sid);
+                            sst_items += "</t></si>";
+                        }
+                        ++sst_count;
+                        buf += "\" t=\"s\"><v>";
+                        append_uint(buf, index);
+                        buf += "</v></c>";
+                    }
+                    break;
+                    case cell_formula:
+                        buf += "\"><f>";
+                        append_formula_a1(buf, row, col);
+                        buf += "</f><v>";
+                        append_value(buf, cell);
+                        buf += "</v></c>";
+                    break;
+                    default:
+                        buf += "\"><v>";
+                        append_value(buf, cell);
+                        buf += "</v></c>";
+                }
+            }
+            buf += "</row>";
+        }
+        buf += "</sheetData></worksheet>";
+        zip.add("xl/" + part, buf);
+    }
+
+    content_types += "</Types>";
+    workbook += "</sheets></workbook>";
+    workbook_rels += "</Relationships>";
+
+    string sst =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+        "<sst xmlns=\"" + string(ns_main) + "\" count=\"";
+    append_uint(sst, sst_count);
+    sst += "\" uniqueCount=\"";
+    append_uint(sst, sst_unique);
+    sst += "\">" + sst_items + "</sst>";
+
+    string rels =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+        "<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">"
+        "<Relationship Id=\"rId1\" Type=\"" + string(ns_rel) + "/officeDocument\" Target=\"xl/workbook.xml\"/>"
+        "</Relationships>";
+
+    zip.add("[Content_Types].xml", content_types);
+    zip.add("_rels/.rels", rels);
+    zip.add("xl/workbook.xml", workbook);
+    zip.add("xl/_rels/workbook.xml.rels", workbook_rels);
+    zip.add("xl/sharedStrings.xml", sst);
+    zip.close();
+}
+
+void write_ods(const string& filepath, const sheet_plans_type& sheets)
+{
+    string buf =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<office:document-content"
+        " xmlns:office=\"urn:oasis:names:tc:opendocument:xmlns:office:1.0\""
+        " xmlns:table=\"urn:oasis:names:tc:opendocument:xmlns:table:1.0\""
+        " xmlns:text=\"urn:oasis:names:tc:opendocument:xmlns:text:1.0\""
+        " xmlns:of=\"urn:oasis:names:tc:opendocument:xmlns:of:1.2\""
+        " office:version=\"1.2\"><office:body><office:spreadsheet>";
+
+    for (size_t i = 0; i < sheets.size(); ++i)
+    {
+        const sheet_plan& sheet = *sheets[i];
+        buf += "<table:table table:name=\"" + get_sheet_name(i) + "\">";
+        buf += "<table:table-column table:number-columns-repeated=\"";
+        append_uint(buf, sheet.cols());
+        buf += "\"/>";
+        for (size_t row = 0; row < sheet.rows(); ++row)
+        {
+            buf += "<table:table-row>";
+            for (size_t col = 0; col < sheet.cols(); ++col)
+            {
+                const cell_plan& cell = sheet.get(row, col);
+                if (cell.kind == cell_string)
+                {
+                    buf += "<table:table-cell office:value-type=\"string\"><text:p>";
+                    append_string(buf, cell.sid);
+                    buf += "</text:p></table:table-cell>";
+                    continue;
+                }
+
+                buf += "<table:table-cell";
+                if (cell.kind == cell_formula)
+                {
+                    buf += " table:formula=\"of:=SUM([.A";
+                    append_uint(buf, row+1);
+                    buf += ":.";
+                    append_address(buf, row, col-1);
+                    buf += "])\"";
+                }
+                buf += " office:value-type=\"float\" office:value=\"";
+                append_value(buf, cell);
+                buf += "\"><text:p>";
+                append_value(buf, cell);
+                buf += "</text:p></table:table-cell>";
+            }
+            buf += "</table:table-row>";
+        }
+        buf += "</table:table>";
+    }
+    buf += "</office:spreadsheet></office:body></office:document-content>";
+
+    string manifest =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<manifest:manifest xmlns:manifest=\"urn:oasis:names:tc:opendocument:xmlns:manifest:1.0\" manifest:version=\"1.2\">"
+        "<manifest:file-entry manifest:full-path=\"/\" manifest:media-type=\"application/vnd.oasis.opendocument.spreadsheet\"/>"
+        "<manifest:file-entry manifest:full-path=\"content.xml\" manifest:media-type=\"text/xml\"/>"
+        "</manifest:manifest>";
+
+    zip_writer zip(filepath);
+    // The mimetype entry must come first, uncompressed.
+    zip.add("mimetype", "application/vnd.oasis.opendocument.spreadsheet", false);
+    zip.add("META-INF/manifest.xml", manifest);
+    zip.add("content.xml", buf);
+    zip.close();
+}
+
+void write_csv(const string& filepath, const sheet_plan& sheet)
+{
+    string buf;
+    for (size_t row = 0; row < sheet.rows(); ++row)
+    {
+        for (size_t col = 0; col < sheet.cols(); ++col)
+        {
+            if (col)
+                buf += ',';
+
+            const cell_plan& cell = sheet.get(row, col);
+            if (cell.kind == cell_string)
+                append_string(buf, cell.sid);
+            else
+                append_value(buf, cell);
+        }
+        buf += '\n';
+    }
+    write_file(filepath, buf);
+}
+
+void write_gnumeric(const string& filepath, const sheet_plans_type& sheets)
+{
+    string buf =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<gnm:Workbook xmlns:gnm=\"http://www.gnumeric.org/v10.dtd\"><gnm:Sheets>";
+
+    for (size_t i = 0; i < sheets.size(); ++i)
+    {
+        const sheet_plan& sheet = *sheets[i];
+        buf += "<gnm:Sheet><gnm:Name>" + get_sheet_name(i) + "</gnm:Name><gnm:MaxCol>";
+        append_uint(buf, sheet.cols()-1);
+        buf += "</gnm:MaxCol><gnm:MaxRow>";
+        append_uint(buf, sheet.rows()-1);
+        buf += "</gnm:MaxRow><gnm:Cells>";
+        for (size_t row = 0; row < sheet.rows(); ++row)
+        {
+            for (size_t col = 0; col < sheet.cols(); ++col)
+            {
+                const cell_plan& cell = sheet.get(row, col);
+                buf += "<gnm:Cell Row=\"";
+                append_uint(buf, row);
+                buf += "\" Col=\"";
+                append_uint(buf, col);
+                switch (cell.kind)
+                {
+                    case cell_string:
+                        buf += "\" ValueType=\"60\">";
+                        append_string(buf, cell.sid);
+                    break;
+                    case cell_formula:
+                        buf += "\">=";
+                        append_formula_a1(buf, row, col);
+                    break;
+                    default:
+                        buf += "\" ValueType=\"40\">";
+                        append_value(buf, cell);
+                }
+                buf += "</gnm:Cell>";
+            }
+        }
+        buf += "</gnm:Cells></gnm:Sheet>";
+    }
+    buf += "</gnm:Sheets></gnm:Workbook>";
+    write_gzip_file(filepath, buf);
+}
+
+void write_xls_xml(const string& filepath, const sheet_plans_type& sheets)
+{
+    string buf =
+        "<?xml version=\"1.0\"?>\n"
+        "<?mso-application progid=\"Excel.Sheet\"?>\n"
+        "<Workbook xmlns=\"urn:schemas-microsoft-com:office:spreadsheet\""
+        " xmlns:ss=\"urn:schemas-microsoft-com:office:spreadsheet\">";
+
+    for (size_t i = 0; i < sheets.size(); ++i)
+    {
+        const sheet_plan& sheet = *sheets[i];
+        buf += "<Worksheet ss:Name=\"" + get_sheet_name(i) + "\"><Table>";
+        for (size_t row = 0; row < sheet.rows(); ++row)
+        {
+            buf += "<Row>";
+            for (size_t col = 0; col < sheet.cols(); ++col)
+            {
+                const cell_plan& cell = sheet.get(row, col);
+                switch (cell.kind)
+                {
+                    case cell_string:
+                        buf += "<Cell><Data ss:Type=\"String\">";
+                        append_string(buf, cell.sid);
+                    break;
+                    case cell_formula:
+                        buf += "<Cell ss:Formula=\"=SUM(RC1:RC[-1])\"><Data ss:Type=\"Number\">";
+                        append_value(buf, cell);
+                    break;
+                    default:
+                        buf += "<Cell><Data ss:Type=\"Number\">";
+                        append_value(buf, cell);
+                }
+                buf += "</Data></Cell>";
+            }
+            buf += "</Row>";
+        }
+        buf += "</Table></Worksheet>";
+    }
+    buf += "</Workbook>";
+    write_file(filepath, buf);
+}
+
+/**
+ * Write the xml data stream along with the map file that maps it onto a
+ * single sheet as one range.
+ */
+void write_xml_mapped(const string& filepath, const string& map_filepath, const sheet_plan& sheet)
+{
+    string buf = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<data>";
+    for (size_t row = 0; row < sheet.rows(); ++row)
+    {
+        buf += "<row>";
+        for (size_t col = 0; col < sheet.cols(); ++col)
+        {
+            const cell_plan& cell = sheet.get(row, col);
+            buf += "<c";
+            append_uint(buf, col+1);
+            buf += '>';
+            if (cell.kind == cell_string)
+                append_string(buf, cell.sid);
+            else
+                append_value(buf, cell);
+            buf += "</c";
+            append_uint(buf, col+1);
+            buf += '>';
+        }
+        buf += "</row>";
+    }
+    buf += "</data>";
+    write_file(filepath, buf);
+
+    string map =
+        "<?xml version=\"1.0\"?>\n"
+        "<map xmlns=\"http://gitorious.org/orcus/xml-map\">"
+        "<sheet name=\"data\"/><range row=\"0\" column=\"0\" sheet=\"data\">";
+    for (size_t col = 0; col < sheet.cols(); ++col)
+    {
+        map += "<field xpath=\"/data/row/c";
+        append_uint(map, col+1);
+        map += "\"/>";
+    }
+    map += "</range></map>";
+    write_file(map_filepath, map);
+}
+
+// ----------------------------------------------------------------------------
+
+void print_help()
+{
+    cout << "Usage: orcus-bench-corpus [options]" << endl;
+    cout << endl;
+    cout << "Generate a benchmark corpus of the same content in every supported format." << endl;
+    cout << endl;
+    cout << "Options:" << endl;
+    cout << "  --rows=N             number of rows per sheet (default: 1000)" << endl;
+    cout << "  --cols=N             number of columns per sheet (default: 10)" << endl;
+    cout << "  --sheets=N           number of sheets (default: 1)" << endl;
+    cout << "  --string-ratio=R     fraction of string cells (default: 0.2)" << endl;
+    cout << "  --formula-ratio=R    fraction of formula cells (default: 0.1)" << endl;
+    cout << "  --unique-strings=N   number of distinct strings (default: 1000)" << endl;
+    cout << "  --seed=N             seed of the content (default: 1)" << endl;
+    cout << "  --output-dir=DIR     directory to write the files to (default: .)" << endl;
+    cout << "  --name=NAME          base name of the files (default: bench-ROWSxCOLS)" << endl;
+    cout << endl;
+    cout << "The files written are NAME.xlsx, NAME.ods, NAME.gnumeric, NAME.xls.xml, NAME.csv," << endl;
+    cout << "and NAME.mapped.xml with its map file NAME.mapped.map.  The csv and the mapped" << endl;
+    cout << "xml files hold the first sheet only.  Formats that don't support formulas" << endl;
+    cout << "get the cached results of the formula cells as plain values." << endl;
+}
+
+/**
+ * Check if the argument is of the form --name=value.
+ */
+bool get_option(const char* arg, const char* name, string& value)
+{
+    size_t n = strlen(name);
+    if (strncmp(arg, "--", 2) || strncmp(arg+2, name, n) || arg[n+2] != '=')
+        return false;
+
+    value = arg + n + 3;
+    return true;
+}
+
+}
+
+/**
+ * Generate a deterministic corpus for orcus-bench.  The same parameters
+ * always produce byte-for-byte identical files.
+ */
+int main(int argc, char** argv)
+{
+    corpus_params params;
+    for (int i = 1; i < argc; ++i)
+    {
+        string v;
+        if (get_option(argv[i], "rows", v))
+            params.rows = strtoul(v.c_str(), NULL, 10);
+        else if (get_option(argv[i], "cols", v))
+            params.cols = strtoul(v.c_str(), NULL, 10);
+        else if (get_option(argv[i], "sheets", v))
+            params.sheets = strtoul(v.c_str(), NULL, 10);
+        else if (get_option(argv[i], "string-ratio", v))
+            params.string_ratio = strtod(v.c_str(), NULL);
+        else if (get_option(argv[i], "formula-ratio", v))
+            params.formula_ratio = strtod(v.c_str(), NULL);
+        else if (get_option(argv[i], "unique-strings", v))
+            params.unique_strings = strtoul(v.c_str(), NULL, 10);
+        else if (get_option(argv[i], "seed", v))
+            params.seed = strtoul(v.c_str(), NULL, 10);
+        else if (get_option(argv[i], "output-dir", v))
+            params.output_dir = v;
+        else if (get_option(argv[i], "name", v))
+            params.name = v;
+        else
+        {
+            print_help();
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!params.rows || !params.cols || !params.sheets || !params.unique_strings ||
+        params.string_ratio < 0.0 || params.formula_ratio < 0.0 ||
+        params.string_ratio + params.formula_ratio > 1.0)
+    {
+        cerr << "invalid corpus parameters." << endl;
+        return EXIT_FAILURE;
+    }
+
+    if (params.name.empty())
+    {
+        params.name = "bench-";
+        append_uint(params.name, params.rows);
+        params.name += 'x';
+        append_uint(params.name, params.cols);
+    }
+
+    string base = params.output_dir + "/" + params.name;
+
+    sheet_plans_type sheets;
+    try
+    {
+        rng gen(params.seed);
+        for (size_t i = 0; i < params.sheets; ++i)
+            sheets.push_back(new sheet_plan(params, gen));
+
+        write_xlsx(base + ".xlsx", sheets, params.unique_strings);
+        write_ods(base + ".ods", sheets);
+        write_gnumeric(base + ".gnumeric", sheets);
+        write_xls_xml(base + ".xls.xml", sheets);
+        write_csv(base + ".csv", *sheets[0]);
+        write_xml_mapped(base + ".mapped.xml", base + ".mapped.map", *sheets[0]);
+    }
+    catch (const std::exception& e)
+    {
+        cerr << e.what() << endl;
+        for (size_t i = 0; i < sheets.size(); ++i)
+            delete sheets[i];
+        return EXIT_FAILURE;
+    }
+
+    for (size_t i = 0; i < sheets.size(); ++i)
+        delete sheets[i];
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,197 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+
+#include "orcus/pstring.hpp"
+#include "orcus/spreadsheet/document.hpp"
+#include "orcus/spreadsheet/sheet.hpp"
+#include "orcus/parser_global.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <boost/scoped_ptr.hpp>
+
+using namespace std;
+using namespace orcus;
+
+namespace {
+
+string to_cell_name(spreadsheet::row_t row, spreadsheet::col_t col)
+{
+    string name;
+    for (++col; col > 0; col = (col - 1) / 26)
+        name.insert(name.begin(), 'A' + (col - 1) % 26);
+
+    ostringstream os;
+    os << name << (row + 1);
+    return os.str();
+}
+
+void set_formula(spreadsheet::sheet& sh, spreadsheet::row_t row, spreadsheet::col_t col, const string& formula)
+{
+    sh.set_formula(row, col, spreadsheet::xlsx_2007, formula.data(), formula.size());
+}
+
+/**
+ * Fill column A with a single chain of formula cells, each of which depends
+ * on the cell above it.  No two cells can be calculated in parallel.
+ */
+void build_chain(spreadsheet::document& doc, size_t cell_count)
+{
+    spreadsheet::sheet* sh = doc.append_sheet(pstring("chain"), cell_count, 1);
+    sh->set_value(0, 0, 1.0);
+    for (size_t i = 1; i < cell_count; ++i)
+    {
+        spreadsheet::row_t row = static_cast<spreadsheet::row_t>(i);
+        set_formula(*sh, row, 0, to_cell_name(row-1, 0) + "+1");
+    }
+}
+
+/**
+ * Fill a sheet with formula cells that all depend on A1 and on their own
+ * input cell in column A, but not on each other.  All cells can be
+ * calculated in parallel.
+ */
+void build_fan_out(spreadsheet::document& doc, size_t cell_count)
+{
+    const spreadsheet::col_t col_count = 100;
+    spreadsheet::row_t row_count = static_cast<spreadsheet::row_t>(cell_count / col_count + 1);
+
+    spreadsheet::sheet* sh = doc.append_sheet(pstring("fan-out"), row_count, col_count + 1);
+    for (spreadsheet::row_t row = 0; row < row_count; ++row)
+        sh->set_value(row, 0, row * 0.5);
+
+    for (size_t i = 0; i < cell_count; ++i)
+    {
+        spreadsheet::row_t row = static_cast<spreadsheet::row_t>(i / col_count);
+        spreadsheet::col_t col = static_cast<spreadsheet::col_t>(i % col_count) + 1;
+        set_formula(*sh, row, col, "$A$1*" + to_cell_name(row, 0) + "+" + to_cell_name(row, 0) + "/3");
+    }
+}
+
+typedef void (*build_func_t)(spreadsheet::document&, size_t);
+
+/**
+ * Build a fresh document and measure the time it takes to calculate all of
+ * its formula cells.  Building the document is not included.
+ */
+double calc_document(build_func_t build, size_t cell_count, size_t thread_count)
+{
+    boost::scoped_ptr<spreadsheet::document> doc(new spreadsheet::document);
+    build(*doc, cell_count);
+    doc->set_formula_calc_threads(thread_count);
+
+    double start = get_current_time();
+    doc->calc_formulas();
+    return get_current_time() - start;
+}
+
+void run(const char* name, build_func_t build, size_t cell_count, size_t max_threads)
+{
+    cout << name << " (" << cell_count << " formula cells)" << endl;
+
+    double base = 0.0;
+    for (size_t n = 0; n <= max_threads; ++n)
+    {
+        double duration = calc_document(build, cell_count, n);
+        if (n == 0)
+            base = duration;
+
+        cout << "  threads: " << n << "  time: " << duration << " sec  speed-up: " << (base / duration) << endl;
+    }
+}
+
+/**
+ * Build a fresh document and measure the time it takes to insert and
+ * finalize its formula cells, without calculating them.
+ */
+double tokenize_document(build_func_t build, size_t cell_count, size_t thread_count)
+{
+    boost::scoped_ptr<spreadsheet::document> doc(new spreadsheet::document);
+    doc->set_formula_tokenize_threads(thread_count);
+    doc->set_trust_cached_results(true);
+
+    double start = get_current_time();
+    build(*doc, cell_count);
+    doc->finalize();
+    return get_current_time() - start;
+}
+
+void run_tokenize(size_t cell_count, size_t max_threads)
+{
+    cout << "formula tokenization (" << cell_count << " formula cells)" << endl;
+
+    double base = 0.0;
+    for (size_t n = 0; n <= max_threads; ++n)
+    {
+        double duration = tokenize_document(build_fan_out, cell_count, n);
+        if (n == 0)
+            base = duration;
+
+        cout << "  threads: " << n << "  time: " << duration << " sec  speed-up: " << (base / duration) << endl;
+    }
+}
+
+}
+
+/**
+ * Measure the time it takes to calculate formula cells with 0 through N
+ * calculation threads, on a long dependency chain and on a wide fan-out of
+ * independent cells.  A thread count of 0 calculates on the calling thread.
+ *
+ * Then measure the time it takes to import and finalize formula cells with
+ * 0 through N tokenizer threads.  A thread count of 0 tokenizes each
+ * formula as it gets inserted.
+ *
+ * usage: orcus-perf-calc [formula cell count] [max thread count] [tokenized formula cell count]
+ */
+int main(int argc, char** argv)
+{
+    size_t cell_count = 200000;
+    if (argc > 1)
+        cell_count = strtoul(argv[1], NULL, 10);
+
+    size_t max_threads = 4;
+    if (argc > 2)
+        max_threads = strtoul(argv[2], NULL, 10);
+
+    size_t tokenize_cell_count = 1000000;
+    if (argc > 3)
+        tokenize_cell_count = strtoul(argv[3], NULL, 10);
+
+    if (!cell_count || !tokenize_cell_count)
+        return EXIT_FAILURE;
+
+    run("dependency chain", build_chain, cell_count, max_threads);
+    run("wide fan-out", build_fan_out, cell_count, max_threads);
+    run_tokenize(tokenize_cell_count, max_threads);
+
+    return EXIT_SUCCESS;
+}
@@ -35,8 +35,12 @@
 #include "orcus/spreadsheet/shared_strings.hpp"
 #include "orcus/spreadsheet/styles.hpp"
 
+#include <ixion/address.hpp>
+#include <ixion/model_context.hpp>
+
 #include <cstdlib>
 #include <cassert>
+#include <cmath>
 #include <string>
 #include <iostream>
 #include <sstream>
@@ -144,8 +148,8 @@ void test_ods_import_formatted_text()
     assert(str && *str == "Normal Text");
     size_t xfid = sh->get_cell_format(0,0);
     assert(xfid == 0); // ID of 0 represents default format.
-    const format_runs_t* fmt = ss->get_format_runs(str_id);
-    assert(!fmt); // The string should be unformatted.
+    format_runs_t fmt = ss->get_format_runs(str_id);
+    assert(fmt.empty()); // The string should be unformatted.
 
     // A2 is all bold via cell format.
     str_id = sh->get_string_identifier(1,0);
@@ -157,7 +161,7 @@ void test_ods_import_formatted_text()
     const font* font_data = styles->get_font(xf->font);
     assert(font_data && font_data->bold && !font_data->italic);
     fmt = ss->get_format_runs(str_id);
-    assert(!fmt); // This string should be unformatted.
+    assert(fmt.empty()); // This string should be unformatted.
 
     // A3 is all italic.
     str_id = sh->get_string_identifier(2,0);
@@ -169,7 +173,7 @@ void test_ods_import_formatted_text()
     font_data = styles->get_font(xf->font);
     assert(font_data && !font_data->bold && font_data->italic);
     fmt = ss->get_format_runs(str_id);
-    assert(!fmt); // This string should be unformatted.
+    assert(fmt.empty()); // This string should be unformatted.
 
     // A4 is all bolid and italic.
     str_id = sh->get_string_identifier(3,0);
@@ -181,7 +185,7 @@ void test_ods_import_formatted_text()
     font_data = styles->get_font(xf->font);
     assert(font_data && font_data->bold && font_data->italic);
     fmt = ss->get_format_runs(str_id);
-    assert(!fmt); // This string should be unformatted.
+    assert(fmt.empty()); // This string should be unformatted.
 
     // A5 has mixed format runs.
     str_id = sh->get_string_identifier(4,0);
@@ -192,14 +196,14 @@ void test_ods_import_formatted_text()
     assert(xf);
     font_data = styles->get_font(xf->font);
     fmt = ss->get_format_runs(str_id);
-    assert(fmt); // This string should be formatted.
+    assert(!fmt.empty()); // This string should be formatted.
 
     {
         // Check the bold format segment.
         bool_segment_type bold_runs(0, str->size(), font_data->bold);
-        for (size_t i = 0, n = fmt->size(); i < n; ++i)
+        for (size_t i = 0, n = fmt.size(); i < n; ++i)
         {
-            format_run run = fmt->at(i);
+            format_run run = fmt[i];
             bold_runs.insert_back(run.pos, run.pos+run.size, run.bold);
         }
 
@@ -225,9 +229,9 @@ void test_ods_import_formatted_text()
     {
         // Check the italic format segment.
         bool_segment_type italic_runs(0, str->size(), font_data->italic);
-        for (size_t i = 0, n = fmt->size(); i < n; ++i)
+        for (size_t i = 0, n = fmt.size(); i < n; ++i)
         {
-            format_run run = fmt->at(i);
+            format_run run = fmt[i];
             italic_runs.insert_back(run.pos, run.pos+run.size, run.italic);
         }
 
@@ -260,10 +264,114 @@ void test_ods_import_formatted_text()
 
 }
 
+void test_ods_import_date_cell()
+{
+    const char* filepath = SRCDIR"/test/ods/date-cell/input.ods";
+    document doc;
+    import_factory factory(&doc);
+    orcus_ods app(&factory);
+    app.read_file(filepath);
+
+    // This document uses 1904-01-01 as its null date.
+    const date_time_t& origin = doc.get_origin_date();
+    assert(origin.year == 1904 && origin.month == 1 && origin.day == 1);
+
+    // Date cells are stored as serial values relative to the null date.
+    const ixion::model_context& cxt = doc.get_model_context();
+    ixion::abs_address_t pos(0, 0, 1);
+    assert(cxt.get_celltype(pos) == ixion::celltype_numeric);
+    assert(cxt.get_numeric_value(pos) == 35788.0); // 2001-12-25
+
+    pos.row = 1;
+    assert(cxt.get_celltype(pos) == ixion::celltype_numeric);
+    double expected = 39911.0 + (21*3600 + 34*60 + 9) / 86400.0; // 2013-04-09T21:34:09
+    assert(std::fabs(cxt.get_numeric_value(pos) - expected) < 1e-9);
+}
+
+void test_ods_import_repeated_cells()
+{
+    const char* filepath = SRCDIR"/test/ods/repeated-cells/input.ods";
+    document doc;
+    import_factory factory(&doc);
+    orcus_ods app(&factory);
+    app.read_file(filepath);
+
+    assert(doc.sheet_size() > 0);
+    spreadsheet::sheet* sh = doc.get_sheet(0);
+    assert(sh);
+    const ixion::model_context& cxt = doc.get_model_context();
+
+    // A1:C1 contain 1, and D1:E1 contain 'A'.
+    for (col_t col = 0; col <= 2; ++col)
+        assert(cxt.get_numeric_value(ixion::abs_address_t(0, 0, col)) == 1.0);
+
+    const import_shared_strings* ss = doc.get_shared_strings();
+    assert(ss);
+    for (col_t col = 3; col <= 4; ++col)
+    {
+        const string* str = ss->get_string(sh->get_string_identifier(0, col));
+        assert(str && *str == "A");
+    }
+
+    // Row 2 is repeated 3 times, with 5 in column A, a bold empty cell in
+    // column B, and 7 in columns C and D.
+    for (row_t row = 1; row <= 3; ++row)
+    {
+        assert(cxt.get_numeric_value(ixion::abs_address_t(0, row, 0)) == 5.0);
+        assert(cxt.get_celltype(ixion::abs_address_t(0, row, 1)) == ixion::celltype_empty);
+        assert(cxt.get_numeric_value(ixion::abs_address_t(0, row, 2)) == 7.0);
+        assert(cxt.get_numeric_value(ixion::abs_address_t(0, row, 3)) == 7.0);
+    }
+
+    assert(cxt.get_numeric_value(ixion::abs_address_t(0, 4, 0)) == 9.0);
+
+    // B5:C5 contain the date 2013-04-09T21:34:09, relative to the default
+    // null date 1899-12-30.
+    double date_value = 41373.0 + (21*3600 + 34*60 + 9) / 86400.0;
+    for (col_t col = 1; col <= 2; ++col)
+    {
+        ixion::abs_address_t pos(0, 4, col);
+        assert(cxt.get_celltype(pos) == ixion::celltype_numeric);
+        assert(std::fabs(cxt.get_numeric_value(pos) - date_value) < 1e-9);
+    }
+
+    // The bold cell format covers B2:B4, and all cells in rows 6 to 8.
+    size_t xfid = sh->get_cell_format(1, 1);
+    assert(xfid != 0);
+    const import_styles* styles = doc.get_styles();
+    assert(styles);
+    const cell_format* xf = styles->get_cell_format(xfid);
+    assert(xf);
+    const font* font_data = styles->get_font(xf->font);
+    assert(font_data && font_data->bold);
+
+    assert(sh->get_cell_format(3, 1) == xfid);
+    assert(sh->get_cell_format(4, 1) == 0);
+    assert(sh->get_cell_format(5, 0) == xfid);
+    assert(sh->get_cell_format(7, 1023) == xfid);
+
+    // Row 9 contains 11 in all columns, clipped to the last column.
+    assert(cxt.get_numeric_value(ixion::abs_address_t(0, 8, 0)) == 11.0);
+    assert(cxt.get_numeric_value(ixion::abs_address_t(0, 8, 1023)) == 11.0);
+    assert(sh->get_cell_format(8, 0) == 0);
+
+    // The format-only rows after the last row with values are skipped.
+    assert(sh->get_cell_format(9, 0) == 0);
+    assert(sh->get_cell_format(500000, 512) == 0);
+    assert(sh->get_cell_format(1048574, 1023) == 0);
+
+    // Empty rows keep being repeated past the end of the sheet, 2^32 rows
+    // in total, before a last row with 13 in column A.  That row is outside
+    // of the sheet, and must not wrap around onto the first row.
+    assert(cxt.get_numeric_value(ixion::abs_address_t(0, 0, 0)) == 1.0);
+}
+
 int main()
 {
     test_ods_import_cell_values();
     test_ods_import_column_widths_row_heights();
     test_ods_import_formatted_text();
+    test_ods_import_date_cell();
+    test_ods_import_repeated_cells();
     return EXIT_SUCCESS;
 }
@@ -83,10 +83,68 @@ void test_xlsx_import()
     }
 }
 
+void test_xlsx_parallel_finalize()
+{
+    const char* path = SRCDIR"/test/xlsx/raw-values-1/input.xlsx";
+    string checks[2];
+    size_t thread_counts[] = { 0, 4 };
+    for (size_t i = 0; i < 2; ++i)
+    {
+        boost::scoped_ptr<spreadsheet::document> doc(new spreadsheet::document);
+        doc->set_finalize_threads(thread_counts[i]);
+        orcus_xlsx app(new spreadsheet::import_factory(doc.get()));
+        app.read_file(path);
+
+        ostringstream os;
+        doc->dump_check(os);
+        checks[i] = os.str();
+    }
+
+    assert(!checks[0].empty());
+    assert(checks[0] == checks[1]);
+}
+
+string dump_formula_simple(bool trust_cached_results, size_t tokenize_threads = 0)
+{
+    string path(SRCDIR"/test/xlsx/formula-simple.xlsx");
+    boost::scoped_ptr<spreadsheet::document> doc(new spreadsheet::document);
+    doc->set_trust_cached_results(trust_cached_results);
+    doc->set_formula_tokenize_threads(tokenize_threads);
+    orcus_xlsx app(new spreadsheet::import_factory(doc.get()));
+    app.read_file(path.c_str());
+
+    ostringstream os;
+    doc->dump_check(os);
+    return os.str();
+}
+
+void test_xlsx_cached_results()
+{
+    // The results cached in the file must match the calculated ones.
+    string cached = dump_formula_simple(true);
+    string calculated = dump_formula_simple(false);
+    assert(!cached.empty());
+    assert(cached == calculated);
+}
+
+void test_xlsx_deferred_tokenization()
+{
+    string immediate = dump_formula_simple(false);
+    size_t thread_counts[] = { 1, 2, 4 };
+    for (size_t i = 0; i < sizeof(thread_counts)/sizeof(thread_counts[0]); ++i)
+    {
+        string deferred = dump_formula_simple(false, thread_counts[i]);
+        assert(deferred == immediate);
+    }
+}
+
 }
 
 int main()
 {
     test_xlsx_import();
+    test_xlsx_cached_results();
+    test_xlsx_deferred_tokenization();
+    test_xlsx_parallel_finalize();
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,627 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+#include "deflate_decoder.hpp"
+
+#include "orcus/zip_archive.hpp"
+
+#include <cstring>
+#include <algorithm>
+
+using boost::uint16_t;
+using boost::uint32_t;
+using boost::uint64_t;
+
+namespace orcus {
+
+namespace {
+
+const unsigned int max_code_length = 15;
+const unsigned int litlen_primary_bits = 10;
+const unsigned int dist_primary_bits = 8;
+const unsigned int codelen_primary_bits = 7;
+
+const uint32_t subtable_flag = 0x80000000;
+
+const uint16_t length_base[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+
+const unsigned char length_extra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+const uint16_t dist_base[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+
+const unsigned char dist_extra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+/**
+ * Order in which the code lengths of the code length alphabet are stored.
+ */
+const unsigned char codelen_order[19] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define ORCUS_DEFLATE_WORD_REFILL 1
+#else
+#define ORCUS_DEFLATE_WORD_REFILL 0
+#endif
+
+/**
+ * Top up the bit buffer to at least 56 bits.  Past the end of the input,
+ * zero bytes are fed instead, and counted as padding.
+ */
+inline void refill_bits(
+    uint64_t& bits, unsigned int& bit_count, const unsigned char*& p, const unsigned char* p_end,
+    size_t& padding)
+{
+#if ORCUS_DEFLATE_WORD_REFILL
+    if (p_end - p >= 8)
+    {
+        // Load 8 bytes at once, and keep as many whole bytes as fit.  The
+        // bits of the byte that doesn't fit land exactly where the next
+        // load puts them again.
+        uint64_t word;
+        std::memcpy(&word, p, 8);
+        bits |= word << bit_count;
+        p += (63 - bit_count) >> 3;
+        bit_count |= 56;
+        return;
+    }
+#endif
+
+    for (; bit_count <= 56; bit_count += 8)
+    {
+        uint64_t byte = 0;
+        if (p != p_end)
+            byte = *p++;
+        else
+            ++padding;
+
+        bits |= byte << bit_count;
+    }
+}
+
+/**
+ * Look up the table entry for the code at the front of the bit buffer.
+ */
+inline uint32_t lookup_entry(const uint32_t* entries, unsigned int primary_bits, uint64_t bits)
+{
+    uint32_t entry = entries[bits & ((1u << primary_bits) - 1)];
+    if (entry & subtable_flag)
+    {
+        unsigned int sub_bits = (entry >> 24) & 0x7F;
+        size_t offset = entry & 0xFFFFFF;
+        entry = entries[offset + ((bits >> primary_bits) & ((1u << sub_bits) - 1))];
+    }
+    return entry;
+}
+
+/**
+ * Copy n bytes of a back reference.  The source may overlap the
+ * destination, in which case the last 'distance' bytes get repeated.
+ * When 'slack' is true, up to 8 bytes past the end of the match may be
+ * written over.
+ */
+inline void copy_back_reference(unsigned char* dst, size_t n, size_t distance, bool slack)
+{
+    const unsigned char* src = dst - distance;
+    if (slack && distance >= 8)
+    {
+        // Copy a word at a time.  The source never catches up with the
+        // destination.
+        for (unsigned char* end = dst + n; dst < end; dst += 8, src += 8)
+            std::memcpy(dst, src, 8);
+        return;
+    }
+
+    if (distance == 1)
+    {
+        std::memset(dst, *src, n);
+        return;
+    }
+
+    if (distance >= n)
+    {
+        std::memcpy(dst, src, n);
+        return;
+    }
+
+    for (size_t i = 0; i < n; ++i)
+        dst[i] = src[i];
+}
+
+/**
+ * Reverse the order of the lowest n bits of a code, n being at most 16.
+ */
+inline unsigned int reverse_bits(unsigned int code, unsigned int n)
+{
+    code = ((code & 0x5555) << 1) | ((code >> 1) & 0x5555);
+    code = ((code & 0x3333) << 2) | ((code >> 2) & 0x3333);
+    code = ((code & 0x0F0F) << 4) | ((code >> 4) & 0x0F0F);
+    code = ((code & 0x00FF) << 8) | ((code >> 8) & 0x00FF);
+    return code >> (16 - n);
+}
+
+}
+
+void deflate_decoder::huffman_table::build(const unsigned char* lengths, size_t n, unsigned int _primary_bits)
+{
+    primary_bits = _primary_bits;
+    const unsigned int primary_size = 1u << primary_bits;
+
+    unsigned int counts[max_code_length+1];
+    std::fill(counts, counts+max_code_length+1, 0);
+    for (size_t i = 0; i < n; ++i)
+        ++counts[lengths[i]];
+    counts[0] = 0;
+
+    // Reject over-subscribed codes.  Incomplete codes are allowed; lookups
+    // of unused codes hit an empty entry and get rejected at decoding.
+    int left = 1;
+    for (unsigned int len = 1; len <= max_code_length; ++len)
+    {
+        left = (left << 1) - counts[len];
+        if (left < 0)
+            throw zip_error("invalid huffman code in compressed data stream.");
+    }
+
+    unsigned int next_code[max_code_length+1];
+    unsigned int code = 0;
+    next_code[0] = 0;
+    for (unsigned int len = 1; len <= max_code_length; ++len)
+    {
+        code = (code + counts[len-1]) << 1;
+        next_code[len] = code;
+    }
+
+    // Assign the canonical codes, in the bit order they are read in, and
+    // find the longest code that shares each primary prefix.
+    uint16_t codes[320];
+    unsigned char sub_max[1u << litlen_primary_bits];
+    std::fill(sub_max, sub_max+primary_size, 0);
+    for (size_t sym = 0; sym < n; ++sym)
+    {
+        unsigned int len = lengths[sym];
+        if (!len)
+            continue;
+
+        unsigned int rev = reverse_bits(next_code[len]++, len);
+        codes[sym] = static_cast<uint16_t>(rev);
+        if (len > primary_bits)
+        {
+            unsigned char& m = sub_max[rev & (primary_size-1)];
+            m = std::max<unsigned char>(m, len);
+        }
+    }
+
+    entries.assign(primary_size, 0);
+    for (unsigned int prefix = 0; prefix < primary_size; ++prefix)
+    {
+        if (!sub_max[prefix])
+            continue;
+
+        uint32_t sub_bits = sub_max[prefix] - primary_bits;
+        uint32_t offset = entries.size();
+        entries.resize(offset + (1u << sub_bits), 0);
+        entries[prefix] = subtable_flag | (sub_bits << 24) | offset;
+    }
+
+    for (size_t sym = 0; sym < n; ++sym)
+    {
+        unsigned int len = lengths[sym];
+        if (!len)
+            continue;
+
+        uint32_t entry = static_cast<uint32_t>(sym) | (len << 16);
+        unsigned int rev = codes[sym];
+        if (len <= primary_bits)
+        {
+            for (unsigned int i = rev; i < primary_size; i += 1u << len)
+                entries[i] = entry;
+            continue;
+        }
+
+        uint32_t sub = entries[rev & (primary_size-1)];
+        unsigned int sub_bits = (sub >> 24) & 0x7F;
+        size_t offset = sub & 0xFFFFFF;
+        for (unsigned int i = rev >> primary_bits; i < (1u << sub_bits); i += 1u << (len - primary_bits))
+            entries[offset+i] = entry;
+    }
+}
+
+deflate_decoder::deflate_decoder() :
+    mp_in(NULL), mp_in_end(NULL), mp_out(NULL), m_out_size(0), m_out_pos(0),
+    m_bits(0), m_bit_count(0), m_padding(0),
+    m_block(block_none), m_final_block(false), m_stored_remains(0),
+    m_match_length(0), m_match_distance(0),
+    mp_litlen(NULL), mp_dist(NULL)
+{
+}
+
+void deflate_decoder::reset(const unsigned char* in, size_t in_size, unsigned char* out, size_t out_size)
+{
+    mp_in = in;
+    mp_in_end = in + in_size;
+    mp_out = out;
+    m_out_size = out_size;
+    m_out_pos = 0;
+    m_bits = 0;
+    m_bit_count = 0;
+    m_padding = 0;
+    m_block = block_none;
+    m_final_block = false;
+    m_stored_remains = 0;
+    m_match_length = 0;
+    m_match_distance = 0;
+    mp_litlen = NULL;
+    mp_dist = NULL;
+}
+
+size_t deflate_decoder::decode(size_t out_limit)
+{
+    if (out_limit > m_out_size)
+        out_limit = m_out_size;
+
+    while (m_out_pos < out_limit)
+    {
+        if (m_match_length)
+        {
+            copy_match(m_match_length, m_match_distance, out_limit);
+            continue;
+        }
+
+        switch (m_block)
+        {
+            case block_none:
+                if (m_final_block)
+                    // The stream has ended short of the declared size.
+                    return m_out_pos;
+
+                read_block_header();
+            break;
+            case block_stored:
+                copy_stored(out_limit);
+            break;
+            case block_huffman:
+                decode_huffman(out_limit);
+            break;
+        }
+    }
+
+    check_input();
+    return m_out_pos;
+}
+
+bool deflate_decoder::finished() const
+{
+    return m_final_block && m_block == block_none;
+}
+
+void deflate_decoder::refill()
+{
+    refill_bits(m_bits, m_bit_count, mp_in, mp_in_end, m_padding);
+}
+
+unsigned int deflate_decoder::read_bits(unsigned int n)
+{
+    if (m_bit_count < n)
+        refill();
+
+    unsigned int v = static_cast<unsigned int>(m_bits & ((uint64_t(1) << n) - 1));
+    m_bits >>= n;
+    m_bit_count -= n;
+    return v;
+}
+
+unsigned int deflate_decoder::decode_symbol(const huffman_table& table)
+{
+    if (m_bit_count < max_code_length)
+        refill();
+
+    uint32_t entry = lookup_entry(&table.entries[0], table.primary_bits, m_bits);
+    unsigned int len = (entry >> 16) & 0xFF;
+    if (!len)
+        throw zip_error("invalid huffman code in compressed data stream.");
+
+    m_bits >>= len;
+    m_bit_count -= len;
+    return entry & 0xFFFF;
+}
+
+void deflate_decoder::check_input() const
+{
+    // The bit buffer may hold zero bytes fed past the end of the input.
+    // Having consumed any of them means the input has run out.
+    if (m_padding * 8 > m_bit_count)
+        throw zip_error("compressed data stream ended prematurely.");
+}
+
+void deflate_decoder::read_block_header()
+{
+    check_input();
+    m_final_block = read_bits(1) != 0;
+    switch (read_bits(2))
+    {
+        case 0:
+        {
+            // Stored block.  Skip to the byte boundary.
+            read_bits(m_bit_count & 7);
+            unsigned int len = read_bits(16);
+            unsigned int nlen = read_bits(16);
+            if (len != (~nlen & 0xFFFF))
+                throw zip_error("invalid stored block length in compressed data stream.");
+
+            check_input();
+            m_stored_remains = len;
+            m_block = block_stored;
+        }
+        break;
+        case 1:
+            build_fixed_tables();
+            mp_litlen = &m_fixed_litlen;
+            mp_dist = &m_fixed_dist;
+            m_block = block_huffman;
+        break;
+        case 2:
+            read_dynamic_tables();
+            mp_litlen = &m_litlen;
+            mp_dist = &m_dist;
+            m_block = block_huffman;
+        break;
+        default:
+            throw zip_error("invalid block type in compressed data stream.");
+    }
+}
+
+void deflate_decoder::read_dynamic_tables()
+{
+    unsigned int hlit = read_bits(5) + 257;
+    unsigned int hdist = read_bits(5) + 1;
+    unsigned int hclen = read_bits(4) + 4;
+    if (hlit > 286 || hdist > 30)
+        throw zip_error("invalid code counts in compressed data stream.");
+
+    unsigned char lengths[320];
+    std::fill(lengths, lengths+19, 0);
+    for (unsigned int i = 0; i < hclen; ++i)
+        lengths[codelen_order[i]] = static_cast<unsigned char>(read_bits(3));
+
+    m_codelen.build(lengths, 19, codelen_primary_bits);
+
+    unsigned int total = hlit + hdist;
+    for (unsigned int n = 0; n < total; )
+    {
+        unsigned int sym = decode_symbol(m_codelen);
+        if (sym < 16)
+        {
+            lengths[n++] = static_cast<unsigned char>(sym);
+            continue;
+        }
+
+        unsigned char value = 0;
+        unsigned int repeat = 0;
+        switch (sym)
+        {
+            case 16:
+                if (!n)
+                    throw zip_error("invalid code length repeat in compressed data stream.");
+                value = lengths[n-1];
+                repeat = 3 + read_bits(2);
+            break;
+            case 17:
+                repeat = 3 + read_bits(3);
+            break;
+            default:
+                repeat = 11 + read_bits(7);
+        }
+
+        if (n + repeat > total)
+            throw zip_error("invalid code length repeat in compressed data stream.");
+
+        std::fill(lengths+n, lengths+n+repeat, value);
+        n += repeat;
+    }
+
+    if (!lengths[256])
+        throw zip_error("missing end-of-block code in compressed data stream.");
+
+    m_litlen.build(lengths, hlit, litlen_primary_bits);
+    m_dist.build(lengths+hlit, hdist, dist_primary_bits);
+}
+
+void deflate_decoder::build_fixed_tables()
+{
+    if (!m_fixed_litlen.entries.empty())
+        return;
+
+    unsigned char lengths[288];
+    std::fill(lengths, lengths+144, 8);
+    std::fill(lengths+144, lengths+256, 9);
+    std::fill(lengths+256, lengths+280, 7);
+    std::fill(lengths+280, lengths+288, 8);
+    m_fixed_litlen.build(lengths, 288, litlen_primary_bits);
+
+    std::fill(lengths, lengths+30, 5);
+    m_fixed_dist.build(lengths, 30, dist_primary_bits);
+}
+
+void deflate_decoder::copy_stored(size_t out_limit)
+{
+    size_t n = std::min(m_stored_remains, out_limit - m_out_pos);
+    if (n > m_out_size - m_out_pos)
+        throw zip_error("data stream is longer than its declared size.");
+
+    // Take the bytes left in the bit buffer first.  It is byte-aligned at
+    // this point.
+    for (; n && m_bit_count >= 8; --n)
+    {
+        if (m_bit_count / 8 <= m_padding)
+            throw zip_error("compressed data stream ended prematurely.");
+
+        mp_out[m_out_pos++] = static_cast<unsigned char>(m_bits & 0xFF);
+        m_bits >>= 8;
+        m_bit_count -= 8;
+        --m_stored_remains;
+    }
+
+    if (n)
+    {
+        // The bit buffer is empty, but may still hold bits of the bytes
+        // that are about to be copied.
+        m_bits = 0;
+
+        if (static_cast<size_t>(mp_in_end - mp_in) < n)
+            throw zip_error("compressed data stream ended prematurely.");
+
+        std::memcpy(mp_out + m_out_pos, mp_in, n);
+        mp_in += n;
+        m_out_pos += n;
+        m_stored_remains -= n;
+    }
+
+    if (!m_stored_remains)
+        m_block = block_none;
+}
+
+void deflate_decoder::decode_huffman(size_t out_limit)
+{
+    // Work on local copies of the decoder state so that they can stay in
+    // registers; the writes to the output would otherwise force them to be
+    // reloaded after every byte.
+    const uint32_t* litlen = &mp_litlen->entries[0];
+    const unsigned int litlen_bits = mp_litlen->primary_bits;
+    const uint32_t* dist = &mp_dist->entries[0];
+    const unsigned int dist_bits = mp_dist->primary_bits;
+
+    uint64_t bits = m_bits;
+    unsigned int bit_count = m_bit_count;
+    const unsigned char* p = mp_in;
+    const unsigned char* p_end = mp_in_end;
+    unsigned char* out = mp_out;
+    size_t pos = m_out_pos;
+
+    while (pos < out_limit)
+    {
+        // A length code with its extra bits and a distance code with its
+        // extra bits take up to 48 bits.
+        if (bit_count < 48)
+            refill_bits(bits, bit_count, p, p_end, m_padding);
+
+        uint32_t entry = lookup_entry(litlen, litlen_bits, bits);
+        unsigned int len = (entry >> 16) & 0xFF;
+        if (!len)
+            throw zip_error("invalid huffman code in compressed data stream.");
+
+        bits >>= len;
+        bit_count -= len;
+        unsigned int sym = entry & 0xFFFF;
+
+        if (sym < 256)
+        {
+            out[pos++] = static_cast<unsigned char>(sym);
+            continue;
+        }
+
+        if (sym == 256)
+        {
+            m_block = block_none;
+            break;
+        }
+
+        sym -= 257;
+        if (sym >= 29)
+            throw zip_error("invalid length code in compressed data stream.");
+
+        unsigned int extra = length_extra[sym];
+        size_t length = length_base[sym] + static_cast<size_t>(bits & ((1u << extra) - 1));
+        bits >>= extra;
+        bit_count -= extra;
+
+        entry = lookup_entry(dist, dist_bits, bits);
+        len = (entry >> 16) & 0xFF;
+        if (!len)
+            throw zip_error("invalid huffman code in compressed data stream.");
+
+        bits >>= len;
+        bit_count -= len;
+        sym = entry & 0xFFFF;
+        if (sym >= 30)
+            throw zip_error("invalid distance code in compressed data stream.");
+
+        extra = dist_extra[sym];
+        size_t distance = dist_base[sym] + static_cast<size_t>(bits & ((1u << extra) - 1));
+        bits >>= extra;
+        bit_count -= extra;
+
+        if (distance > pos)
+            throw zip_error("invalid distance in compressed data stream.");
+
+        if (length > m_out_size - pos)
+            throw zip_error("data stream is longer than its declared size.");
+
+        if (length + 8 <= out_limit - pos)
+        {
+            copy_back_reference(out + pos, length, distance, true);
+            pos += length;
+            continue;
+        }
+
+        // The match reaches the output limit.  Copy what fits, and leave
+        // the rest for the next call.
+        size_t n = std::min(length, out_limit - pos);
+        copy_back_reference(out + pos, n, distance, false);
+        pos += n;
+        m_match_length = length - n;
+        m_match_distance = distance;
+    }
+
+    m_bits = bits;
+    m_bit_count = bit_count;
+    mp_in = p;
+    m_out_pos = pos;
+}
+
+void deflate_decoder::copy_match(size_t length, size_t distance, size_t out_limit)
+{
+    size_t n = std::min(length, out_limit - m_out_pos);
+    copy_back_reference(mp_out + m_out_pos, n, distance, false);
+    m_out_pos += n;
+    m_match_length = length - n;
+    m_match_distance = distance;
+}
+
+}
@@ -0,0 +1,137 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+#ifndef __ORCUS_DEFLATE_DECODER_HPP__
+#define __ORCUS_DEFLATE_DECODER_HPP__
+
+#include <cstdlib>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+
+namespace orcus {
+
+/**
+ * Decoder for raw deflate streams (RFC 1951) whose compressed data is
+ * available in memory in its entirety, and whose uncompressed size is known
+ * up front, as is the case with zip file entries.
+ *
+ * The output goes into a single buffer large enough for the whole
+ * uncompressed stream.  Back references are copied straight from the
+ * output written so far, so no separate history window is maintained.
+ * Decoding can stop at any output position and resume later, which allows
+ * the output to be consumed one segment at a time.
+ */
+class deflate_decoder
+{
+public:
+    deflate_decoder();
+
+    /**
+     * Start decoding a new stream.
+     *
+     * @param in compressed data stream.  It must stay valid until decoding
+     *           finishes.
+     * @param in_size size of the compressed data stream.
+     * @param out buffer to write the uncompressed stream into.
+     * @param out_size size of the uncompressed stream.
+     */
+    void reset(const unsigned char* in, size_t in_size, unsigned char* out, size_t out_size);
+
+    /**
+     * Decode until the output reaches the specified position, or until the
+     * end of the stream.  A zip_error is thrown if the stream is malformed.
+     *
+     * @param out_limit output position to stop at.
+     *
+     * @return number of bytes written to the output buffer so far.
+     */
+    size_t decode(size_t out_limit);
+
+    /**
+     * @return true if the final block of the stream has been decoded.
+     */
+    bool finished() const;
+
+    /**
+     * Two-level lookup table of a Huffman code.  Codes that are not longer
+     * than the primary bits are looked up with a single access; longer codes
+     * go through a sub-table.
+     */
+    struct huffman_table
+    {
+        std::vector<boost::uint32_t> entries;
+        unsigned int primary_bits;
+
+        void build(const unsigned char* lengths, size_t n, unsigned int _primary_bits);
+    };
+
+private:
+    void refill();
+    unsigned int read_bits(unsigned int n);
+    unsigned int decode_symbol(const huffman_table& table);
+    void check_input() const;
+
+    void read_block_header();
+    void read_dynamic_tables();
+    void build_fixed_tables();
+
+    void copy_stored(size_t out_limit);
+    void decode_huffman(size_t out_limit);
+    void copy_match(size_t length, size_t distance, size_t out_limit);
+
+private:
+    enum block_state { block_none, block_stored, block_huffman };
+
+    const unsigned char* mp_in;
+    const unsigned char* mp_in_end;
+    unsigned char* mp_out;
+    size_t m_out_size;
+    size_t m_out_pos;
+
+    boost::uint64_t m_bits;
+    unsigned int m_bit_count;
+    size_t m_padding;        // number of zero bytes fed past the end of the input.
+
+    block_state m_block;
+    bool m_final_block;
+    size_t m_stored_remains;
+    size_t m_match_length;   // remaining length of a match suspended mid-copy.
+    size_t m_match_distance;
+
+    const huffman_table* mp_litlen;
+    const huffman_table* mp_dist;
+    huffman_table m_litlen;
+    huffman_table m_dist;
+    huffman_table m_codelen;
+    huffman_table m_fixed_litlen;
+    huffman_table m_fixed_dist;
+};
+
+}
+
+#endif
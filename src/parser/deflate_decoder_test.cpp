@@ -0,0 +1,207 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+#include "deflate_decoder.hpp"
+#include "orcus/zip_archive.hpp"
+
+#include <zlib.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <iostream>
+
+using namespace std;
+using namespace orcus;
+
+namespace {
+
+/**
+ * Compress a data stream into a raw deflate stream with zlib.
+ */
+vector<unsigned char> compress(const string& data, int level, int strategy)
+{
+    z_stream cxt;
+    memset(&cxt, 0, sizeof(cxt));
+    int err = deflateInit2(&cxt, level, Z_DEFLATED, -MAX_WBITS, 8, strategy);
+    assert(err == Z_OK);
+
+    vector<unsigned char> buf(deflateBound(&cxt, data.size()));
+    cxt.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    cxt.avail_in = data.size();
+    cxt.next_out = &buf[0];
+    cxt.avail_out = buf.size();
+    err = deflate(&cxt, Z_FINISH);
+    assert(err == Z_STREAM_END);
+    buf.resize(cxt.total_out);
+    deflateEnd(&cxt);
+    return buf;
+}
+
+/**
+ * Generate a data stream of the specified kind: random bytes, which end up
+ * in stored blocks, text from a small alphabet, which mostly uses literals,
+ * and text with many repeats, which mostly uses back references.
+ */
+string generate(size_t n, int kind)
+{
+    const char* alphabet = "<row r=\"1\">0123";
+    string data(n, '\0');
+    for (size_t i = 0; i < n; ++i)
+    {
+        switch (kind)
+        {
+            case 0:
+                data[i] = rand() % 256;
+            break;
+            case 1:
+                data[i] = alphabet[rand() % 15];
+            break;
+            default:
+                data[i] = i > 64 && rand() % 8 ? data[i - 1 - rand() % 64] : 'a' + rand() % 26;
+        }
+    }
+    return data;
+}
+
+/**
+ * Decode a compressed stream in segments of the specified size.
+ */
+string decode(const vector<unsigned char>& in, size_t size, size_t step)
+{
+    vector<unsigned char> out(size+1, 0xEE);
+    deflate_decoder decoder;
+    decoder.reset(in.empty() ? NULL : &in[0], in.size(), &out[0], size);
+
+    size_t pos = 0;
+    while (pos < size)
+    {
+        size_t next = decoder.decode(pos+step);
+        assert(next > pos);
+        assert(next == std::min(pos+step, size));
+        pos = next;
+    }
+
+    // Nothing gets written past the declared size.
+    assert(out[size] == 0xEE);
+    return string(out.begin(), out.begin()+size);
+}
+
+}
+
+void test_round_trip()
+{
+    const int strategies[] = { Z_DEFAULT_STRATEGY, Z_FIXED, Z_HUFFMAN_ONLY, Z_RLE };
+    const size_t sizes[] = { 0, 1, 100, 5000, 70000, 300000 };
+
+    srand(3);
+    for (size_t i = 0; i < sizeof(sizes)/sizeof(sizes[0]); ++i)
+    {
+        for (int kind = 0; kind < 3; ++kind)
+        {
+            string data = generate(sizes[i], kind);
+            for (int level = 0; level <= 9; level += 3)
+            {
+                for (size_t j = 0; j < sizeof(strategies)/sizeof(strategies[0]); ++j)
+                {
+                    vector<unsigned char> in = compress(data, level, strategies[j]);
+                    assert(decode(in, data.size(), data.size()+1) == data);
+                    assert(decode(in, data.size(), 1 + rand() % 4096) == data);
+                }
+            }
+        }
+    }
+}
+
+void test_short_stream()
+{
+    // A stream that ends short of the declared size stops there.
+    string data = generate(10000, 2);
+    vector<unsigned char> in = compress(data, 6, Z_DEFAULT_STRATEGY);
+    vector<unsigned char> out(data.size()*2);
+    deflate_decoder decoder;
+    decoder.reset(&in[0], in.size(), &out[0], out.size());
+    assert(decoder.decode(out.size()) == data.size());
+    assert(decoder.finished());
+    assert(string(out.begin(), out.begin()+data.size()) == data);
+}
+
+void test_malformed_stream()
+{
+    string data = generate(100000, 2);
+    vector<unsigned char> in = compress(data, 6, Z_DEFAULT_STRATEGY);
+    vector<unsigned char> out(data.size());
+
+    // Truncated input.
+    deflate_decoder decoder;
+    decoder.reset(&in[0], in.size()/2, &out[0], out.size());
+    try
+    {
+        decoder.decode(out.size());
+        assert(!"exception was not thrown");
+    }
+    catch (const zip_error& e)
+    {
+        cout << "expected error: " << e.what() << endl;
+    }
+
+    // Invalid block type.
+    unsigned char bad_block[] = { 0x07, 0x00, 0x00, 0x00 };
+    decoder.reset(bad_block, sizeof(bad_block), &out[0], out.size());
+    try
+    {
+        decoder.decode(out.size());
+        assert(!"exception was not thrown");
+    }
+    catch (const zip_error& e)
+    {
+        cout << "expected error: " << e.what() << endl;
+    }
+
+    // Stored block whose length doesn't match its complement.
+    unsigned char bad_stored[] = { 0x01, 0x05, 0x00, 0x00, 0x00, 'a', 'b', 'c', 'd', 'e' };
+    decoder.reset(bad_stored, sizeof(bad_stored), &out[0], out.size());
+    try
+    {
+        decoder.decode(out.size());
+        assert(!"exception was not thrown");
+    }
+    catch (const zip_error& e)
+    {
+        cout << "expected error: " << e.what() << endl;
+    }
+}
+
+int main()
+{
+    test_round_trip();
+    test_short_stream();
+    test_malformed_stream();
+    return EXIT_SUCCESS;
+}
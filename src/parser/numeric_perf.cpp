@@ -0,0 +1,129 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+#include "orcus/parser_global.hpp"
+
+#include <cstdlib>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <iostream>
+
+using namespace std;
+using namespace orcus;
+
+namespace {
+
+const size_t value_count = 1000000;
+const size_t repeat_count = 10;
+
+/**
+ * Values the way they appear in spreadsheet documents: integers, values
+ * written with 15 or 17 significant digits, and short decimals.
+ */
+void generate_values(vector<string>& values)
+{
+    values.reserve(value_count);
+    srand(1);
+    char buf[64];
+    for (size_t i = 0; i < value_count; ++i)
+    {
+        double v = static_cast<double>(rand()) / RAND_MAX * 1000000.0;
+        switch (i % 4)
+        {
+            case 0:
+                sprintf(buf, "%d", rand() % 100000);
+            break;
+            case 1:
+                sprintf(buf, "%.15g", v);
+            break;
+            case 2:
+                sprintf(buf, "%.17g", v / 1000.0);
+            break;
+            default:
+                sprintf(buf, "%.2f", v);
+        }
+        values.push_back(buf);
+    }
+}
+
+template<typename _Func>
+void run(const char* label, const vector<string>& values, _Func func)
+{
+    double sum = 0.0;
+    double start = get_current_time();
+    for (size_t i = 0; i < repeat_count; ++i)
+    {
+        for (size_t j = 0, n = values.size(); j < n; ++j)
+            sum += func(values[j]);
+    }
+    double duration = get_current_time() - start;
+
+    double count = static_cast<double>(values.size()) * repeat_count;
+    cout << label << ": " << (count / duration / 1000000.0) << " M values/s (checksum " << sum << ")" << endl;
+}
+
+double by_parse_numeric(const string& s)
+{
+    const char* p = s.data();
+    return parse_numeric(p, p + s.size());
+}
+
+double by_strtod(const string& s)
+{
+    return strtod(s.c_str(), NULL);
+}
+
+double by_parse_integer(const string& s)
+{
+    const char* p = s.data();
+    return parse_integer(p, p + s.size());
+}
+
+double by_strtol(const string& s)
+{
+    return strtol(s.c_str(), NULL, 10);
+}
+
+}
+
+/**
+ * Compare the throughput of parse_numeric() and parse_integer() against
+ * strtod() and strtol() over typical cell values.
+ */
+int main()
+{
+    vector<string> values;
+    generate_values(values);
+
+    run("parse_numeric", values, by_parse_numeric);
+    run("strtod", values, by_strtod);
+    run("parse_integer", values, by_parse_integer);
+    run("strtol", values, by_strtol);
+
+    return EXIT_SUCCESS;
+}
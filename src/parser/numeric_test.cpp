@@ -0,0 +1,321 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+#include "orcus/parser_global.hpp"
+
+#include <boost/cstdint.hpp>
+
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <cassert>
+#include <climits>
+#include <clocale>
+#include <string>
+#include <iostream>
+
+using namespace std;
+using namespace orcus;
+using boost::uint64_t;
+
+namespace {
+
+/**
+ * Small deterministic generator so that every run checks the same inputs.
+ */
+class random_source
+{
+    uint64_t m_state;
+public:
+    random_source() : m_state(0x2545F4914F6CDD1DULL) {}
+
+    uint64_t next()
+    {
+        m_state ^= m_state >> 12;
+        m_state ^= m_state << 25;
+        m_state ^= m_state >> 27;
+        return m_state * 0x2545F4914F6CDD1DULL;
+    }
+
+    size_t next(size_t n) { return next() % n; }
+};
+
+bool same_bits(double a, double b)
+{
+    return memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+/**
+ * Parse the string with both parse_numeric() and strtod(), and make sure
+ * they agree on the value to the last bit and on where the number ends.
+ */
+void check_against_strtod(const string& s)
+{
+    const char* p = s.c_str();
+    const char* p_end = p + s.size();
+
+    char* p_expected_end = NULL;
+    double expected = strtod(p, &p_expected_end);
+
+    const char* p_parsed = p;
+    double parsed = parse_numeric(p_parsed, p_end);
+
+    if (!same_bits(parsed, expected) || p_parsed != p_expected_end)
+    {
+        printf("mismatch: '%s' parsed: %.17g (%d chars) strtod: %.17g (%d chars)\n",
+               s.c_str(), parsed, int(p_parsed-p), expected, int(p_expected_end-p));
+        assert(false);
+    }
+}
+
+string random_digits(random_source& rs, size_t n)
+{
+    string s;
+    for (size_t i = 0; i < n; ++i)
+        s.push_back('0' + rs.next(10));
+    return s;
+}
+
+/**
+ * Random decimal string with up to 30 digits, anywhere in the double
+ * range.
+ */
+string random_decimal(random_source& rs)
+{
+    string s;
+    switch (rs.next(3))
+    {
+        case 0:
+            s.push_back('-');
+        break;
+        case 1:
+            if (rs.next(4) == 0)
+                s.push_back('+');
+        break;
+        default:
+            ;
+    }
+
+    size_t int_digits = rs.next(20);
+    size_t frac_digits = rs.next(12);
+    if (rs.next(8) == 0)
+        // Occasionally go past the 19 digits that fit in the mantissa.
+        frac_digits += 10;
+
+    if (!int_digits && !frac_digits)
+        int_digits = 1;
+
+    s += random_digits(rs, int_digits);
+    if (frac_digits || rs.next(4) == 0)
+    {
+        s.push_back('.');
+        s += random_digits(rs, frac_digits);
+    }
+
+    if (rs.next(2))
+    {
+        char buf[16];
+        int exp = static_cast<int>(rs.next(660)) - 340;
+        sprintf(buf, "%c%d", rs.next(2) ? 'e' : 'E', exp);
+        s += buf;
+    }
+
+    return s;
+}
+
+/**
+ * Shortest and longest round-tripping representations of random bit
+ * patterns.  These hit the values right next to the rounding boundaries.
+ */
+string random_double_string(random_source& rs)
+{
+    double v;
+    uint64_t bits = rs.next();
+    memcpy(&v, &bits, sizeof(v));
+    if (v != v || v - v != 0.0)
+        // Skip NaN and infinity.
+        v = 1.0;
+
+    const char* formats[] = { "%.17g", "%.16g", "%.15g", "%g", "%.25e" };
+    char buf[64];
+    sprintf(buf, formats[rs.next(sizeof(formats)/sizeof(formats[0]))], v);
+    return buf;
+}
+
+}
+
+void test_fixed_values()
+{
+    const char* tests[] = {
+        "0", "-0", "+0", "0.0", ".5", "5.", "-.5", "1", "12", "-10.345",
+        "0.1", "0.2", "0.3", "1e23", "8.41e21", "5e-324", "4.9e-324",
+        "2.2250738585072011e-308", "2.2250738585072014e-308",
+        "1.7976931348623157e308", "1.7976931348623158e308", "1e308", "1e309",
+        "1e-400", "1e400", "123456789012345678901234567890",
+        "9007199254740992", "9007199254740993", "9007199254740994",
+        "9007199254740993.0000000000000000001",
+        "0.000000000000000000000000000000000000001",
+        "7.0e-10", "3.14159265358979323846264338327950288",
+        "2.4703282292062327e-324", "2.4703282292062328e-324",
+        "1.00000000000000011102230246251565404236316680908203125",
+        "1.00000000000000011102230246251565404236316680908203124",
+        "1.00000000000000011102230246251565404236316680908203126",
+        "179769313486231570000000000000000000000000000000000000000000000000000"
+        "000000000000000000000000000000000000000000000000000000000000000000000"
+        "000000000000000000000000000000000000000000000000000000000000000000000"
+        "000000000000000000000000000000000000000000000000000000000000000000000"
+        "00000000000000000000000000000000",
+        "1.2a", "1.2.", "1.2e", "1.2e+", "1.2E-x", "1.2e5x", "-10.345-",
+        "1e0000000000000000000001", "1e-99999999999999999999",
+        "0e999999", "0.00000e-5",
+    };
+
+    for (size_t i = 0; i < sizeof(tests)/sizeof(tests[0]); ++i)
+        check_against_strtod(tests[i]);
+}
+
+void test_no_number()
+{
+    const char* tests[] = { "", "-", "+", ".", "-.", "e5", ".e5", "abc", " 1" };
+
+    for (size_t i = 0; i < sizeof(tests)/sizeof(tests[0]); ++i)
+    {
+        const char* p = tests[i];
+        double v = parse_numeric(p, p + strlen(p));
+        assert(v == 0.0);
+        assert(p == tests[i]);
+
+        p = tests[i];
+        long l = parse_integer(p, p + strlen(p));
+        assert(l == 0);
+        assert(p == tests[i]);
+    }
+}
+
+void test_end_of_range()
+{
+    // The parser must stop at the end position even when more digits follow.
+    const char* s = "1234.5678e10";
+    const size_t n = strlen(s);
+    for (size_t len = 1; len <= n; ++len)
+    {
+        string sub(s, len);
+        const char* p = s;
+        double v = parse_numeric(p, s + len);
+        double expected = strtod(sub.c_str(), NULL);
+        assert(same_bits(v, expected));
+    }
+
+    const char* p = s;
+    long l = parse_integer(p, s + 2);
+    assert(l == 12);
+    assert(p == s + 2);
+}
+
+void test_random_decimals()
+{
+    random_source rs;
+    for (size_t i = 0; i < 500000; ++i)
+        check_against_strtod(random_decimal(rs));
+}
+
+void test_random_doubles()
+{
+    random_source rs;
+    for (size_t i = 0; i < 500000; ++i)
+        check_against_strtod(random_double_string(rs));
+}
+
+void test_integers()
+{
+    const char* tests[] = {
+        "0", "1", "-1", "+7", "13.4", "678abc", "-0", "0012",
+        "2147483647", "2147483648", "-2147483648", "-2147483649",
+        "9223372036854775807", "9223372036854775808",
+        "-9223372036854775808", "-9223372036854775809",
+        "99999999999999999999999999",
+    };
+
+    for (size_t i = 0; i < sizeof(tests)/sizeof(tests[0]); ++i)
+    {
+        const char* p = tests[i];
+        char* p_expected_end = NULL;
+        long expected = strtol(p, &p_expected_end, 10);
+        long parsed = parse_integer(p, p + strlen(p));
+        assert(parsed == expected);
+        assert(p == p_expected_end);
+    }
+
+    random_source rs;
+    for (size_t i = 0; i < 100000; ++i)
+    {
+        string s = rs.next(2) ? "-" : "";
+        s += random_digits(rs, rs.next(20) + 1);
+        const char* p = s.c_str();
+        long expected = strtol(p, NULL, 10);
+        assert(parse_integer(p, p + s.size()) == expected);
+    }
+}
+
+void test_locale()
+{
+    // The result must not depend on the decimal separator of the current
+    // locale, including the inputs that fall back to strtod().
+    const char* locales[] = { "de_DE.UTF-8", "de_DE", "fr_FR.UTF-8", "fr_FR" };
+    bool found = false;
+    for (size_t i = 0; i < sizeof(locales)/sizeof(locales[0]) && !found; ++i)
+        found = setlocale(LC_NUMERIC, locales[i]) != NULL;
+
+    if (!found)
+    {
+        cout << "no locale with a different decimal separator is installed." << endl;
+        return;
+    }
+
+    const char* s = "9007199254740993.0000000000000000001";
+    const char* p = s;
+    assert(parse_numeric(p, s + strlen(s)) == 9007199254740994.0);
+    assert(p == s + strlen(s));
+
+    s = "1.5";
+    p = s;
+    assert(parse_numeric(p, s + 3) == 1.5);
+
+    setlocale(LC_NUMERIC, "C");
+}
+
+int main()
+{
+    test_fixed_values();
+    test_no_number();
+    test_end_of_range();
+    test_random_decimals();
+    test_random_doubles();
+    test_integers();
+    test_locale();
+    return EXIT_SUCCESS;
+}
@@ -27,8 +27,338 @@
 
 #include "orcus/parser_global.hpp"
 
+#include <boost/cstdint.hpp>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
+#include <cstdlib>
+#include <cstring>
+#include <climits>
+#include <clocale>
+#include <string>
+
+using boost::uint64_t;
+using boost::int64_t;
+
 namespace orcus {
 
+namespace {
+
+#include "power10_table.inl"
+
+/**
+ * Decimal number as scanned from the source string, before it gets
+ * converted to a binary floating point value.  The value is
+ * mantissa x 10^exp10.
+ */
+struct decimal_number
+{
+    uint64_t mantissa;
+    int exp10;
+    bool negative;
+
+    /**
+     * Set when one or more non-zero digits did not fit in the mantissa.
+     */
+    bool truncated;
+
+    decimal_number() : mantissa(0), exp10(0), negative(false), truncated(false) {}
+};
+
+/**
+ * Maximum number of significant digits that always fit in a 64-bit
+ * unsigned integer.
+ */
+const size_t max_mantissa_digits = 19;
+
+/**
+ * Maximum absolute value of the exponent part we bother to parse.  Anything
+ * greater than this is either zero or infinity regardless of the mantissa.
+ */
+const int max_exponent_value = 100000;
+
+inline bool scan_sign(const char*& p, const char* p_end)
+{
+    if (p == p_end)
+        return false;
+
+    switch (*p)
+    {
+        case '-':
+            ++p;
+            return true;
+        case '+':
+            ++p;
+        break;
+        default:
+            ;
+    }
+
+    return false;
+}
+
+inline void push_digit(decimal_number& dec, size_t& sig_digits, int digit, bool fraction)
+{
+    if (sig_digits < max_mantissa_digits)
+    {
+        if (sig_digits || digit)
+        {
+            // Leading zeros are not significant.
+            dec.mantissa = dec.mantissa * 10 + digit;
+            ++sig_digits;
+        }
+
+        if (fraction)
+            --dec.exp10;
+        return;
+    }
+
+    // The mantissa is full.  Drop the digit.
+    if (!fraction)
+        ++dec.exp10;
+
+    if (digit)
+        dec.truncated = true;
+}
+
+/**
+ * Scan a number in the form of [+-]digits[.digits][(e|E)[+-]digits].
+ * Either the integer part or the fraction part may be empty, but not both.
+ *
+ * @return true if a number has been scanned, or false if the string does
+ *         not start with a number in which case the position is left
+ *         unchanged.
+ */
+bool scan_decimal(const char*& p, const char* p_end, decimal_number& dec)
+{
+    const char* p_start = p;
+    dec.negative = scan_sign(p, p_end);
+
+    bool has_digits = false;
+    size_t sig_digits = 0;
+
+    for (; p != p_end && is_numeric(*p); ++p)
+    {
+        has_digits = true;
+        push_digit(dec, sig_digits, *p - '0', false);
+    }
+
+    if (p != p_end && *p == '.')
+    {
+        for (++p; p != p_end && is_numeric(*p); ++p)
+        {
+            has_digits = true;
+            push_digit(dec, sig_digits, *p - '0', true);
+        }
+    }
+
+    if (!has_digits)
+    {
+        p = p_start;
+        return false;
+    }
+
+    if (p == p_end || (*p != 'e' && *p != 'E'))
+        return true;
+
+    // Exponent part.  Leave it unconsumed if it has no digits.
+    const char* p_exp = p++;
+    bool negative_exp = scan_sign(p, p_end);
+    if (p == p_end || !is_numeric(*p))
+    {
+        p = p_exp;
+        return true;
+    }
+
+    int exp_value = 0;
+    for (; p != p_end && is_numeric(*p); ++p)
+    {
+        if (exp_value < max_exponent_value)
+            exp_value = exp_value * 10 + (*p - '0');
+    }
+
+    dec.exp10 += negative_exp ? -exp_value : exp_value;
+    return true;
+}
+
+inline int count_leading_zeros(uint64_t v)
+{
+#if defined(__GNUC__)
+    return __builtin_clzll(v);
+#else
+    int n = 0;
+    for (uint64_t mask = uint64_t(1) << 63; !(v & mask); mask >>= 1)
+        ++n;
+    return n;
+#endif
+}
+
+/**
+ * Full 128-bit product of two 64-bit unsigned integers.
+ */
+inline void multiply(uint64_t a, uint64_t b, uint64_t& hi, uint64_t& lo)
+{
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 uint128_t;
+    uint128_t r = static_cast<uint128_t>(a) * b;
+    hi = static_cast<uint64_t>(r >> 64);
+    lo = static_cast<uint64_t>(r);
+#else
+    uint64_t a_lo = a & 0xFFFFFFFF, a_hi = a >> 32;
+    uint64_t b_lo = b & 0xFFFFFFFF, b_hi = b >> 32;
+    uint64_t ll = a_lo * b_lo, lh = a_lo * b_hi, hl = a_hi * b_lo, hh = a_hi * b_hi;
+    uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFF) + (hl & 0xFFFFFFFF);
+    hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+    lo = (mid << 32) | (ll & 0xFFFFFFFF);
+#endif
+}
+
+/**
+ * Eisel-Lemire algorithm.  Compute the correctly rounded double closest to
+ * mantissa x 10^exp10 using the 128-bit truncated power of ten.
+ *
+ * @return false if the result cannot be determined this way, in which case
+ *         the caller needs to use a slower, exact method.  This happens on
+ *         rare halfway cases, and when the result is subnormal or out of
+ *         range.
+ */
+bool eisel_lemire(uint64_t mantissa, int exp10, double& result)
+{
+    if (exp10 < power10_min_exp10 || power10_max_exp10 < exp10)
+        return false;
+
+    const uint64_t* pow10 = power10_table[exp10 - power10_min_exp10];
+
+    // Normalize the mantissa so that its highest bit is set.
+    int clz = count_leading_zeros(mantissa);
+    mantissa <<= clz;
+
+    // 217706 / 2^16 approximates log2(10).
+    int64_t exp2 = ((217706 * exp10) >> 16) + 64 + 1023 - clz;
+
+    uint64_t x_hi, x_lo;
+    multiply(mantissa, pow10[0], x_hi, x_lo);
+
+    if ((x_hi & 0x1FF) == 0x1FF && x_lo + mantissa < mantissa)
+    {
+        // The lower 9 bits may be affected by the truncated part of the power
+        // of ten.  Take its lower 64 bits into account.
+        uint64_t y_hi, y_lo;
+        multiply(mantissa, pow10[1], y_hi, y_lo);
+        uint64_t merged_hi = x_hi, merged_lo = x_lo + y_hi;
+        if (merged_lo < x_lo)
+            ++merged_hi;
+
+        if ((merged_hi & 0x1FF) == 0x1FF && merged_lo + 1 == 0 && y_lo + mantissa < mantissa)
+            return false;
+
+        x_hi = merged_hi;
+        x_lo = merged_lo;
+    }
+
+    // Shift down to 54 bits.
+    uint64_t msb = x_hi >> 63;
+    uint64_t bits = x_hi >> (msb + 9);
+    exp2 -= 1 ^ msb;
+
+    // Exactly halfway between two representable values.
+    if (x_lo == 0 && (x_hi & 0x1FF) == 0 && (bits & 3) == 1)
+        return false;
+
+    // Round to 53 bits.
+    bits += bits & 1;
+    bits >>= 1;
+    if (bits >> 53)
+    {
+        bits >>= 1;
+        ++exp2;
+    }
+
+    if (exp2 <= 0 || exp2 >= 0x7FF)
+        // Subnormal, or out of range.
+        return false;
+
+    bits = (static_cast<uint64_t>(exp2) << 52) | (bits & 0x000FFFFFFFFFFFFFULL);
+    std::memcpy(&result, &bits, sizeof(result));
+    return true;
+}
+
+/**
+ * Exact powers of ten representable as double.
+ */
+const double exact_powers_of_ten[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+const int max_exact_exp10 = 22;
+const uint64_t max_exact_mantissa = uint64_t(1) << 53;
+
+/**
+ * Last resort for the few inputs the fast paths cannot decide.  The C
+ * library's strtod() expects the decimal separator of the current locale,
+ * so substitute it before passing the string.
+ */
+double strtod_fallback(const char* p, const char* p_end)
+{
+    std::string buf(p, p_end);
+    char sep = '.';
+    const std::lconv* lc = std::localeconv();
+    if (lc && lc->decimal_point && *lc->decimal_point)
+        sep = *lc->decimal_point;
+
+    if (sep != '.')
+    {
+        std::string::size_type pos = buf.find('.');
+        if (pos != std::string::npos)
+            buf[pos] = sep;
+    }
+
+    return std::strtod(buf.c_str(), NULL);
+}
+
+double to_binary(const decimal_number& dec, const char* p, const char* p_end)
+{
+    if (!dec.mantissa)
+        return dec.negative ? -0.0 : 0.0;
+
+    double result = 0.0;
+
+    if (!dec.truncated && dec.mantissa <= max_exact_mantissa &&
+        -max_exact_exp10 <= dec.exp10 && dec.exp10 <= max_exact_exp10)
+    {
+        // Both the mantissa and the power of ten are exact, so a single
+        // multiplication or division gives a correctly rounded result.
+        result = static_cast<double>(dec.mantissa);
+        if (dec.exp10 < 0)
+            result /= exact_powers_of_ten[-dec.exp10];
+        else
+            result *= exact_powers_of_ten[dec.exp10];
+
+        return dec.negative ? -result : result;
+    }
+
+    bool success = eisel_lemire(dec.mantissa, dec.exp10, result);
+    if (success && dec.truncated)
+    {
+        // The true value lies between mantissa and mantissa+1.  Accept the
+        // result only when both round to the same value.
+        double upper = 0.0;
+        success = eisel_lemire(dec.mantissa + 1, dec.exp10, upper) && upper == result;
+    }
+
+    if (!success)
+        return strtod_fallback(p, p_end);
+
+    return dec.negative ? -result : result;
+}
+
+}
+
 bool is_blank(char c)
 {
     if (c == ' ')
@@ -71,4 +401,67 @@ bool is_numeric(char c)
     return ('0' <= c && c <= '9');
 }
 
+double parse_numeric(const char*& p, const char* p_end)
+{
+    const char* p_start = p;
+    decimal_number dec;
+    if (!scan_decimal(p, p_end, dec))
+        return 0.0;
+
+    return to_binary(dec, p_start, p);
+}
+
+long parse_integer(const char*& p, const char* p_end)
+{
+    const char* p_start = p;
+    bool negative = scan_sign(p, p_end);
+    if (p == p_end || !is_numeric(*p))
+    {
+        p = p_start;
+        return 0;
+    }
+
+    unsigned long limit = LONG_MAX;
+    if (negative)
+        ++limit;
+
+    unsigned long value = 0;
+    bool overflow = false;
+    for (; p != p_end && is_numeric(*p); ++p)
+    {
+        unsigned long digit = *p - '0';
+        if (overflow || value > (limit - digit) / 10)
+        {
+            // Keep consuming the digits, but clamp the value.
+            overflow = true;
+            continue;
+        }
+
+        value = value * 10 + digit;
+    }
+
+    if (overflow)
+        return negative ? LONG_MIN : LONG_MAX;
+
+    if (!negative)
+        return static_cast<long>(value);
+
+    return value == limit ? LONG_MIN : -static_cast<long>(value);
+}
+
+double get_current_time()
+{
+#ifdef _WIN32
+    // 100-nanosecond intervals since January 1, 1601.
+    FILETIME ft;
+    GetSystemTimeAsFileTime(&ft);
+    uint64_t t = (static_cast<uint64_t>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+    return t / 10000000.0;
+#else
+    timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+#endif
+}
+
 }
@@ -29,8 +29,92 @@
 
 #include <cstring>
 
+#if !defined(ORCUS_NO_SIMD)
+#if defined(__AVX2__)
+#define ORCUS_SAX_USE_AVX2 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ORCUS_SAX_USE_SSE2 1
+#endif
+#endif
+
+#if ORCUS_SAX_USE_AVX2
+#include <immintrin.h>
+#elif ORCUS_SAX_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER) && (ORCUS_SAX_USE_SSE2 || ORCUS_SAX_USE_AVX2)
+#include <intrin.h>
+#endif
+
 namespace orcus { namespace sax {
 
+namespace {
+
+#if ORCUS_SAX_USE_SSE2 || ORCUS_SAX_USE_AVX2
+
+/**
+ * Return the position of the lowest set bit in a non-zero mask.
+ */
+inline size_t lowest_bit(unsigned int mask)
+{
+#if defined(_MSC_VER)
+    unsigned long pos;
+    _BitScanForward(&pos, mask);
+    return pos;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+#endif
+
+/**
+ * Find the first occurrence of either c1 or c2 in the range [p, p_end).
+ *
+ * @return pointer to the first matching character, or p_end if no match is
+ *         found.
+ */
+const char* find_either(const char* p, const char* p_end, char c1, char c2)
+{
+#if ORCUS_SAX_USE_AVX2
+    const __m256i v1_32 = _mm256_set1_epi8(c1);
+    const __m256i v2_32 = _mm256_set1_epi8(c2);
+    for (; p_end - p >= 32; p += 32)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i hit = _mm256_or_si256(_mm256_cmpeq_epi8(v, v1_32), _mm256_cmpeq_epi8(v, v2_32));
+        unsigned int mask = static_cast<unsigned int>(_mm256_movemask_epi8(hit));
+        if (mask)
+            return p + lowest_bit(mask);
+    }
+#endif
+
+#if ORCUS_SAX_USE_SSE2 || ORCUS_SAX_USE_AVX2
+    const __m128i v1 = _mm_set1_epi8(c1);
+    const __m128i v2 = _mm_set1_epi8(c2);
+    for (; p_end - p >= 16; p += 16)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i hit = _mm_or_si128(_mm_cmpeq_epi8(v, v1), _mm_cmpeq_epi8(v, v2));
+        unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(hit));
+        if (mask)
+            return p + lowest_bit(mask);
+    }
+#endif
+
+    for (; p != p_end; ++p)
+    {
+        if (*p == c1 || *p == c2)
+            return p;
+    }
+
+    return p_end;
+}
+
+}
+
 malformed_xml_error::malformed_xml_error(const std::string& msg) : m_msg(msg) {}
 
 malformed_xml_error::~malformed_xml_error() throw() {}
@@ -71,18 +155,207 @@ char decode_xml_encoded_char(const char* p, size_t n)
     return '\0';
 }
 
+stream_source::~stream_source() {}
+
 parser_base::parser_base(const char* content, size_t size) :
     m_content(content),
     m_char(content),
+    mp_source(NULL),
+    m_size(size),
+    m_pos(0),
+    m_nest_level(0),
+    m_buffer_pos(0),
+    m_skipped_bytes(0),
+    m_root_elem_open(true),
+    m_skip_subtree(false)
+{
+    m_cell_buffers.push_back(new cell_buffer);
+}
+
+parser_base::parser_base(const char* content, size_t size, stream_source& source) :
+    m_content(content),
+    m_char(content),
+    mp_source(&source),
     m_size(size),
     m_pos(0),
     m_nest_level(0),
     m_buffer_pos(0),
-    m_root_elem_open(true)
+    m_skipped_bytes(0),
+    m_root_elem_open(true),
+    m_skip_subtree(false)
 {
     m_cell_buffers.push_back(new cell_buffer);
 }
 
+bool parser_base::fill()
+{
+    if (!mp_source)
+        return false;
+
+    m_size = mp_source->fill(m_size);
+    return m_pos < m_size;
+}
+
+size_t parser_base::ensure_remains(size_t n)
+{
+    while (mp_source && m_size < m_pos + n)
+    {
+        size_t new_size = mp_source->fill(m_size);
+        if (new_size == m_size)
+            // End of the stream.
+            break;
+
+        m_size = new_size;
+    }
+
+    return m_pos < m_size ? m_size - m_pos : 0;
+}
+
+void parser_base::skip_to(char c1, char c2)
+{
+    while (true)
+    {
+        const char* p = find_either(m_char, m_content + m_size, c1, c2);
+        m_pos += p - m_char;
+        m_char = p;
+
+        if (m_pos < m_size || !fill())
+            return;
+    }
+}
+
+void parser_base::skip_past(const char* term, size_t n)
+{
+    while (true)
+    {
+        skip_to(term[0], term[0]);
+        if (ensure_remains(n) < n)
+            throw malformed_xml_error("xml stream ended prematurely.");
+
+        if (!std::memcmp(m_char, term, n))
+        {
+            m_pos += n;
+            m_char += n;
+            return;
+        }
+
+        next();
+    }
+}
+
+void parser_base::skip_doctype()
+{
+    // Quoted literals may contain the characters looked for here, and so
+    // may the comments and processing instructions in the internal subset.
+    bool subset = false;
+    while (true)
+    {
+        char c = cur_char_checked();
+        switch (c)
+        {
+            case '"':
+            case '\'':
+                next_check();
+                skip_to(c, c);
+                cur_char_checked();
+            break;
+            case '[':
+                subset = true;
+            break;
+            case ']':
+                subset = false;
+            break;
+            case '<':
+                if (!subset)
+                    break;
+
+                if (ensure_remains(4) >= 4 && !std::memcmp(m_char, "<!--", 4))
+                {
+                    skip_past("-->", 3);
+                    continue;
+                }
+
+                if (ensure_remains(2) >= 2 && !std::memcmp(m_char, "<?", 2))
+                {
+                    skip_past("?>", 2);
+                    continue;
+                }
+            break;
+            case '>':
+                if (!subset)
+                {
+                    next();
+                    return;
+                }
+            break;
+            default:
+                ;
+        }
+        next();
+    }
+}
+
+void parser_base::skip_element_content()
+{
+    size_t begin_pos = m_pos;
+    size_t depth = 1;
+    while (true)
+    {
+        skip_to('<', '<');
+        char c = next_char_checked();
+        switch (c)
+        {
+            case '/':
+                if (!--depth)
+                {
+                    // Found the closing tag of the skipped element.  Leave
+                    // it for the parser to parse.
+                    --m_pos;
+                    --m_char;
+                    m_skipped_bytes += m_pos - begin_pos;
+                    return;
+                }
+                skip_past(">", 1);
+            break;
+            case '!':
+            {
+                next_check();
+                size_t len = ensure_remains(7);
+                if (len >= 2 && !std::memcmp(m_char, "--", 2))
+                    skip_past("-->", 3);
+                else if (len >= 7 && !std::memcmp(m_char, "[CDATA[", 7))
+                    skip_past("]]>", 3);
+                else
+                    skip_past(">", 1);
+            }
+            break;
+            case '?':
+                skip_past("?>", 2);
+            break;
+            default:
+            {
+                // Opening tag.  Attribute values may contain '>'.
+                char last = c;
+                while (c != '>')
+                {
+                    if (c == '"' || c == '\'')
+                    {
+                        next_check();
+                        skip_to(c, c);
+                    }
+
+                    last = c;
+                    c = next_char_checked();
+                }
+                next();
+
+                if (last != '/')
+                    ++depth;
+            }
+        }
+    }
+}
+
 void parser_base::inc_buffer_pos()
 {
     ++m_buffer_pos;
@@ -111,14 +384,10 @@ void parser_base::blank()
 void parser_base::comment()
 {
     // Parse until we reach '-->'.
-    size_t len = remains();
-    assert(len > 3);
-    char c = cur_char();
-    size_t i = 0;
     bool hyphen = false;
-    for (; i < len; ++i, c = next_char())
+    for (; has_char(); next())
     {
-        if (c == '-')
+        if (cur_char() == '-')
         {
             if (!hyphen)
                 // first hyphen.
@@ -131,7 +400,10 @@ void parser_base::comment()
             hyphen = false;
     }
 
-    if (len - i < 2 || next_char() != '>')
+    if (has_char())
+        next();
+
+    if (!has_char() || cur_char() != '>')
         throw malformed_xml_error("'--' should not occur in comment other than in the closing tag.");
 
     next();
@@ -139,7 +411,7 @@ void parser_base::comment()
 
 void parser_base::skip_bom()
 {
-    if (remains() < 4)
+    if (ensure_remains(4) < 4)
         // Stream too short to have a byte order mark.
         return;
 
@@ -155,7 +427,7 @@ void parser_base::skip_bom()
 
 void parser_base::expects_next(const char* p, size_t n)
 {
-    if (remains() < n+1)
+    if (ensure_remains(n+1) < n+1)
         throw malformed_xml_error("not enough stream left to check for an expected string segment.");
 
     const char* p0 = p;
@@ -222,22 +494,21 @@ void parser_base::value_with_encoded_char(cell_buffer& buf, pstring& str)
 
     while (has_char())
     {
-        if (cur_char() == '&')
-        {
-            if (m_pos > first)
-                buf.append(m_content+first, m_pos-first);
-
-            parse_encoded_char(buf);
-            first = m_pos;
-        }
-
-        if (cur_char() == '"')
+        skip_to('"', '&');
+        if (!has_char() || cur_char() == '"')
             break;
 
-        if (cur_char() != '&')
-            next();
+        // Encoded character.
+        if (m_pos > first)
+            buf.append(m_content+first, m_pos-first);
+
+        parse_encoded_char(buf);
+        first = m_pos;
     }
 
+    if (!has_char())
+        throw malformed_xml_error("xml stream ended prematurely.");
+
     if (m_pos > first)
         buf.append(m_content+first, m_pos-first);
 
@@ -255,21 +526,22 @@ bool parser_base::value(pstring& str, bool decode)
     if (c != '"')
         throw malformed_xml_error("value must be quoted");
 
-    c = next_char_checked();
+    next_check();
     size_t first = m_pos;
     const char* p0 = m_char;
 
-    for (; c != '"'; c = next_char_checked())
+    skip_to('"', decode ? '&' : '"');
+    if (!has_char())
+        throw malformed_xml_error("xml stream ended prematurely.");
+
+    if (cur_char() == '&')
     {
-        if (decode && c == '&')
-        {
-            // This value contains one or more encoded characters.
-            cell_buffer& buf = get_cell_buffer();
-            buf.reset();
-            buf.append(p0, m_pos-first);
-            value_with_encoded_char(buf, str);
-            return true;
-        }
+        // This value contains one or more encoded characters.
+        cell_buffer& buf = get_cell_buffer();
+        buf.reset();
+        buf.append(p0, m_pos-first);
+        value_with_encoded_char(buf, str);
+        return true;
     }
 
     str = pstring(p0, m_pos-first);
@@ -331,20 +603,16 @@ void parser_base::characters_with_encoded_char(cell_buffer& buf)
 
     while (has_char())
     {
-        if (cur_char() == '&')
-        {
-            if (m_pos > first)
-                buf.append(m_content+first, m_pos-first);
-
-            parse_encoded_char(buf);
-            first = m_pos;
-        }
-
-        if (cur_char() == '<')
+        skip_to('<', '&');
+        if (!has_char() || cur_char() == '<')
             break;
 
-        if (cur_char() != '&')
-            next();
+        // Encoded character.
+        if (m_pos > first)
+            buf.append(m_content+first, m_pos-first);
+
+        parse_encoded_char(buf);
+        first = m_pos;
     }
 
     if (m_pos > first)
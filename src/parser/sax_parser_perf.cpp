@@ -0,0 +1,212 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+
+#include "orcus/sax_parser.hpp"
+#include "orcus/sax_ns_parser.hpp"
+#include "orcus/xml_namespace.hpp"
+#include "orcus/zip_archive.hpp"
+#include "orcus/zip_archive_stream.hpp"
+#include "orcus/stream.hpp"
+#include "orcus/pstring.hpp"
+#include "orcus/parser_global.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+using namespace orcus;
+
+namespace {
+
+const size_t repeat_count = 10;
+
+/**
+ * Handler that does nothing, so that only the parser itself is measured.
+ */
+class null_handler
+{
+    size_t m_char_bytes;
+public:
+    null_handler() : m_char_bytes(0) {}
+
+    void doctype(const sax::doctype_declaration&) {}
+    void start_declaration(const pstring&) {}
+    void end_declaration(const pstring&) {}
+    void start_element(const sax::parser_element&) {}
+    void end_element(const sax::parser_element&) {}
+    void characters(const pstring& val, bool) { m_char_bytes += val.size(); }
+    void attribute(const sax::parser_attribute& attr) { m_char_bytes += attr.value.size(); }
+
+    size_t char_bytes() const { return m_char_bytes; }
+};
+
+/**
+ * Same as null_handler, but for sax_ns_parser.
+ */
+class null_ns_handler
+{
+    size_t m_char_bytes;
+public:
+    null_ns_handler() : m_char_bytes(0) {}
+
+    void doctype(const sax::doctype_declaration&) {}
+    void start_declaration(const pstring&) {}
+    void end_declaration(const pstring&) {}
+    void start_element(const sax_ns_parser_element&) {}
+    void end_element(const sax_ns_parser_element&) {}
+    void characters(const pstring& val, bool) { m_char_bytes += val.size(); }
+    void attribute(const pstring&, const pstring&) {}
+    void attribute(const sax_ns_parser_attribute& attr) { m_char_bytes += attr.value.size(); }
+};
+
+template<typename _Config>
+double measure_sax(const char* p, size_t n)
+{
+    double start = get_current_time();
+    for (size_t i = 0; i < repeat_count; ++i)
+    {
+        null_handler hdl;
+        sax_parser<null_handler, _Config> parser(p, n, hdl);
+        parser.parse();
+    }
+    return get_current_time() - start;
+}
+
+template<typename _Config>
+double measure_sax_ns(const char* p, size_t n)
+{
+    xmlns_repository repo;
+    double start = get_current_time();
+    for (size_t i = 0; i < repeat_count; ++i)
+    {
+        xmlns_context cxt = repo.create_context();
+        null_ns_handler hdl;
+        sax_ns_parser<null_ns_handler, _Config> parser(p, n, cxt, hdl);
+        parser.parse();
+    }
+    return get_current_time() - start;
+}
+
+void run(const string& label, const char* p, size_t n)
+{
+    double mb = static_cast<double>(n) * repeat_count / (1024.0 * 1024.0);
+    cout << label << ": " << n << " bytes" << endl;
+    cout << "  sax_parser (default config): " << (mb / measure_sax<sax_parser_default_config>(p, n)) << " MB/s" << endl;
+    cout << "  sax_parser (lean config): " << (mb / measure_sax<sax_parser_lean_config>(p, n)) << " MB/s" << endl;
+    cout << "  sax_ns_parser (default config): " << (mb / measure_sax_ns<sax_parser_default_config>(p, n)) << " MB/s" << endl;
+    cout << "  sax_ns_parser (lean config): " << (mb / measure_sax_ns<sax_parser_lean_config>(p, n)) << " MB/s" << endl;
+}
+
+/**
+ * Generate a worksheet stream similar to what Excel writes, mostly
+ * consisting of numeric and shared string cells.
+ */
+string generate_sheet(size_t row_count, size_t col_count)
+{
+    ostringstream os;
+    os << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>";
+    os << "<worksheet xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\"><sheetData>";
+    for (size_t row = 1; row <= row_count; ++row)
+    {
+        os << "<row r=\"" << row << "\" spans=\"1:" << col_count << "\">";
+        for (size_t col = 0; col < col_count; ++col)
+        {
+            char col_name = 'A' + col % 26;
+            if (col % 3 == 2)
+                os << "<c r=\"" << col_name << row << "\" t=\"s\"><v>" << (row * col % 5000) << "</v></c>";
+            else
+                os << "<c r=\"" << col_name << row << "\"><v>" << (row * 1.0001 + col) << "</v></c>";
+        }
+        os << "</row>";
+    }
+    os << "</sheetData></worksheet>";
+    return os.str();
+}
+
+bool ends_with(const pstring& s, const char* suffix)
+{
+    size_t n = strlen(suffix);
+    return s.size() >= n && !strncmp(s.get() + s.size() - n, suffix, n);
+}
+
+void run_zip(const char* filepath)
+{
+    zip_archive_stream_fd stream(filepath);
+    zip_archive archive(&stream);
+    archive.load();
+    for (size_t i = 0, n = archive.get_file_entry_count(); i < n; ++i)
+    {
+        pstring name = archive.get_file_entry_name(i);
+        if (!ends_with(name, ".xml"))
+            continue;
+
+        vector<unsigned char> buf;
+        if (!archive.read_file_entry(name, buf) || buf.empty())
+            continue;
+
+        string label = string(filepath) + ":" + name.str();
+        run(label, reinterpret_cast<const char*>(&buf[0]), buf.size());
+    }
+}
+
+}
+
+/**
+ * Measure the throughput of sax_parser and sax_ns_parser, with both the
+ * default and the lean parser configs.  Each file given in the command
+ * line is parsed; zipped documents such as xlsx and ods have each of their
+ * xml parts parsed separately.  A generated worksheet stream is always
+ * parsed at the end.
+ *
+ * To get the baseline numbers for the scalar scanner, build the parser
+ * library with -DORCUS_NO_SIMD.
+ */
+int main(int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        pstring filepath(argv[i]);
+        if (ends_with(filepath, ".xml"))
+        {
+            string content;
+            load_file_content(argv[i], content);
+            run(argv[i], content.data(), content.size());
+        }
+        else
+            run_zip(argv[i]);
+    }
+
+    string sheet = generate_sheet(100000, 20);
+    run("generated sheet (100000 x 20)", sheet.data(), sheet.size());
+
+    return EXIT_SUCCESS;
+}
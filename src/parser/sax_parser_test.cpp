@@ -0,0 +1,344 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+
+#include "orcus/sax_parser.hpp"
+
+#include <cstdlib>
+#include <cassert>
+#include <algorithm>
+#include <string>
+#include <iostream>
+
+using namespace std;
+using namespace orcus;
+
+namespace {
+
+/**
+ * Handler that records all character data and attribute values it receives
+ * as one flat string.
+ */
+class recording_handler
+{
+    string m_buf;
+public:
+    void doctype(const sax::doctype_declaration& dtd)
+    {
+        m_buf.append(dtd.root_element.get(), dtd.root_element.size());
+        m_buf.push_back('|');
+        m_buf.append(dtd.fpi.get(), dtd.fpi.size());
+        m_buf.push_back('|');
+    }
+
+    void start_declaration(const pstring&) {}
+    void end_declaration(const pstring&) {}
+    void start_element(const sax::parser_element&) {}
+    void end_element(const sax::parser_element&) {}
+
+    void characters(const pstring& val, bool /*transient*/)
+    {
+        m_buf.append(val.get(), val.size());
+        m_buf.push_back('|');
+    }
+
+    void attribute(const sax::parser_attribute& attr)
+    {
+        m_buf.append(attr.value.get(), attr.value.size());
+        m_buf.push_back('|');
+    }
+
+    const string& str() const { return m_buf; }
+};
+
+template<typename _Config>
+string parse(const string& strm)
+{
+    recording_handler hdl;
+    sax_parser<recording_handler, _Config> parser(strm.data(), strm.size(), hdl);
+    parser.parse();
+    return hdl.str();
+}
+
+string parse(const string& strm)
+{
+    return parse<sax_parser_default_config>(strm);
+}
+
+/**
+ * Stream source that makes the stream available only a few bytes at a time.
+ */
+class trickle_source : public sax::stream_source
+{
+    size_t m_total;
+    size_t m_step;
+public:
+    trickle_source(size_t total, size_t step) : m_total(total), m_step(step) {}
+
+    virtual size_t fill(size_t size)
+    {
+        return std::min(size + m_step, m_total);
+    }
+};
+
+string parse_progressive(const string& strm, size_t step)
+{
+    recording_handler hdl;
+    trickle_source source(strm.size(), step);
+    sax_parser<recording_handler> parser(strm.c_str(), 0, source, hdl);
+    parser.parse();
+    return hdl.str();
+}
+
+/**
+ * Handler that records the element structure, and asks the parser to skip
+ * the content of any element named 'skip'.
+ */
+class skipping_handler
+{
+    string m_buf;
+    sax::parser_base* mp_parser;
+public:
+    skipping_handler() : mp_parser(NULL) {}
+
+    void set_parser(sax::parser_base* parser) { mp_parser = parser; }
+
+    void doctype(const sax::doctype_declaration&) {}
+    void start_declaration(const pstring&) {}
+    void end_declaration(const pstring&) {}
+    void attribute(const sax::parser_attribute&) {}
+
+    void start_element(const sax::parser_element& elem)
+    {
+        m_buf.push_back('<');
+        m_buf.append(elem.name.get(), elem.name.size());
+        m_buf.push_back('>');
+        if (elem.name == "skip")
+            mp_parser->skip_subtree();
+    }
+
+    void end_element(const sax::parser_element& elem)
+    {
+        m_buf.append("</");
+        m_buf.append(elem.name.get(), elem.name.size());
+        m_buf.push_back('>');
+    }
+
+    void characters(const pstring& val, bool /*transient*/)
+    {
+        m_buf.append(val.get(), val.size());
+    }
+
+    const string& str() const { return m_buf; }
+};
+
+}
+
+void test_skip_subtree()
+{
+    // Comments, CDATA sections and attribute values may contain anything
+    // that looks like a tag, and must not throw the depth count off.
+    string skipped =
+        "<skip a=\"1\"/>text<b c=\"</skip>\" d='>'><!-- </skip> --><skip>"
+        "<![CDATA[</skip>]]></skip><?pi </skip> ?></b><e/>";
+    string strm = "<?xml version=\"1.0\"?><r><skip x=\">\">" + skipped + "</skip>tail<skip/>end</r>";
+    string expected = "<r><skip></skip>tail<skip></skip>end</r>";
+
+    for (size_t step = 0; step < 20; ++step)
+    {
+        skipping_handler hdl;
+        trickle_source source(strm.size(), step);
+        if (step)
+        {
+            sax_parser<skipping_handler> parser(strm.c_str(), 0, source, hdl);
+            hdl.set_parser(&parser);
+            parser.parse();
+            assert(parser.get_skipped_bytes() == skipped.size());
+        }
+        else
+        {
+            sax_parser<skipping_handler> parser(strm.data(), strm.size(), hdl);
+            hdl.set_parser(&parser);
+            parser.parse();
+            assert(parser.get_skipped_bytes() == skipped.size());
+        }
+
+        assert(hdl.str() == expected);
+    }
+
+    // The stream must not end inside the skipped element.
+    strm = "<?xml version=\"1.0\"?><r><skip><a></a><!-- </skip> -";
+    skipping_handler hdl;
+    sax_parser<skipping_handler> parser(strm.data(), strm.size(), hdl);
+    hdl.set_parser(&parser);
+    try
+    {
+        parser.parse();
+        assert(!"malformed_xml_error was not thrown.");
+    }
+    catch (const sax::malformed_xml_error& e)
+    {
+        cout << "expected error: " << e.what() << endl;
+    }
+}
+
+void test_lean_config()
+{
+    // Declarations are skipped over without their attributes reported.
+    string strm =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?><?pi a=\"?\" b=\">\"?>"
+        "<r a=\"1&amp;2\"><?pi c=\"3\"?>text&lt;<![CDATA[cdata]]></r>";
+    assert(parse(strm) == "1.0|UTF-8|?|>|1&2|3|text<|cdata|");
+    assert(parse<sax_parser_lean_config>(strm) == "1&2|text<|cdata|");
+
+    // The declaration name is still checked.
+    strm = "<?xmk version=\"1.0\"?><r/>";
+    try
+    {
+        parse<sax_parser_lean_config>(strm);
+        assert(!"malformed_xml_error was not thrown.");
+    }
+    catch (const sax::malformed_xml_error& e)
+    {
+        cout << "expected error: " << e.what() << endl;
+    }
+
+    // DOCTYPE is skipped over without a callback.
+    strm = "<?xml version=\"1.0\"?><!DOCTYPE html PUBLIC \"-//W3C//DTD XHTML 1.0 Strict//EN\"><html>x</html>";
+    assert(parse(strm) == "1.0|html|-//W3C//DTD XHTML 1.0 Strict//EN|x|");
+    assert(parse<sax_parser_lean_config>(strm) == "x|");
+
+    // So is its internal subset, whose literals and comments may contain
+    // ']' and '>'.
+    strm =
+        "<?xml version=\"1.0\"?><!DOCTYPE r SYSTEM \"a>b\" ["
+        "<!ENTITY e \"]>\"><!-- ]> --><?pi ]>?><!ELEMENT r (#PCDATA)>"
+        "] ><r>x</r>";
+    assert(parse<sax_parser_lean_config>(strm) == "x|");
+
+    // The declaration must be closed.
+    strm = "<?xml version=\"1.0\"?><!DOCTYPE r [<!ENTITY e \"x\">]";
+    try
+    {
+        parse<sax_parser_lean_config>(strm);
+        assert(!"malformed_xml_error was not thrown.");
+    }
+    catch (const sax::malformed_xml_error& e)
+    {
+        cout << "expected error: " << e.what() << endl;
+    }
+}
+
+void test_scan_boundaries()
+{
+    // Place the structural characters at every offset across the 16 and 32
+    // byte scan windows, to make sure that the vectorized and scalar scans
+    // agree.
+    for (size_t pad = 0; pad < 70; ++pad)
+    {
+        string text(pad + 1, 'x');
+        string strm = "<?xml version=\"1.0\"?><r a=\"" + text + "\">" + text + "</r>";
+        string expected = "1.0|" + text + "|" + text + "|";
+        assert(parse(strm) == expected);
+
+        strm = "<?xml version=\"1.0\"?><r a=\"" + text + "&amp;" + text + "\">" + text + "&lt;" + text + "</r>";
+        expected = "1.0|" + text + "&" + text + "|" + text + "<" + text + "|";
+        assert(parse(strm) == expected);
+    }
+}
+
+void test_unterminated_value()
+{
+    const char* strms[] = {
+        "<?xml version=\"1.0\"?><r a=\"0123456789abcdefghijklmnopqrstuvwxyz",
+        "<?xml version=\"1.0\"?><r a=\"0123456789abcdefghijklmno&amp;pqrstuvwxyz",
+    };
+
+    for (size_t i = 0; i < sizeof(strms)/sizeof(strms[0]); ++i)
+    {
+        try
+        {
+            parse(strms[i]);
+            assert(!"malformed_xml_error was not thrown.");
+        }
+        catch (const sax::malformed_xml_error& e)
+        {
+            cout << "expected error: " << e.what() << endl;
+        }
+    }
+}
+
+void test_progressive_stream()
+{
+    // Parsing a stream that becomes available progressively should give the
+    // same result as parsing it in one go, regardless of where the stream
+    // gets cut.
+    const char* strms[] = {
+        "<?xml version=\"1.0\"?><r a=\"value\" b=\"a&amp;b\">text&lt;text<c>more text</c></r>",
+        "\xef\xbb\xbf<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<r><!-- comment - with - hyphens -->text</r>",
+        "<?xml version=\"1.0\"?><!DOCTYPE html PUBLIC \"-//W3C//DTD XHTML 1.0 Strict//EN\"><html><![CDATA[<cdata>]]]></html>",
+        "<?xml version=\"1.0\"?><r><![CDATA[some ]] data]]><a x=\"0123456789abcdefghijklmnopqrstuvwxyz0123456789\"/></r>",
+    };
+
+    for (size_t i = 0; i < sizeof(strms)/sizeof(strms[0]); ++i)
+    {
+        string strm = strms[i];
+        string expected;
+        try
+        {
+            expected = parse(strm);
+        }
+        catch (const sax::malformed_xml_error& e)
+        {
+            expected = string("error: ") + e.what();
+        }
+
+        for (size_t step = 1; step < 40; ++step)
+        {
+            string result;
+            try
+            {
+                result = parse_progressive(strm, step);
+            }
+            catch (const sax::malformed_xml_error& e)
+            {
+                result = string("error: ") + e.what();
+            }
+            assert(result == expected);
+        }
+    }
+}
+
+int main()
+{
+    test_scan_boundaries();
+    test_unterminated_value();
+    test_progressive_stream();
+    test_skip_subtree();
+    test_lean_config();
+    return EXIT_SUCCESS;
+}
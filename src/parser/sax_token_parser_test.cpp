@@ -0,0 +1,347 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+#include "orcus/sax_token_parser.hpp"
+#include "orcus/xml_namespace.hpp"
+#include "orcus/pstring.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <cassert>
+#include <new>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace std;
+using namespace orcus;
+
+namespace {
+
+/**
+ * Number of heap allocations made so far by the whole process.
+ */
+size_t allocation_count = 0;
+
+}
+
+void* operator new(size_t size) throw(std::bad_alloc)
+{
+    ++allocation_count;
+    void* p = malloc(size ? size : 1);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) throw()
+{
+    free(p);
+}
+
+void* operator new[](size_t size) throw(std::bad_alloc)
+{
+    return operator new(size);
+}
+
+void operator delete[](void* p) throw()
+{
+    operator delete(p);
+}
+
+namespace {
+
+const char* ns_main = "http://schemas.example.com/main";
+const char* ns_rel = "http://schemas.example.com/relationships";
+const char* ns_local = "http://schemas.example.com/local";
+
+/**
+ * Number of elements to let the parser grow its buffers before it's
+ * expected to stop allocating.
+ */
+const size_t warm_up_count = 1000;
+
+/**
+ * Generate a sheet-like document with a large number of cell elements.
+ */
+string generate_content(size_t row_count)
+{
+    ostringstream os;
+    os << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    os << "<sheetData xmlns=\"" << ns_main << "\" xmlns:r=\"" << ns_rel << "\">";
+    for (size_t row = 0; row < row_count; ++row)
+    {
+        os << "<row r=\"" << row + 1 << "\">";
+        for (size_t col = 0; col < 5; ++col)
+        {
+            os << "<c r=\"" << char('A' + col) << row + 1 << "\" t=\"s\" r:id=\"&amp;" << col << "\">"
+                << "<v>" << row * 5 + col << "</v></c>";
+        }
+        os << "</row>";
+    }
+    os << "</sheetData>";
+    return os.str();
+}
+
+class ns_handler
+{
+public:
+    ns_handler() : m_elem_count(0), m_attr_count(0), m_alloc_start(0), m_alloc_end(0) {}
+
+    void doctype(const sax::doctype_declaration&) {}
+    void start_declaration(const pstring&) {}
+    void end_declaration(const pstring&) {}
+    void attribute(const pstring&, const pstring&) {}
+    void characters(const pstring&, bool) {}
+
+    void start_element(const sax_ns_parser_element& elem)
+    {
+        assert(elem.ns == ns_main);
+        if (++m_elem_count == warm_up_count)
+            m_alloc_start = allocation_count;
+    }
+
+    void end_element(const sax_ns_parser_element& elem)
+    {
+        if (elem.name == "sheetData")
+            m_alloc_end = allocation_count;
+    }
+
+    void attribute(const sax_ns_parser_attribute& attr)
+    {
+        // Attributes without alias get the default namespace.
+        assert(attr.ns == (attr.name == "id" ? ns_rel : ns_main));
+
+        ++m_attr_count;
+    }
+
+    size_t get_elem_count() const { return m_elem_count; }
+    size_t get_attr_count() const { return m_attr_count; }
+    size_t get_allocation_count() const { return m_alloc_end - m_alloc_start; }
+
+private:
+    size_t m_elem_count;
+    size_t m_attr_count;
+    size_t m_alloc_start;
+    size_t m_alloc_end;
+};
+
+const xml_token_t token_sheetData = 1;
+const xml_token_t token_row = 2;
+const xml_token_t token_c = 3;
+const xml_token_t token_v = 4;
+const xml_token_t token_r = 5;
+const xml_token_t token_t = 6;
+const xml_token_t token_id = 7;
+
+class test_tokens
+{
+public:
+    xml_token_t get_token(const pstring& name) const
+    {
+        const char* names[] = { "sheetData", "row", "c", "v", "r", "t", "id" };
+        for (size_t i = 0; i < sizeof(names)/sizeof(names[0]); ++i)
+        {
+            if (name == names[i])
+                return i + 1;
+        }
+        return XML_UNKNOWN_TOKEN;
+    }
+};
+
+class token_handler
+{
+public:
+    token_handler() : m_elem_count(0), m_attr_count(0), m_alloc_start(0), m_alloc_end(0) {}
+
+    void characters(const pstring&, bool) {}
+
+    void start_element(const sax_token_parser_element& elem)
+    {
+        assert(elem.ns == ns_main);
+        m_attr_count += elem.attrs.size();
+        if (elem.name == token_c)
+        {
+            assert(elem.attrs.size() == 3);
+            assert(elem.attrs[0].name == token_r);
+            assert(elem.attrs[1].name == token_t);
+            assert(elem.attrs[2].name == token_id);
+            assert(elem.attrs[2].ns == ns_rel);
+            assert(elem.attrs[2].transient);
+            assert(elem.attrs[2].value.get()[0] == '&');
+        }
+
+        if (++m_elem_count == warm_up_count)
+            m_alloc_start = allocation_count;
+    }
+
+    void end_element(const sax_token_parser_element& elem)
+    {
+        assert(elem.attrs.empty());
+        if (elem.name == token_sheetData)
+            m_alloc_end = allocation_count;
+    }
+
+    size_t get_elem_count() const { return m_elem_count; }
+    size_t get_attr_count() const { return m_attr_count; }
+    size_t get_allocation_count() const { return m_alloc_end - m_alloc_start; }
+
+private:
+    size_t m_elem_count;
+    size_t m_attr_count;
+    size_t m_alloc_start;
+    size_t m_alloc_end;
+};
+
+}
+
+void test_ns_parser_allocations()
+{
+    const size_t row_count = 10000;
+    string content = generate_content(row_count);
+
+    xmlns_repository repo;
+    xmlns_id_t predefined[] = { ns_main, ns_rel, NULL };
+    repo.add_predefined_values(predefined);
+    xmlns_context cxt = repo.create_context();
+
+    ns_handler hdl;
+    sax_ns_parser<ns_handler> parser(content.data(), content.size(), cxt, hdl);
+    parser.parse();
+
+    assert(hdl.get_elem_count() == 1 + row_count * 11);
+    assert(hdl.get_attr_count() == row_count * 16);
+    cout << "sax_ns_parser: " << hdl.get_allocation_count() << " allocations" << endl;
+    assert(hdl.get_allocation_count() == 0);
+}
+
+void test_token_parser_allocations()
+{
+    const size_t row_count = 10000;
+    string content = generate_content(row_count);
+
+    xmlns_repository repo;
+    xmlns_id_t predefined[] = { ns_main, ns_rel, NULL };
+    repo.add_predefined_values(predefined);
+    xmlns_context cxt = repo.create_context();
+
+    test_tokens tokens;
+    token_handler hdl;
+    sax_token_parser<token_handler, test_tokens> parser(content.data(), content.size(), tokens, cxt, hdl);
+    parser.parse();
+
+    assert(hdl.get_elem_count() == 1 + row_count * 11);
+    assert(hdl.get_attr_count() == row_count * 16);
+    cout << "sax_token_parser: " << hdl.get_allocation_count() << " allocations" << endl;
+    assert(hdl.get_allocation_count() == 0);
+}
+
+class scope_handler
+{
+public:
+    scope_handler() : m_checked(false) {}
+
+    void doctype(const sax::doctype_declaration&) {}
+    void start_declaration(const pstring&) {}
+    void end_declaration(const pstring&) {}
+    void attribute(const pstring&, const pstring&) {}
+    void attribute(const sax_ns_parser_attribute&) {}
+    void characters(const pstring&, bool) {}
+    void end_element(const sax_ns_parser_element&) {}
+
+    void start_element(const sax_ns_parser_element& elem)
+    {
+        if (elem.name == "inner")
+            assert(elem.ns == ns_local);
+        else if (elem.name == "after")
+        {
+            // The alias declared by the preceding sibling is out of scope,
+            // and the one declared by the root element is back in effect.
+            assert(elem.ns == ns_main);
+            m_checked = true;
+        }
+    }
+
+    bool is_checked() const { return m_checked; }
+
+private:
+    bool m_checked;
+};
+
+void test_ns_scope()
+{
+    ostringstream os;
+    os << "<?xml version=\"1.0\"?>"
+        << "<root xmlns:a=\"" << ns_main << "\">"
+        << "<a:outer xmlns:a=\"" << ns_local << "\" xmlns=\"" << ns_rel << "\"><a:inner/></a:outer>"
+        << "<a:after xmlns:c=\"" << ns_local << "\"/>"
+        << "</root>";
+    string content = os.str();
+
+    xmlns_repository repo;
+    xmlns_id_t predefined[] = { ns_main, ns_rel, ns_local, NULL };
+    repo.add_predefined_values(predefined);
+    xmlns_context cxt = repo.create_context();
+    scope_handler hdl;
+    sax_ns_parser<scope_handler> parser(content.data(), content.size(), cxt, hdl);
+    parser.parse();
+    assert(hdl.is_checked());
+
+    // All aliases have been popped at the end.
+    assert(cxt.get(pstring("a")) == XMLNS_UNKNOWN_ID);
+    assert(cxt.get(pstring("c")) == XMLNS_UNKNOWN_ID);
+    assert(cxt.get(pstring()) == XMLNS_UNKNOWN_ID);
+}
+
+void test_duplicate_attributes()
+{
+    const char* content = "<?xml version=\"1.0\"?><root a=\"1\" b=\"2\" a=\"3\"/>";
+
+    xmlns_repository repo;
+    xmlns_context cxt = repo.create_context();
+    scope_handler hdl;
+    sax_ns_parser<scope_handler> parser(content, strlen(content), cxt, hdl);
+    try
+    {
+        parser.parse();
+        assert(!"duplicate attributes should have been rejected.");
+    }
+    catch (const sax::malformed_xml_error& e)
+    {
+        cout << "expected error: " << e.what() << endl;
+    }
+}
+
+int main()
+{
+    test_ns_parser_allocations();
+    test_token_parser_allocations();
+    test_ns_scope();
+    test_duplicate_attributes();
+
+    return EXIT_SUCCESS;
+}
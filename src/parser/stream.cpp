@@ -31,25 +31,138 @@
 #include <sstream>
 #include <fstream>
 
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
 using namespace std;
 
 namespace orcus {
 
-void load_file_content(const char* filepath, string& strm)
+namespace {
+
+void throw_load_error(const char* filepath)
+{
+    ostringstream os;
+    os << "failed to load " << filepath;
+    throw general_error(os.str());
+}
+
+/**
+ * Open a file in binary mode and get its size.
+ */
+size_t open_file(const char* filepath, ifstream& file)
 {
-    ifstream file(filepath);
+    file.open(filepath, ios::in | ios::binary);
     if (!file)
-    {
         // failed to open the specified file.
-        ostringstream os;
-        os << "failed to load " << filepath;
-        throw general_error(os.str());
+        throw_load_error(filepath);
+
+    file.seekg(0, ios::end);
+    streamoff size = file.tellg();
+    file.seekg(0, ios::beg);
+    if (size < 0)
+        throw_load_error(filepath);
+
+    return static_cast<size_t>(size);
+}
+
+}
+
+class file_content_impl
+{
+    boost::interprocess::file_mapping m_file;
+    boost::interprocess::mapped_region m_region;
+
+    /**
+     * Buffer to hold the content when it can't be used straight from the
+     * mapping.
+     */
+    string m_buffer;
+
+    const char* mp_data;
+    size_t m_size;
+
+public:
+    file_content_impl(const char* filepath) : mp_data(NULL), m_size(0)
+    {
+        ifstream file;
+        m_size = open_file(filepath, file);
+
+        // The remainder of the last page of a mapping is filled with zeros,
+        // which gives us the null character past the end of the content.
+        // That is not the case when the content ends exactly at a page
+        // boundary, or when there is no content at all to map, so read the
+        // file into a buffer instead.
+        if (!m_size || m_size % boost::interprocess::mapped_region::get_page_size() == 0)
+        {
+            m_buffer.resize(m_size);
+            if (m_size && !file.read(&m_buffer[0], m_size))
+                throw_load_error(filepath);
+
+            mp_data = m_buffer.c_str();
+            return;
+        }
+
+        file.close();
+
+        try
+        {
+            boost::interprocess::file_mapping(filepath, boost::interprocess::read_only).swap(m_file);
+            boost::interprocess::mapped_region(m_file, boost::interprocess::read_only, 0, m_size).swap(m_region);
+        }
+        catch (const boost::interprocess::interprocess_exception&)
+        {
+            throw_load_error(filepath);
+        }
+
+        mp_data = static_cast<const char*>(m_region.get_address());
     }
 
-    ostringstream os;
-    os << file.rdbuf();
-    file.close();
-    strm = os.str();
+    const char* data() const
+    {
+        return mp_data;
+    }
+
+    size_t size() const
+    {
+        return m_size;
+    }
+};
+
+file_content::file_content(const char* filepath) :
+    mp_impl(new file_content_impl(filepath)) {}
+
+file_content::~file_content()
+{
+    delete mp_impl;
+}
+
+const char* file_content::data() const
+{
+    return mp_impl->data();
+}
+
+size_t file_content::size() const
+{
+    return mp_impl->size();
+}
+
+bool file_content::empty() const
+{
+    return mp_impl->size() == 0;
+}
+
+void load_file_content(const char* filepath, string& strm)
+{
+    // Read the file straight into the destination string, now that we know
+    // its size up front.
+    ifstream file;
+    size_t size = open_file(filepath, file);
+    string buf(size, '\0');
+    if (size && !file.read(&buf[0], size))
+        throw_load_error(filepath);
+
+    strm.swap(buf);
 }
 
 }
@@ -0,0 +1,108 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+#include "orcus/stream.hpp"
+#include "orcus/exception.hpp"
+
+#include <cstdlib>
+#include <cstdio>
+#include <cassert>
+#include <string>
+#include <fstream>
+#include <iostream>
+
+#include <boost/interprocess/mapped_region.hpp>
+
+using namespace std;
+using namespace orcus;
+
+namespace {
+
+const char* temp_file = "parser-test-stream.tmp";
+
+string make_content(size_t size)
+{
+    string content(size, '\0');
+    for (size_t i = 0; i < size; ++i)
+        content[i] = static_cast<char>('a' + i % 26);
+    return content;
+}
+
+void write_file(const string& content)
+{
+    ofstream file(temp_file, ios::out | ios::binary);
+    file.write(content.data(), content.size());
+}
+
+}
+
+void test_file_content()
+{
+    // Files whose size falls on a page boundary can't be used straight from
+    // the mapping.  Check the sizes around it, and make sure that the
+    // content is always followed by a null character.
+    size_t page_size = boost::interprocess::mapped_region::get_page_size();
+    size_t sizes[] = { 0, 1, 100, page_size-1, page_size, page_size+1, page_size*2 };
+
+    for (size_t i = 0; i < sizeof(sizes)/sizeof(sizes[0]); ++i)
+    {
+        string expected = make_content(sizes[i]);
+        write_file(expected);
+
+        file_content content(temp_file);
+        assert(content.size() == expected.size());
+        assert(content.empty() == expected.empty());
+        assert(string(content.data(), content.size()) == expected);
+        assert(content.data()[content.size()] == '\0');
+
+        string strm;
+        load_file_content(temp_file, strm);
+        assert(strm == expected);
+    }
+
+    remove(temp_file);
+}
+
+void test_missing_file()
+{
+    try
+    {
+        file_content content("no-such-file.txt");
+        assert(!"general_error was not thrown.");
+    }
+    catch (const general_error& e)
+    {
+        cout << "expected error: " << e.what() << endl;
+    }
+}
+
+int main()
+{
+    test_file_content();
+    test_missing_file();
+    return EXIT_SUCCESS;
+}
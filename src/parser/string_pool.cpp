@@ -32,53 +32,73 @@
 #include "orcus/exception.hpp"
 
 #include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <cassert>
+
+#include <boost/cstdint.hpp>
 
 using namespace std;
 
 namespace {
 
-struct dump_instance : public unary_function<string*, void>
+/**
+ * Size of the first memory block.  Each subsequent block is twice as large
+ * as the previous one until it reaches the maximum block size.
+ */
+const size_t min_block_size = 1024;
+const size_t max_block_size = 256*1024;
+
+/**
+ * Initial number of slots in the hash index.  Must be a power of 2.
+ */
+const size_t min_index_size = 64;
+
+/**
+ * FNV-1a hash, followed by the murmur3 finalizer to spread the entropy of
+ * short keys into the low bits which are used to pick a slot.
+ */
+size_t hash_string(const char* p, size_t n)
 {
-    dump_instance() : counter(0) {}
-    void operator() (const string* p)
+    boost::uint32_t hash_val = 2166136261U;
+    for (const char* p_end = p + n; p != p_end; ++p)
     {
-        cout << counter++ << ": '" << *p << "'" << endl;
+        hash_val ^= static_cast<unsigned char>(*p);
+        hash_val *= 16777619U;
     }
-private:
-    size_t counter;
-};
 
-class pstring_back_inserter
-{
-public:
-    pstring_back_inserter(vector<const string*>& store) : m_store(store) {}
-    void operator() (const string& r) { m_store.push_back(&r); }
-private:
-    vector<const string*>& m_store;
-};
-
-struct pstring_less
-{
-    bool operator() (const string* p1, const string* p2) const { return m_less(*p1, *p2); }
-private:
-    less<string> m_less;
-};
+    hash_val ^= hash_val >> 16;
+    hash_val *= 0x85EBCA6BU;
+    hash_val ^= hash_val >> 13;
+    hash_val *= 0xC2B2AE35U;
+    hash_val ^= hash_val >> 16;
+    return hash_val;
+}
 
 }
 
 namespace orcus {
 
-size_t string_pool::string_hash::operator() (const string* p) const
-{
-    return m_hash(*p);
-}
-
-bool string_pool::string_equal_to::operator() (const string* p1, const string* p2) const
-{
-    return m_equal_to(*p1, *p2);
-}
+string_pool::stats::stats() :
+    entry_count(0),
+    slot_count(0),
+    string_bytes(0),
+    block_bytes(0),
+    index_bytes(0),
+    lookup_count(0),
+    probe_count(0),
+    max_probe_length(0) {}
 
-string_pool::string_pool() {}
+string_pool::string_pool() :
+    mp_block_pos(NULL),
+    m_block_remaining(0),
+    m_block_size(0),
+    m_size(0),
+    m_string_bytes(0),
+    m_block_bytes(0),
+    m_lookup_count(0),
+    m_probe_count(0),
+    m_max_probe_length(0) {}
 
 string_pool::~string_pool()
 {
@@ -95,25 +115,36 @@ pair<pstring, bool> string_pool::intern(const char* str, size_t n)
     if (!n)
         return pair<pstring, bool>(pstring(), false);
 
-    string_set_type::const_iterator itr = m_set.find(pstring(str, n));
-    if (itr == m_set.end())
+    size_t hash = hash_string(str, n);
+    size_t probe_length = 0;
+    entry* slot = find_slot(str, n, hash, probe_length);
+
+    ++m_lookup_count;
+    m_probe_count += probe_length;
+    if (probe_length > m_max_probe_length)
+        m_max_probe_length = probe_length;
+
+    if (slot->str)
     {
-        // This string has not been interned.  Intern it.
-        m_store.push_back(new string(str, n));
-        pair<string_set_type::iterator,bool> r = m_set.insert(pstring(&m_store.back()[0], n));
-        if (!r.second)
-            throw general_error("failed to intern a new string instance.");
-        const pstring& ps = *r.first;
-        assert(ps.size() == n);
-
-        return pair<pstring, bool>(ps, true);
+        // This string has already been interned.
+        assert(slot->size == n);
+        return pair<pstring, bool>(pstring(slot->str, slot->size), false);
     }
 
-    // This string has already been interned.
+    // This string has not been interned.  Intern it.  Keep the index at
+    // most half full so that the probe sequences stay short.
+    if ((m_size + 1) * 2 > m_index.size())
+    {
+        grow_index();
+        slot = find_slot(str, n, hash, probe_length);
+    }
+
+    slot->str = store(str, n);
+    slot->size = n;
+    slot->hash = hash;
+    ++m_size;
 
-    const pstring& stored_str = *itr;
-    assert(stored_str.size() == n);
-    return pair<pstring, bool>(stored_str, false);
+    return pair<pstring, bool>(pstring(slot->str, n), true);
 }
 
 pair<pstring, bool> string_pool::intern(const pstring& str)
@@ -123,28 +154,135 @@ pair<pstring, bool> string_pool::intern(const pstring& str)
 
 void string_pool::dump() const
 {
-    cout << "interned string count: " << m_store.size() << endl;
+    cout << "interned string count: " << m_size << endl;
 
     // Sorted stored strings first.
-    vector<const string*> sorted;
-    sorted.reserve(m_store.size());
-    for_each(m_store.begin(), m_store.end(), pstring_back_inserter(sorted));
-    sort(sorted.begin(), sorted.end(), pstring_less());
+    vector<pstring> sorted;
+    sorted.reserve(m_size);
+    for (index_type::const_iterator it = m_index.begin(), it_end = m_index.end(); it != it_end; ++it)
+    {
+        if (it->str)
+            sorted.push_back(pstring(it->str, it->size));
+    }
+    sort(sorted.begin(), sorted.end());
 
     // Now dump them all to stdout.
-    for_each(sorted.begin(), sorted.end(), dump_instance());
+    for (size_t i = 0; i < sorted.size(); ++i)
+        cout << i << ": '" << sorted[i] << "'" << endl;
 }
 
 void string_pool::clear()
 {
-    m_set.clear();
-    m_store.clear();
+    index_type().swap(m_index);
+
+    for (block_store_type::iterator it = m_blocks.begin(), it_end = m_blocks.end(); it != it_end; ++it)
+        delete[] *it;
+    block_store_type().swap(m_blocks);
+
+    mp_block_pos = NULL;
+    m_block_remaining = 0;
+    m_block_size = 0;
+    m_size = 0;
+    m_string_bytes = 0;
+    m_block_bytes = 0;
+    m_lookup_count = 0;
+    m_probe_count = 0;
+    m_max_probe_length = 0;
 }
 
 size_t string_pool::size() const
 {
-    return m_store.size();
+    return m_size;
 }
 
+string_pool::stats string_pool::get_stats() const
+{
+    stats ret;
+    ret.entry_count = m_size;
+    ret.slot_count = m_index.size();
+    ret.string_bytes = m_string_bytes;
+    ret.block_bytes = m_block_bytes;
+    ret.index_bytes = m_index.capacity() * sizeof(entry);
+    ret.lookup_count = m_lookup_count;
+    ret.probe_count = m_probe_count;
+    ret.max_probe_length = m_max_probe_length;
+    return ret;
 }
 
+const char* string_pool::store(const char* str, size_t n)
+{
+    size_t bytes = n + 1;
+    char* p = NULL;
+    if (bytes <= m_block_remaining)
+    {
+        p = mp_block_pos;
+        mp_block_pos += bytes;
+        m_block_remaining -= bytes;
+    }
+    else if (bytes > max_block_size / 2)
+    {
+        // Give a large string a block of its own, so that the remaining
+        // space in the current block doesn't go to waste.
+        m_blocks.push_back(NULL);
+        m_blocks.back() = p = new char[bytes];
+        m_block_bytes += bytes;
+    }
+    else
+    {
+        m_block_size = m_block_size ? std::min(m_block_size * 2, max_block_size) : min_block_size;
+        while (m_block_size < bytes)
+            m_block_size *= 2;
+
+        m_blocks.push_back(NULL);
+        m_blocks.back() = p = new char[m_block_size];
+        m_block_bytes += m_block_size;
+        mp_block_pos = p + bytes;
+        m_block_remaining = m_block_size - bytes;
+    }
+
+    memcpy(p, str, n);
+    p[n] = '\0';
+    m_string_bytes += bytes;
+    return p;
+}
+
+void string_pool::grow_index()
+{
+    index_type old_index;
+    old_index.swap(m_index);
+
+    entry empty_entry = { NULL, 0, 0 };
+    m_index.resize(old_index.empty() ? min_index_size : old_index.size() * 2, empty_entry);
+
+    size_t mask = m_index.size() - 1;
+    for (index_type::const_iterator it = old_index.begin(), it_end = old_index.end(); it != it_end; ++it)
+    {
+        if (!it->str)
+            continue;
+
+        size_t pos = it->hash & mask;
+        while (m_index[pos].str)
+            pos = (pos + 1) & mask;
+
+        m_index[pos] = *it;
+    }
+}
+
+string_pool::entry* string_pool::find_slot(const char* str, size_t n, size_t hash, size_t& probe_length)
+{
+    if (m_index.empty())
+        grow_index();
+
+    size_t mask = m_index.size() - 1;
+    size_t pos = hash & mask;
+    for (probe_length = 1; ; pos = (pos + 1) & mask, ++probe_length)
+    {
+        const entry& e = m_index[pos];
+        if (!e.str || (e.hash == hash && e.size == n && !memcmp(e.str, str, n)))
+            break;
+    }
+
+    return &m_index[pos];
+}
+
+}
@@ -28,6 +28,13 @@
 #include "orcus/string_pool.hpp"
 #include "orcus/pstring.hpp"
 
+#include <cstdlib>
+#include <cassert>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
 using namespace std;
 using namespace orcus;
 
@@ -82,8 +89,101 @@ void test_basic()
     assert(str.get() != static_str.get());
 }
 
+void test_many_strings()
+{
+    string_pool pool;
+
+    // Enough strings to fill several memory blocks and to grow the index
+    // many times over.  Previously interned strings must stay where they
+    // are.
+    const size_t n = 100000;
+    vector<pstring> interned;
+    interned.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        ostringstream os;
+        os << "string " << i;
+        string s = os.str();
+        pair<pstring, bool> ret = pool.intern(s.data(), s.size());
+        assert(ret.second);
+        assert(ret.first == s.c_str());
+        assert(ret.first.get()[ret.first.size()] == '\0'); // null-terminated.
+        interned.push_back(ret.first);
+    }
+
+    assert(pool.size() == n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        ostringstream os;
+        os << "string " << i;
+        string s = os.str();
+        pair<pstring, bool> ret = pool.intern(s.data(), s.size());
+        assert(!ret.second);
+        assert(ret.first.get() == interned[i].get());
+    }
+
+    // A string larger than a memory block.
+    string large(1024*1024, 'x');
+    pair<pstring, bool> ret = pool.intern(large.data(), large.size());
+    assert(ret.second);
+    assert(ret.first.size() == large.size());
+    assert(pool.intern(interned[0]).first.get() == interned[0].get());
+
+    pool.clear();
+    assert(pool.size() == 0);
+    assert(pool.intern("string 0").second);
+}
+
+void test_stats()
+{
+    string_pool pool;
+    string_pool::stats st = pool.get_stats();
+    assert(st.entry_count == 0);
+    assert(st.block_bytes == 0);
+    assert(st.lookup_count == 0);
+
+    pool.intern("foo");
+    pool.intern("bar");
+    pool.intern("foo");
+    pool.intern(""); // empty strings are not looked up.
+
+    st = pool.get_stats();
+    assert(st.entry_count == 2);
+    assert(st.slot_count > st.entry_count);
+    assert(st.string_bytes == 8); // including the null terminators.
+    assert(st.block_bytes >= st.string_bytes);
+    assert(st.index_bytes > 0);
+    assert(st.lookup_count == 3);
+    assert(st.probe_count >= st.lookup_count);
+    assert(st.max_probe_length >= 1);
+
+    // The load factor stays low enough to keep the probes short.
+    for (size_t i = 0; i < 10000; ++i)
+    {
+        ostringstream os;
+        os << i;
+        pool.intern(os.str().c_str());
+    }
+
+    st = pool.get_stats();
+    assert(st.entry_count == 10002);
+    assert(st.entry_count * 2 <= st.slot_count);
+    cout << "average probe length: " << double(st.probe_count) / st.lookup_count
+        << "  max probe length: " << st.max_probe_length << endl;
+    assert(st.probe_count < st.lookup_count * 2);
+
+    pool.clear();
+    st = pool.get_stats();
+    assert(st.entry_count == 0);
+    assert(st.block_bytes == 0);
+    assert(st.lookup_count == 0);
+}
+
 int main()
 {
     test_basic();
+    test_many_strings();
+    test_stats();
     return EXIT_SUCCESS;
 }
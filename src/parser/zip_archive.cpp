@@ -28,9 +28,11 @@
 #include "orcus/zip_archive.hpp"
 #include "orcus/zip_archive_stream.hpp"
 #include "orcus/string_pool.hpp"
+#include "deflate_decoder.hpp"
 
 #include <cstdio>
 #include <cstdlib>
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #ifdef _WIN32
@@ -44,6 +46,8 @@
 #include <zlib.h>
 #include <zconf.h>
 
+#include <boost/scoped_ptr.hpp>
+
 #define ORCUS_DEBUG_ZIP_ARCHIVE 0
 
 using namespace std;
@@ -95,46 +99,6 @@ struct zip_file_param
     uint32_t crc32;
 };
 
-class zip_inflater
-{
-    z_stream m_zlib_cxt;
-
-    zip_inflater(); // disabled
-public:
-    zip_inflater(vector<unsigned char>& raw_buf, vector<unsigned char>& dest_buf, const zip_file_param& param)
-    {
-        m_zlib_cxt.total_out = 0;
-        m_zlib_cxt.zalloc = 0;
-        m_zlib_cxt.zfree = 0;
-        m_zlib_cxt.opaque = 0;
-        m_zlib_cxt.next_in = static_cast<Bytef*>(&raw_buf[0]);
-        m_zlib_cxt.avail_in = param.size_compressed;
-
-        m_zlib_cxt.next_out = static_cast<Bytef*>(&dest_buf[0]);
-        m_zlib_cxt.avail_out = param.size_uncompressed;
-    }
-
-    ~zip_inflater()
-    {
-        inflateEnd(&m_zlib_cxt);
-    }
-
-    bool init()
-    {
-        int err = inflateInit2(&m_zlib_cxt, -MAX_WBITS);
-        return err == Z_OK;
-    }
-
-    bool inflate()
-    {
-        int err = ::inflate(&m_zlib_cxt, Z_SYNC_FLUSH);
-        if (err >= 0 && m_zlib_cxt.msg)
-            return false;
-
-        return true;
-    }
-};
-
 /**
  * Stream doesn't know its size; only its starting offset position within
  * the file stream.
@@ -238,6 +202,7 @@ class zip_archive_impl
     zip_archive_stream* m_stream;
     off_t m_stream_size;
     size_t m_central_dir_pos;
+    zip_inflate_backend_t m_inflate_backend;
 
     zip_stream_parser m_central_dir_end;
 
@@ -260,6 +225,37 @@ public:
 
     bool read_file_entry(const pstring& entry_name, vector<unsigned char>& buf) const;
 
+    /**
+     * Get the parameters of a file entry.
+     *
+     * @param entry_name file entry name.
+     *
+     * @return pointer to the parameters of the file entry, or NULL if no such
+     *         entry exists.
+     */
+    const zip_file_param* get_file_param(const pstring& entry_name) const;
+
+    /**
+     * Get the position of the data stream of a file entry, which immediately
+     * follows its local file header.
+     */
+    size_t get_data_stream_pos(const zip_file_param& param) const;
+
+    zip_archive_stream* get_stream() const
+    {
+        return m_stream;
+    }
+
+    zip_inflate_backend_t get_inflate_backend() const
+    {
+        return m_inflate_backend;
+    }
+
+    void set_inflate_backend(zip_inflate_backend_t backend)
+    {
+        m_inflate_backend = backend;
+    }
+
 private:
 
     /**
@@ -272,8 +268,286 @@ private:
     void read_file_entries();
 };
 
+/**
+ * Compressed data is read from the archive stream through a window of this
+ * size.
+ */
+const size_t zip_read_window_size = 65536;
+
+/**
+ * Backend that decompresses the data stream of a deflated file entry.
+ */
+class zip_inflater
+{
+public:
+    virtual ~zip_inflater() {}
+
+    /**
+     * Write the next segment of the uncompressed data stream.
+     *
+     * @param buf buffer to write the data into.
+     * @param n number of bytes to write.  It never goes past the declared
+     *          size of the uncompressed data stream.
+     *
+     * @return number of bytes written, which is less than n only when the
+     *         data stream ends short of its declared size.
+     */
+    virtual size_t inflate(unsigned char* buf, size_t n) = 0;
+};
+
+/**
+ * Inflate with zlib.  The compressed data is read from the archive stream
+ * through a window of fixed size.
+ */
+class zlib_inflater : public zip_inflater
+{
+    zip_archive_stream* m_stream;
+    vector<unsigned char> m_window;
+    z_stream m_zlib_cxt;
+
+    size_t m_pos;          // position of the next byte to read from the archive stream.
+    size_t m_remains_in;   // number of bytes not yet read from the archive stream.
+
+public:
+    zlib_inflater(zip_archive_stream* stream, size_t data_pos, size_t size_compressed) :
+        m_stream(stream),
+        m_window(std::min(zip_read_window_size, size_compressed+1)),
+        m_pos(data_pos), m_remains_in(size_compressed)
+    {
+        m_zlib_cxt.zalloc = 0;
+        m_zlib_cxt.zfree = 0;
+        m_zlib_cxt.opaque = 0;
+        m_zlib_cxt.next_in = NULL;
+        m_zlib_cxt.avail_in = 0;
+        if (inflateInit2(&m_zlib_cxt, -MAX_WBITS) != Z_OK)
+            throw zip_error("failed to initialize inflate.");
+    }
+
+    virtual ~zlib_inflater()
+    {
+        inflateEnd(&m_zlib_cxt);
+    }
+
+    virtual size_t inflate(unsigned char* buf, size_t n)
+    {
+        m_zlib_cxt.next_out = static_cast<Bytef*>(buf);
+        m_zlib_cxt.avail_out = static_cast<uInt>(n);
+
+        while (m_zlib_cxt.avail_out)
+        {
+            if (!m_zlib_cxt.avail_in)
+            {
+                // Read the next segment of the compressed data stream into the window.
+                if (!m_remains_in)
+                    throw zip_error("compressed data stream ended prematurely.");
+
+                size_t len = std::min(m_window.size(), m_remains_in);
+                m_stream->seek(m_pos);
+                m_stream->read(&m_window[0], len);
+                m_pos += len;
+                m_remains_in -= len;
+
+                m_zlib_cxt.next_in = static_cast<Bytef*>(&m_window[0]);
+                m_zlib_cxt.avail_in = static_cast<uInt>(len);
+            }
+
+            int err = ::inflate(&m_zlib_cxt, Z_NO_FLUSH);
+            if (err == Z_STREAM_END)
+                break;
+
+            if (err != Z_OK)
+                throw zip_error("error during inflate.");
+        }
+
+        return n - m_zlib_cxt.avail_out;
+    }
+};
+
+/**
+ * Inflate with the in-tree decoder, which takes the whole compressed data
+ * stream at once and resolves back references against the output written
+ * so far.  It is used only when the archive stream holds the compressed
+ * data in memory.
+ *
+ * As long as the caller reads the segments into consecutive positions of
+ * one buffer, the data gets decoded directly into that buffer.  Once a
+ * segment doesn't continue from the previous one, the rest of the data
+ * stream gets inflated with zlib instead, which restarts from the
+ * beginning and skips what has already been passed to the caller.
+ */
+class builtin_inflater : public zip_inflater
+{
+    deflate_decoder m_decoder;
+    boost::scoped_ptr<zlib_inflater> mp_fallback;
+
+    zip_archive_stream* m_stream;
+    size_t m_data_pos;
+    const unsigned char* mp_in;
+    size_t m_size_in;
+    unsigned char* mp_out; // start of the buffer the decoder writes into.
+    size_t m_size_out;
+    size_t m_pos_out;      // number of bytes passed to the caller so far.
+
+public:
+    builtin_inflater(
+        zip_archive_stream* stream, size_t data_pos, const unsigned char* p_in,
+        size_t size_compressed, size_t size_uncompressed) :
+        m_stream(stream), m_data_pos(data_pos), mp_in(p_in), m_size_in(size_compressed),
+        mp_out(NULL), m_size_out(size_uncompressed), m_pos_out(0) {}
+
+    virtual size_t inflate(unsigned char* buf, size_t n)
+    {
+        if (!mp_out)
+        {
+            // First segment.  Decode directly into the caller's buffer.
+            mp_out = buf;
+            m_decoder.reset(mp_in, m_size_in, mp_out, m_size_out);
+        }
+        else if (!mp_fallback && buf != mp_out + m_pos_out)
+        {
+            // This segment doesn't continue from the previous one, whose
+            // content can no longer be relied on as the history.
+            mp_fallback.reset(new zlib_inflater(m_stream, m_data_pos, m_size_in));
+            vector<unsigned char> skipped(std::min(zip_read_window_size, m_pos_out));
+            for (size_t remains = m_pos_out; remains; )
+            {
+                size_t len = std::min(skipped.size(), remains);
+                if (mp_fallback->inflate(&skipped[0], len) != len)
+                    throw zip_error("compressed data stream ended prematurely.");
+                remains -= len;
+            }
+        }
+
+        if (mp_fallback)
+            n = mp_fallback->inflate(buf, n);
+        else
+            n = m_decoder.decode(m_pos_out + n) - m_pos_out;
+
+        m_pos_out += n;
+        return n;
+    }
+};
+
+#ifdef ORCUS_ZIP_INFLATE_BUILTIN
+const zip_inflate_backend_t default_inflate_backend = zip_inflate_builtin;
+#else
+const zip_inflate_backend_t default_inflate_backend = zip_inflate_zlib;
+#endif
+
+class zip_file_entry_reader_impl
+{
+    zip_archive_stream* m_stream;
+    const zip_file_param* mp_param;
+    boost::scoped_ptr<zip_inflater> mp_inflater;
+
+    size_t m_data_pos;     // position of the first byte of the data stream.
+    size_t m_pos;          // position of the next byte to read when not compressed.
+    size_t m_remains_out;  // number of bytes not yet written to the destination.
+
+    zip_file_entry_reader_impl(const zip_file_entry_reader_impl&); // disabled
+    zip_file_entry_reader_impl& operator= (const zip_file_entry_reader_impl&); // disabled
+
+public:
+    zip_file_entry_reader_impl() :
+        m_stream(NULL), mp_param(NULL),
+        m_data_pos(0), m_pos(0), m_remains_out(0) {}
+
+    bool open(const zip_archive_impl& archive, const pstring& entry_name)
+    {
+        close();
+
+        const zip_file_param* param = archive.get_file_param(entry_name);
+        if (!param)
+            return false;
+
+        zip_archive_stream* stream = archive.get_stream();
+        size_t data_pos = archive.get_data_stream_pos(*param);
+
+        switch (param->compress_method)
+        {
+            case zip_file_param::stored:
+                break;
+            case zip_file_param::deflated:
+            {
+                // The builtin backend needs the compressed data in memory.
+                // Fall back to zlib rather than reading it all in.
+                const unsigned char* p_in = NULL;
+                if (archive.get_inflate_backend() == zip_inflate_builtin)
+                    p_in = stream->get_memory(data_pos, param->size_compressed);
+
+                if (p_in)
+                    mp_inflater.reset(
+                        new builtin_inflater(
+                            stream, data_pos, p_in, param->size_compressed, param->size_uncompressed));
+                else
+                    mp_inflater.reset(new zlib_inflater(stream, data_pos, param->size_compressed));
+            }
+            break;
+            default:
+                return false;
+        }
+
+        m_stream = stream;
+        mp_param = param;
+        m_data_pos = data_pos;
+        m_pos = m_data_pos;
+        m_remains_out = param->size_uncompressed;
+        return true;
+    }
+
+    void close()
+    {
+        mp_inflater.reset();
+        m_stream = NULL;
+        mp_param = NULL;
+        m_data_pos = 0;
+        m_pos = 0;
+        m_remains_out = 0;
+    }
+
+    size_t size() const
+    {
+        return mp_param ? mp_param->size_uncompressed : 0;
+    }
+
+    const unsigned char* data() const
+    {
+        if (!mp_param || mp_inflater)
+            // Nothing opened, or the data stream is compressed.
+            return NULL;
+
+        // Make sure the byte past the end of the data stream is readable
+        // too, to allow it to be used as a sentinel.
+        return m_stream->get_memory(m_data_pos, mp_param->size_uncompressed+1);
+    }
+
+    size_t read(unsigned char* buf, size_t n)
+    {
+        if (n > m_remains_out)
+            n = m_remains_out;
+
+        if (!n)
+            return 0;
+
+        if (!mp_inflater)
+        {
+            // Not compressed at all.
+            m_stream->seek(m_pos);
+            m_stream->read(buf, n);
+            m_pos += n;
+            m_remains_out -= n;
+            return n;
+        }
+
+        n = mp_inflater->inflate(buf, n);
+        m_remains_out -= n;
+        return n;
+    }
+};
+
 zip_archive_impl::zip_archive_impl(zip_archive_stream* stream) :
-    m_stream(stream), m_stream_size(0), m_central_dir_pos(0)
+    m_stream(stream), m_stream_size(0), m_central_dir_pos(0),
+    m_inflate_backend(default_inflate_backend)
 {
     if (!m_stream)
         throw zip_error("null stream is not allowed.");
@@ -454,19 +728,35 @@ pstring zip_archive_impl::get_file_entry_name(size_t pos) const
 
 bool zip_archive_impl::read_file_entry(const pstring& entry_name, vector<unsigned char>& buf) const
 {
-    pstring name(entry_name);
-    filename_map_type::const_iterator it = m_filenames.find(name);
+    zip_file_entry_reader_impl reader;
+    if (!reader.open(*this, entry_name))
+        return false;
+
+    vector<unsigned char> zip_buf(reader.size()+1, 0); // null-terminated
+    if (reader.read(&zip_buf[0], reader.size()) < reader.size())
+        throw zip_error("data stream is shorter than its declared size.");
+
+    buf.swap(zip_buf);
+    return true;
+}
+
+const zip_file_param* zip_archive_impl::get_file_param(const pstring& entry_name) const
+{
+    filename_map_type::const_iterator it = m_filenames.find(entry_name);
     if (it == m_filenames.end())
         // entry name not found.
-        return false;
+        return NULL;
 
     size_t index = it->second;
     if (index >= m_file_params.size())
         // entry index is out of bound.
-        return false;
+        return NULL;
 
-    const zip_file_param& param = m_file_params[index];
+    return &m_file_params[index];
+}
 
+size_t zip_archive_impl::get_data_stream_pos(const zip_file_param& param) const
+{
     // Skip the file header section.
     zip_stream_parser file_header(m_stream, param.offset_file_header);
     file_header.skip_bytes(4);
@@ -484,36 +774,7 @@ bool zip_archive_impl::read_file_entry(const pstring& entry_name, vector<unsigne
     file_header.skip_bytes(extra_field_len);
 
     // Data section is immediately followed by the header section.
-    m_stream->seek(file_header.tell());
-
-    vector<unsigned char> raw_buf(param.size_compressed+1, 0);
-    m_stream->read(&raw_buf[0], param.size_compressed);
-
-    switch (param.compress_method)
-    {
-        case zip_file_param::stored:
-            // Not compressed at all.
-            buf.swap(raw_buf);
-            return true;
-        case zip_file_param::deflated:
-        {
-            // deflate compression
-            vector<unsigned char> zip_buf(param.size_uncompressed+1, 0); // null-terminated
-            zip_inflater inflater(raw_buf, zip_buf, param);
-            if (!inflater.init())
-                break;
-
-            if (!inflater.inflate())
-                throw zip_error("error during inflate.");
-
-            buf.swap(zip_buf);
-            return true;
-        }
-        default:
-            ;
-    }
-
-    return false;
+    return file_header.tell();
 }
 
 size_t zip_archive_impl::seek_central_dir()
@@ -638,4 +899,44 @@ bool zip_archive::read_file_entry(const pstring& entry_name, vector<unsigned cha
     return mp_impl->read_file_entry(entry_name, buf);
 }
 
+void zip_archive::set_inflate_backend(zip_inflate_backend_t backend)
+{
+    mp_impl->set_inflate_backend(backend);
+}
+
+zip_inflate_backend_t zip_archive::get_inflate_backend() const
+{
+    return mp_impl->get_inflate_backend();
+}
+
+zip_file_entry_reader::zip_file_entry_reader() :
+    mp_impl(new zip_file_entry_reader_impl)
+{
+}
+
+zip_file_entry_reader::~zip_file_entry_reader()
+{
+    delete mp_impl;
+}
+
+bool zip_file_entry_reader::open(const zip_archive& archive, const pstring& entry_name)
+{
+    return mp_impl->open(*archive.mp_impl, entry_name);
+}
+
+size_t zip_file_entry_reader::size() const
+{
+    return mp_impl->size();
+}
+
+const unsigned char* zip_file_entry_reader::data() const
+{
+    return mp_impl->data();
+}
+
+size_t zip_file_entry_reader::read(unsigned char* buf, size_t n)
+{
+    return mp_impl->read(buf, n);
+}
+
 }
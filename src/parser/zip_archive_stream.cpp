@@ -27,6 +27,8 @@
 
 #include "orcus/zip_archive_stream.hpp"
 #include "orcus/zip_archive.hpp"
+#include "orcus/stream.hpp"
+#include "orcus/exception.hpp"
 
 #include <sstream>
 #include <cstring>
@@ -42,6 +44,11 @@ namespace orcus {
 
 zip_archive_stream::~zip_archive_stream() {}
 
+const unsigned char* zip_archive_stream::get_memory(size_t /*pos*/, size_t /*length*/) const
+{
+    return NULL;
+}
+
 zip_archive_stream_fd::zip_archive_stream_fd(const char* filepath) :
     m_stream(fopen(filepath, "rb"))
 {
@@ -90,6 +97,68 @@ void zip_archive_stream_fd::seek(size_t pos)
     }
 }
 
+zip_archive_stream_mmap::zip_archive_stream_mmap(const char* filepath) :
+    mp_content(NULL), m_data(NULL), m_size(0), m_pos(0)
+{
+    try
+    {
+        mp_content = new file_content(filepath);
+    }
+    catch (const general_error&)
+    {
+        // Fail early at instantiation time.
+        ostringstream os;
+        os << "failed to open " << filepath << " for reading";
+        throw zip_error(os.str());
+    }
+
+    m_data = reinterpret_cast<const unsigned char*>(mp_content->data());
+    m_size = mp_content->size();
+}
+
+zip_archive_stream_mmap::~zip_archive_stream_mmap()
+{
+    delete mp_content;
+}
+
+size_t zip_archive_stream_mmap::size() const
+{
+    return m_size;
+}
+
+size_t zip_archive_stream_mmap::tell() const
+{
+    return m_pos;
+}
+
+void zip_archive_stream_mmap::seek(size_t pos)
+{
+    if (pos > m_size)
+    {
+        ostringstream os;
+        os << "failed to set seek position to " << pos << ".";
+        throw zip_error(os.str());
+    }
+
+    m_pos = pos;
+}
+
+void zip_archive_stream_mmap::read(unsigned char* buffer, size_t length) const
+{
+    if (m_size - m_pos < length)
+        throw zip_error("actual size read doesn't match what was expected.");
+
+    memcpy(buffer, m_data + m_pos, length);
+    m_pos += length;
+}
+
+const unsigned char* zip_archive_stream_mmap::get_memory(size_t pos, size_t length) const
+{
+    if (pos > m_size || m_size - pos < length)
+        return NULL;
+
+    return m_data + pos;
+}
 
 zip_archive_stream_blob::zip_archive_stream_blob(const unsigned char* blob, size_t size) :
     m_blob(blob), m_cur(blob), m_size(size) {}
@@ -119,4 +188,12 @@ void zip_archive_stream_blob::read(unsigned char* buffer, size_t length) const
     memcpy(buffer, m_cur, length);
 }
 
+const unsigned char* zip_archive_stream_blob::get_memory(size_t pos, size_t length) const
+{
+    if (pos > m_size || m_size - pos < length)
+        return NULL;
+
+    return m_blob + pos;
+}
+
 }
@@ -0,0 +1,218 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+#include "orcus/zip_archive.hpp"
+#include "orcus/zip_archive_stream.hpp"
+#include "orcus/pstring.hpp"
+
+#include <cstdlib>
+#include <cassert>
+#include <cstring>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <iostream>
+
+using namespace std;
+using namespace orcus;
+
+namespace {
+
+const char* zip_files[] = {
+    SRCDIR"/test/ods/raw-values-1/input.ods",
+    SRCDIR"/test/xlsx/raw-values-1/input.xlsx"
+};
+
+}
+
+void test_stream_types()
+{
+    // Reading the entries through a memory-mapped stream should give the
+    // same content as reading them through a file stream.
+    for (size_t i = 0; i < sizeof(zip_files)/sizeof(zip_files[0]); ++i)
+    {
+        zip_archive_stream_fd fd_stream(zip_files[i]);
+        zip_archive fd_archive(&fd_stream);
+        fd_archive.load();
+
+        zip_archive_stream_mmap mmap_stream(zip_files[i]);
+        zip_archive mmap_archive(&mmap_stream);
+        mmap_archive.load();
+
+        assert(fd_stream.size() == mmap_stream.size());
+        assert(fd_archive.get_file_entry_count() == mmap_archive.get_file_entry_count());
+
+        for (size_t j = 0, n = fd_archive.get_file_entry_count(); j < n; ++j)
+        {
+            pstring name = fd_archive.get_file_entry_name(j);
+            assert(name == mmap_archive.get_file_entry_name(j));
+
+            vector<unsigned char> buf1, buf2;
+            assert(fd_archive.read_file_entry(name, buf1));
+            assert(mmap_archive.read_file_entry(name, buf2));
+            assert(buf1 == buf2);
+        }
+    }
+}
+
+void test_entry_reader()
+{
+    // Reading an entry one small segment at a time should give the same
+    // content as reading it in one go.
+    for (size_t i = 0; i < sizeof(zip_files)/sizeof(zip_files[0]); ++i)
+    {
+        zip_archive_stream_fd stream(zip_files[i]);
+        zip_archive archive(&stream);
+        archive.load();
+
+        for (size_t j = 0, n = archive.get_file_entry_count(); j < n; ++j)
+        {
+            pstring name = archive.get_file_entry_name(j);
+            vector<unsigned char> expected;
+            assert(archive.read_file_entry(name, expected));
+
+            zip_file_entry_reader reader;
+            assert(reader.open(archive, name));
+            assert(reader.size() + 1 == expected.size());
+
+            vector<unsigned char> buf(reader.size()+1, 0);
+            size_t pos = 0, step = 7;
+            while (true)
+            {
+                size_t len = reader.read(&buf[pos], std::min(step, buf.size()-pos));
+                pos += len;
+                if (len < step)
+                    break;
+            }
+            assert(pos == reader.size());
+            assert(buf == expected);
+        }
+
+        zip_file_entry_reader reader;
+        assert(!reader.open(archive, "no-such-entry.xml"));
+    }
+}
+
+void test_stored_entry_direct_access()
+{
+    // The mimetype entry of an ods file is always stored without
+    // compression.
+    const char* expected = "application/vnd.oasis.opendocument.spreadsheet";
+
+    zip_archive_stream_mmap stream(zip_files[0]);
+    zip_archive archive(&stream);
+    archive.load();
+
+    zip_file_entry_reader reader;
+    assert(reader.open(archive, "mimetype"));
+    assert(reader.size() == strlen(expected));
+    const unsigned char* p = reader.data();
+    assert(p);
+    assert(string(reinterpret_cast<const char*>(p), reader.size()) == expected);
+
+    // Compressed entries can't be accessed directly.
+    assert(reader.open(archive, "content.xml"));
+    assert(!reader.data());
+
+    // Neither can entries in a stream that is not in memory.
+    zip_archive_stream_fd fd_stream(zip_files[0]);
+    zip_archive fd_archive(&fd_stream);
+    fd_archive.load();
+    assert(reader.open(fd_archive, "mimetype"));
+    assert(!reader.data());
+}
+
+void test_inflate_backends()
+{
+    // Both backends should give the same content, regardless of how the
+    // entries are read.
+    for (size_t i = 0; i < sizeof(zip_files)/sizeof(zip_files[0]); ++i)
+    {
+        zip_archive_stream_fd fd_stream(zip_files[i]);
+        zip_archive fd_archive(&fd_stream);
+        fd_archive.load();
+        assert(fd_archive.get_inflate_backend() == zip_inflate_zlib ||
+               fd_archive.get_inflate_backend() == zip_inflate_builtin);
+
+        zip_archive_stream_mmap mmap_stream(zip_files[i]);
+        zip_archive mmap_archive(&mmap_stream);
+        mmap_archive.load();
+
+        zip_archive* archives[] = { &fd_archive, &mmap_archive };
+
+        for (size_t j = 0, n = fd_archive.get_file_entry_count(); j < n; ++j)
+        {
+            pstring name = fd_archive.get_file_entry_name(j);
+            fd_archive.set_inflate_backend(zip_inflate_zlib);
+            vector<unsigned char> expected;
+            assert(fd_archive.read_file_entry(name, expected));
+
+            for (size_t k = 0; k < 2; ++k)
+            {
+                zip_archive& archive = *archives[k];
+                archive.set_inflate_backend(zip_inflate_builtin);
+                assert(archive.get_inflate_backend() == zip_inflate_builtin);
+
+                vector<unsigned char> buf;
+                assert(archive.read_file_entry(name, buf));
+                assert(buf == expected);
+
+                // Consecutive segments of one buffer.
+                zip_file_entry_reader reader;
+                assert(reader.open(archive, name));
+                buf.assign(reader.size()+1, 0);
+                size_t pos = 0;
+                while (size_t len = reader.read(&buf[pos], 300))
+                    pos += len;
+                assert(pos == reader.size());
+                assert(buf == expected);
+
+                // Segments in separate buffers.  The first segment gets
+                // overwritten before the rest is read.
+                assert(reader.open(archive, name));
+                unsigned char head[100];
+                size_t head_len = reader.read(head, sizeof(head));
+                assert(head_len == std::min(sizeof(head), reader.size()));
+                assert(std::equal(head, head+head_len, expected.begin()));
+                std::fill(head, head+head_len, 0);
+                buf.assign(reader.size()-head_len+1, 0);
+                pos = reader.read(&buf[0], buf.size());
+                assert(pos == reader.size()-head_len);
+                assert(std::equal(buf.begin(), buf.end(), expected.begin()+head_len));
+            }
+        }
+    }
+}
+
+int main()
+{
+    test_stream_types();
+    test_entry_reader();
+    test_stored_entry_direct_access();
+    test_inflate_backends();
+    return EXIT_SUCCESS;
+}
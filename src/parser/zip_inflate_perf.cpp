@@ -0,0 +1,155 @@
+/*************************************************************************
+ *
+ * Copyright (c) 2013 Kohei Yoshida
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ************************************************************************/
+
+#include "orcus/zip_archive.hpp"
+#include "orcus/zip_archive_stream.hpp"
+#include "orcus/pstring.hpp"
+#include "orcus/parser_global.hpp"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <iostream>
+
+using namespace std;
+using namespace orcus;
+
+namespace {
+
+const char* corpus_files[] = {
+    SRCDIR"/test/ods/column-width-row-height/input.ods",
+    SRCDIR"/test/ods/date-cell/input.ods",
+    SRCDIR"/test/ods/formatted-text/bold-and-italic.ods",
+    SRCDIR"/test/ods/formula.ods",
+    SRCDIR"/test/ods/japanese.ods",
+    SRCDIR"/test/ods/raw-values-1/input.ods",
+    SRCDIR"/test/ods/test.ods",
+    SRCDIR"/test/xlsx/column-width-row-height/input.xlsx",
+    SRCDIR"/test/xlsx/date-cell/input.xlsx",
+    SRCDIR"/test/xlsx/empty-shared-strings/input.xlsx",
+    SRCDIR"/test/xlsx/formatted-text/bold-and-italic.xlsx",
+    SRCDIR"/test/xlsx/formula-shared.xlsx",
+    SRCDIR"/test/xlsx/formula-simple.xlsx",
+    SRCDIR"/test/xlsx/raw-values-1/input.xlsx",
+    SRCDIR"/test/xlsx/test.xlsx"
+};
+
+/**
+ * Segment size that the xlsx and ods import filters read the file entries
+ * with.
+ */
+const size_t segment_size = 65536;
+
+/**
+ * The corpus files are small, so they get decompressed repeatedly until the
+ * total reaches this many bytes.
+ */
+const size_t min_total_size = 200 * 1024 * 1024;
+
+/**
+ * Read all compressed file entries of an archive in segments, and return
+ * the total number of uncompressed bytes read.  Entries stored without
+ * compression are accessed directly through the memory-mapped stream, and
+ * are left out.
+ */
+size_t read_entries(zip_archive& archive, vector<unsigned char>& buf)
+{
+    size_t total = 0;
+    zip_file_entry_reader reader;
+    for (size_t i = 0, n = archive.get_file_entry_count(); i < n; ++i)
+    {
+        if (!reader.open(archive, archive.get_file_entry_name(i)) || reader.data())
+            continue;
+
+        if (buf.size() < reader.size())
+            buf.resize(reader.size());
+
+        for (size_t pos = 0; pos < reader.size(); )
+        {
+            size_t len = reader.read(&buf[pos], segment_size);
+            if (!len)
+                break;
+            pos += len;
+            total += len;
+        }
+    }
+    return total;
+}
+
+void run(const char* label, zip_inflate_backend_t backend, const vector<zip_archive*>& archives)
+{
+    vector<unsigned char> buf;
+    size_t total = 0;
+    double start = get_current_time();
+    while (total < min_total_size)
+    {
+        for (size_t i = 0; i < archives.size(); ++i)
+        {
+            archives[i]->set_inflate_backend(backend);
+            total += read_entries(*archives[i], buf);
+        }
+    }
+    double duration = get_current_time() - start;
+
+    cout << label << ": " << (total / duration / 1000000.0) << " MB/s" << endl;
+}
+
+}
+
+/**
+ * Compare the throughput of the inflate backends of zip_archive, by
+ * decompressing all file entries of the xlsx and ods test documents, or of
+ * the files given on the command line.
+ */
+int main(int argc, char** argv)
+{
+    vector<const char*> files;
+    if (argc > 1)
+        files.assign(argv+1, argv+argc);
+    else
+        files.assign(corpus_files, corpus_files + sizeof(corpus_files)/sizeof(corpus_files[0]));
+
+    vector<zip_archive_stream*> streams;
+    vector<zip_archive*> archives;
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        streams.push_back(new zip_archive_stream_mmap(files[i]));
+        archives.push_back(new zip_archive(streams.back()));
+        archives.back()->load();
+    }
+
+    run("zlib", zip_inflate_zlib, archives);
+    run("builtin", zip_inflate_builtin, archives);
+
+    for (size_t i = 0; i < archives.size(); ++i)
+    {
+        delete archives[i];
+        delete streams[i];
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -35,14 +35,22 @@
 #include "orcus/pstring.hpp"
 #include "orcus/types.hpp"
 #include "orcus/string_pool.hpp"
+#include "orcus/import_trace.hpp"
+#include "orcus/exception.hpp"
 
 #include <ixion/formula.hpp>
+#include <ixion/formula_name_resolver.hpp>
 #include <ixion/formula_result.hpp>
+#include <ixion/formula_tokens.hpp>
 #include <ixion/matrix.hpp>
 #include <ixion/model_context.hpp>
 
 #include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstring>
 #include <boost/ptr_container/ptr_vector.hpp>
+#include <boost/thread.hpp>
 
 using namespace std;
 
@@ -110,6 +118,67 @@ void sheet_item::html_printer::operator() (const sheet_item& item) const
     item.data.dump_html(this_file);
 }
 
+/**
+ * Formula expression whose tokenization has been deferred to finalize().
+ */
+struct deferred_formula
+{
+    ixion::abs_address_t pos;
+    pstring formula; /// interned in the document's string pool.
+
+    deferred_formula(const ixion::abs_address_t& _pos, const pstring& _formula) :
+        pos(_pos), formula(_formula) {}
+};
+
+typedef std::vector<deferred_formula> deferred_formulas_type;
+typedef std::vector<ixion::formula_tokens_t*> formula_tokens_store_type;
+
+/**
+ * Tokenize one contiguous batch of deferred formulas on a worker thread.
+ * Formulas with string literals are left to the calling thread, since
+ * tokenizing them adds strings to the model context.  So are the ones that
+ * fail to tokenize, so that the error surfaces on the calling thread.
+ */
+class formula_tokenizer
+{
+    ixion::model_context& m_cxt;
+    const deferred_formulas_type& m_formulas;
+    formula_tokens_store_type& m_tokens;
+    size_t m_begin;
+    size_t m_end;
+
+public:
+    formula_tokenizer(
+        ixion::model_context& cxt, const deferred_formulas_type& formulas,
+        formula_tokens_store_type& tokens, size_t begin, size_t end) :
+        m_cxt(cxt), m_formulas(formulas), m_tokens(tokens), m_begin(begin), m_end(end) {}
+
+    void operator() ()
+    {
+        const ixion::formula_name_resolver& resolver = m_cxt.get_name_resolver();
+        for (size_t i = m_begin; i < m_end; ++i)
+        {
+            const deferred_formula& f = m_formulas[i];
+            if (memchr(f.formula.get(), '"', f.formula.size()))
+                continue;
+
+            ixion::formula_tokens_t* tokens = new ixion::formula_tokens_t;
+            try
+            {
+                ixion::parse_formula_string(
+                    m_cxt, f.pos, resolver, f.formula.get(), f.formula.size(), *tokens);
+            }
+            catch (const std::exception&)
+            {
+                delete tokens;
+                continue;
+            }
+
+            m_tokens[i] = tokens;
+        }
+    }
+};
+
 class find_sheet_by_name : std::unary_function<sheet_item , bool>
 {
     const pstring& m_name;
@@ -135,13 +204,27 @@ struct document_impl
     import_styles* mp_styles;
     import_shared_strings* mp_strings;
     ixion::dirty_formula_cells_t m_dirty_cells;
+    import_trace* mp_trace;
+    size_t m_calc_threads;
+    bool m_trust_cached_results;
+    size_t m_tokenize_threads;
+    size_t m_finalize_threads;
+    deferred_formulas_type m_deferred_formulas;
 
     document_impl(document& doc) :
         m_doc(doc),
         mp_settings(new import_global_settings(m_doc)),
         mp_styles(new import_styles(m_string_pool)),
-        mp_strings(new import_shared_strings(m_string_pool, m_context, *mp_styles))
+        mp_strings(new import_shared_strings(m_string_pool, m_context, *mp_styles)),
+        mp_trace(NULL),
+        m_calc_threads(0),
+        m_trust_cached_results(false),
+        m_tokenize_threads(0),
+        m_finalize_threads(0)
     {
+        m_origin_date.year = 1899;
+        m_origin_date.month = 12;
+        m_origin_date.day = 30;
     }
 
     ~document_impl()
@@ -202,11 +285,91 @@ const ixion::model_context& document::get_model_context() const
 
 namespace {
 
+/**
+ * Sheets waiting to be finalized, shared between the finalizer threads.
+ * The first error any of the threads runs into is kept here, to be thrown
+ * on the calling thread once all of them have finished.
+ */
+class sheet_finalize_queue
+{
+    boost::mutex m_mtx;
+    boost::ptr_vector<sheet_item>& m_sheets;
+    size_t m_next;
+    std::string m_error;
+
+public:
+    sheet_finalize_queue(boost::ptr_vector<sheet_item>& sheets) : m_sheets(sheets), m_next(0) {}
+
+    /**
+     * @return next sheet to finalize, or NULL if there are no more sheets
+     *         or if an error has been set.
+     */
+    sheet_item* pop()
+    {
+        boost::mutex::scoped_lock lock(m_mtx);
+        if (m_next >= m_sheets.size() || !m_error.empty())
+            return NULL;
+
+        return &m_sheets[m_next++];
+    }
+
+    void set_error(const std::string& error)
+    {
+        boost::mutex::scoped_lock lock(m_mtx);
+        if (m_error.empty())
+            m_error = error;
+    }
+
+    const std::string& get_error() const { return m_error; }
+};
+
+/**
+ * Finalize a single sheet, recording the time it takes on the trace under
+ * the sheet's name.
+ */
+void finalize_sheet(sheet_item& sh, import_trace* trace)
+{
+    trace_scope scope(trace, trace_phase_finalize_sheet, sh.name.str());
+    sh.data.finalize();
+}
+
 struct sheet_finalizer : unary_function<sheet_item, void>
 {
+    import_trace* mp_trace;
+
+    sheet_finalizer(import_trace* trace) : mp_trace(trace) {}
+
     void operator() (sheet_item& sh)
     {
-        sh.data.finalize();
+        finalize_sheet(sh, mp_trace);
+    }
+};
+
+/**
+ * Worker that finalizes sheets until the queue runs dry.
+ */
+class sheet_finalize_worker
+{
+    sheet_finalize_queue& m_queue;
+    import_trace* mp_trace;
+
+public:
+    sheet_finalize_worker(sheet_finalize_queue& queue, import_trace* trace) :
+        m_queue(queue), mp_trace(trace) {}
+
+    void operator() ()
+    {
+        for (sheet_item* sh = m_queue.pop(); sh; sh = m_queue.pop())
+        {
+            try
+            {
+                finalize_sheet(*sh, mp_trace);
+            }
+            catch (const std::exception& e)
+            {
+                m_queue.set_error(sh->name.str() + ": " + e.what());
+            }
+        }
     }
 };
 
@@ -214,8 +377,28 @@ struct sheet_finalizer : unary_function<sheet_item, void>
 
 void document::finalize()
 {
-    for_each(mp_impl->m_sheets.begin(), mp_impl->m_sheets.end(), sheet_finalizer());
-    calc_formulas();
+    boost::ptr_vector<sheet_item>& sheets = mp_impl->m_sheets;
+    size_t thread_count = std::min(mp_impl->m_finalize_threads, sheets.size());
+    if (thread_count > 1)
+    {
+        // Each sheet only touches its own storage during finalization.
+        sheet_finalize_queue queue(sheets);
+        boost::thread_group workers;
+        for (size_t i = 0; i < thread_count; ++i)
+            workers.create_thread(sheet_finalize_worker(queue, mp_impl->mp_trace));
+        workers.join_all();
+
+        if (!queue.get_error().empty())
+            throw general_error("failed to finalize sheet " + queue.get_error());
+    }
+    else
+        for_each(sheets.begin(), sheets.end(), sheet_finalizer(mp_impl->mp_trace));
+
+    tokenize_formulas();
+
+    // Trusted formula cells stay dirty until someone asks for calculation.
+    if (!mp_impl->m_trust_cached_results)
+        calc_formulas();
 }
 
 sheet* document::append_sheet(const pstring& sheet_name, row_t row_size, col_t col_size)
@@ -262,8 +445,49 @@ const sheet* document::get_sheet(sheet_t sheet_pos) const
 
 void document::calc_formulas()
 {
+    trace_scope scope(mp_impl->mp_trace, trace_phase_calc, "calc_formulas");
     ixion::iface::model_context& cxt = get_model_context();
-    ixion::calculate_cells(cxt, mp_impl->m_dirty_cells, 0);
+    ixion::calculate_cells(cxt, mp_impl->m_dirty_cells, mp_impl->m_calc_threads);
+}
+
+void document::set_formula_calc_threads(size_t n)
+{
+    mp_impl->m_calc_threads = n;
+}
+
+size_t document::get_formula_calc_threads() const
+{
+    return mp_impl->m_calc_threads;
+}
+
+void document::set_trust_cached_results(bool b)
+{
+    mp_impl->m_trust_cached_results = b;
+}
+
+bool document::get_trust_cached_results() const
+{
+    return mp_impl->m_trust_cached_results;
+}
+
+void document::set_formula_tokenize_threads(size_t n)
+{
+    mp_impl->m_tokenize_threads = n;
+}
+
+size_t document::get_formula_tokenize_threads() const
+{
+    return mp_impl->m_tokenize_threads;
+}
+
+void document::set_finalize_threads(size_t n)
+{
+    mp_impl->m_finalize_threads = n;
+}
+
+size_t document::get_finalize_threads() const
+{
+    return mp_impl->m_finalize_threads;
 }
 
 void document::swap(document& other)
@@ -273,8 +497,23 @@ void document::swap(document& other)
 
 void document::clear()
 {
+    import_trace* trace = mp_impl->mp_trace;
+    size_t calc_threads = mp_impl->m_calc_threads;
+    bool trust_cached_results = mp_impl->m_trust_cached_results;
+    size_t tokenize_threads = mp_impl->m_tokenize_threads;
+    size_t finalize_threads = mp_impl->m_finalize_threads;
     delete mp_impl;
     mp_impl = new document_impl(*this);
+    mp_impl->mp_trace = trace;
+    mp_impl->m_calc_threads = calc_threads;
+    mp_impl->m_trust_cached_results = trust_cached_results;
+    mp_impl->m_tokenize_threads = tokenize_threads;
+    mp_impl->m_finalize_threads = finalize_threads;
+}
+
+void document::set_trace(import_trace* trace)
+{
+    mp_impl->mp_trace = trace;
 }
 
 void document::dump() const
@@ -335,9 +574,73 @@ void document::set_origin_date(int year, int month, int day)
     mp_impl->m_origin_date.day = day;
 }
 
+const date_time_t& document::get_origin_date() const
+{
+    return mp_impl->m_origin_date;
+}
+
 void document::insert_dirty_cell(const ixion::abs_address_t& pos)
 {
     mp_impl->m_dirty_cells.insert(pos);
 }
 
+void document::insert_deferred_formula(const ixion::abs_address_t& pos, const char* p, size_t n)
+{
+    pstring formula = mp_impl->m_string_pool.intern(p, n).first;
+    mp_impl->m_deferred_formulas.push_back(deferred_formula(pos, formula));
+}
+
+void document::tokenize_formulas()
+{
+    deferred_formulas_type& formulas = mp_impl->m_deferred_formulas;
+    if (formulas.empty())
+        return;
+
+    trace_scope scope(mp_impl->mp_trace, trace_phase_tokenize, "tokenize_formulas");
+    ixion::model_context& cxt = mp_impl->m_context;
+    size_t n = formulas.size();
+    formula_tokens_store_type tokens(n, NULL);
+
+    // Tokenize the formulas in contiguous batches, one per thread.
+    size_t thread_count = std::min(mp_impl->m_tokenize_threads, n);
+    size_t batch_size = (n + thread_count - 1) / thread_count;
+    boost::thread_group workers;
+    for (size_t begin = 0; begin < n; begin += batch_size)
+        workers.create_thread(
+            formula_tokenizer(cxt, formulas, tokens, begin, std::min(begin + batch_size, n)));
+    workers.join_all();
+
+    // Store the tokens, and tokenize whatever the workers have left.
+    size_t i = 0;
+    try
+    {
+        for (; i < n; ++i)
+        {
+            const deferred_formula& f = formulas[i];
+            if (tokens[i])
+            {
+                size_t id = cxt.add_formula_tokens(f.pos.sheet, tokens[i]);
+                tokens[i] = NULL;
+                cxt.set_formula_cell(f.pos, id, false);
+            }
+            else
+                cxt.set_formula_cell(f.pos, f.formula.get(), f.formula.size());
+        }
+    }
+    catch (...)
+    {
+        for (; i < n; ++i)
+            delete tokens[i];
+        formulas.clear();
+        throw;
+    }
+
+    // Register the dependencies only once all formula cells are in place.
+    deferred_formulas_type::const_iterator it = formulas.begin(), it_end = formulas.end();
+    for (; it != it_end; ++it)
+        ixion::register_formula_cell(cxt, it->pos);
+
+    formulas.clear();
+}
+
 }}
@@ -69,6 +69,11 @@ void import_factory::finalize()
     mp_document->finalize();
 }
 
+void import_factory::set_trace(import_trace* trace)
+{
+    mp_document->set_trace(trace);
+}
+
 export_factory::export_factory(document* doc) : mp_document(doc) {}
 
 export_factory::~export_factory() {}
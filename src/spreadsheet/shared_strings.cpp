@@ -71,17 +71,25 @@ bool format_run::formatted() const
     return false;
 }
 
+namespace {
+
+/**
+ * Number of format runs to allocate each run block for.
+ */
+const size_t run_block_size = 1024;
+
+}
+
+import_shared_strings::stats::stats() :
+    formatted_string_count(0), run_count(0), index_bytes(0), pool_bytes(0) {}
+
 import_shared_strings::import_shared_strings(orcus::string_pool& sp, ixion::model_context& cxt, import_styles& styles) :
-    m_string_pool(sp), m_cxt(cxt), m_styles(styles), mp_cur_format_runs(NULL) {}
+    m_string_pool(sp), m_cxt(cxt), m_styles(styles), m_cur_run_begin(0) {}
 
 import_shared_strings::~import_shared_strings()
 {
-    for_each(m_formats.begin(), m_formats.end(),
-             map_object_deleter<format_runs_map_type>());
-
-    // This pointer should be NULL.
-    assert(!mp_cur_format_runs);
-    delete mp_cur_format_runs;
+    // There should be no runs of an uncommitted string left.
+    assert(m_run_blocks.empty() || m_cur_run_begin == m_run_blocks.back().size());
 }
 
 size_t import_shared_strings::append(const char* s, size_t n)
@@ -94,12 +102,13 @@ size_t import_shared_strings::add(const char* s, size_t n)
     return m_cxt.add_string(s, n);
 }
 
-const format_runs_t* import_shared_strings::get_format_runs(size_t index) const
+format_runs_t import_shared_strings::get_format_runs(size_t index) const
 {
-    format_runs_map_type::const_iterator itr = m_formats.find(index);
-    if (itr != m_formats.end())
-        return itr->second;
-    return NULL;
+    if (index >= m_run_index.size())
+        return format_runs_t();
+
+    const run_range& range = m_run_index[index];
+    return format_runs_t(range.begin, range.end);
 }
 
 const string* import_shared_strings::get_string(size_t index) const
@@ -145,7 +154,7 @@ void import_shared_strings::append_segment(const char* s, size_t n)
         return;
 
     size_t start_pos = m_cur_segment_string.size();
-    m_cur_segment_string += string(s, n);
+    m_cur_segment_string.append(s, n);
 
     if (m_cur_format.formatted())
     {
@@ -153,21 +162,71 @@ void import_shared_strings::append_segment(const char* s, size_t n)
         // Record the position and size of the format run.
         m_cur_format.pos = start_pos;
         m_cur_format.size = n;
-
-        if (!mp_cur_format_runs)
-            mp_cur_format_runs = new format_runs_t;
-
-        mp_cur_format_runs->push_back(m_cur_format);
+        push_run(m_cur_format);
         m_cur_format.reset();
     }
 }
 
+void import_shared_strings::push_run(const format_run& run)
+{
+    if (m_run_blocks.empty() || m_run_blocks.back().size() == m_run_blocks.back().capacity())
+    {
+        // Start a new block, and move the runs of the string being built
+        // over so that they stay contiguous.  The runs of the committed
+        // strings stay where they are.
+        size_t cur_size = 0;
+        if (!m_run_blocks.empty())
+            cur_size = m_run_blocks.back().size() - m_cur_run_begin;
+
+        run_block_type* block = new run_block_type;
+        block->reserve(std::max(run_block_size, cur_size*2));
+        if (cur_size)
+        {
+            run_block_type& prev = m_run_blocks.back();
+            block->assign(prev.begin() + m_cur_run_begin, prev.end());
+            prev.resize(m_cur_run_begin);
+        }
+
+        m_run_blocks.push_back(block);
+        m_cur_run_begin = 0;
+    }
+
+    m_run_blocks.back().push_back(run);
+}
+
 size_t import_shared_strings::commit_segments()
 {
     size_t sindex = m_cxt.add_string(m_cur_segment_string.data(), m_cur_segment_string.size());
     m_cur_segment_string.clear();
-    m_formats.insert(format_runs_map_type::value_type(sindex, mp_cur_format_runs));
-    mp_cur_format_runs = NULL;
+
+    if (sindex >= m_committed.size())
+        m_committed.resize(sindex+1, false);
+
+    bool committed = m_committed[sindex];
+    m_committed[sindex] = true;
+
+    if (m_run_blocks.empty() || m_cur_run_begin == m_run_blocks.back().size())
+        // Unformatted string.  Nothing to record.
+        return sindex;
+
+    run_block_type& block = m_run_blocks.back();
+    if (committed)
+    {
+        // The same string has already been committed, with or without
+        // format runs of its own.  Keep the first ones.
+        block.resize(m_cur_run_begin);
+        return sindex;
+    }
+
+    if (sindex >= m_run_index.size())
+        m_run_index.resize(sindex+1);
+
+    run_range& range = m_run_index[sindex];
+    const format_run* p = &block[0];
+    range.begin = p + m_cur_run_begin;
+    range.end = p + block.size();
+    m_cur_run_begin = block.size();
+
     return sindex;
 }
 
@@ -186,9 +245,37 @@ public:
 
 }
 
+import_shared_strings::stats import_shared_strings::get_stats() const
+{
+    stats ret;
+    run_index_type::const_iterator it = m_run_index.begin(), it_end = m_run_index.end();
+    for (; it != it_end; ++it)
+    {
+        if (it->begin != it->end)
+            ++ret.formatted_string_count;
+    }
+
+    ret.index_bytes = m_run_index.capacity() * sizeof(run_range) + m_committed.capacity() / 8;
+
+    run_blocks_type::const_iterator it_block = m_run_blocks.begin(), it_block_end = m_run_blocks.end();
+    for (; it_block != it_block_end; ++it_block)
+    {
+        ret.run_count += it_block->size();
+        ret.pool_bytes += it_block->capacity() * sizeof(format_run);
+    }
+
+    return ret;
+}
+
 void import_shared_strings::dump() const
 {
     cout << "number of shared strings: " << m_cxt.get_string_count() << endl;
+
+    stats st = get_stats();
+    cout << "number of formatted strings: " << st.formatted_string_count << endl;
+    cout << "number of format runs: " << st.run_count << endl;
+    cout << "format run memory: " << (st.index_bytes + st.pool_bytes) << " bytes (index: "
+        << st.index_bytes << ", runs: " << st.pool_bytes << ")" << endl;
 }
 
 }}
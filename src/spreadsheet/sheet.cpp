@@ -34,6 +34,8 @@
 
 #include "orcus/global.hpp"
 #include "orcus/exception.hpp"
+#include "orcus/measurement.hpp"
+#include "orcus/parser_global.hpp"
 
 #include <iostream>
 #include <fstream>
@@ -64,7 +66,7 @@ using namespace std;
 namespace orcus { namespace spreadsheet {
 
 typedef mdds::flat_segment_tree<row_t, size_t>  segment_row_index_type;
-typedef boost::unordered_map<col_t, segment_row_index_type*> cell_format_type;
+typedef boost::unordered_map<ixion::abs_address_t, ixion::formula_result, ixion::abs_address_t::hash> formula_results_type;
 
 // Widths and heights are stored in twips.
 typedef mdds::flat_segment_tree<col_t, col_width_t> col_widths_store_type;
@@ -74,6 +76,68 @@ typedef mdds::flat_segment_tree<row_t, row_height_t> row_heights_store_type;
 typedef mdds::flat_segment_tree<col_t, bool> col_hidden_store_type;
 typedef mdds::flat_segment_tree<row_t, bool> row_hidden_store_type;
 
+namespace {
+
+/**
+ * Cell format indices of a single column.  Consecutive rows that share the
+ * same format are accumulated into a pending run, which gets inserted into
+ * the segment tree as one segment only once a row that doesn't extend it
+ * arrives, or when the store is read.
+ */
+class cell_format_column
+{
+    segment_row_index_type m_store;
+    row_t m_run_start;
+    row_t m_run_end; /// one past the last row of the pending run.
+    size_t m_run_index;
+
+public:
+    cell_format_column(row_t row_size) :
+        m_store(0, row_size+1, 0), m_run_start(0), m_run_end(0), m_run_index(0) {}
+
+    /**
+     * Set a format index to the rows between row1 and row2, where row2 is
+     * not inclusive.
+     */
+    void append(row_t row1, row_t row2, size_t index)
+    {
+        if (m_run_start < m_run_end)
+        {
+            if (index == m_run_index && row1 == m_run_end)
+            {
+                m_run_end = row2;
+                return;
+            }
+
+            commit();
+        }
+
+        m_run_start = row1;
+        m_run_end = row2;
+        m_run_index = index;
+    }
+
+    segment_row_index_type& get()
+    {
+        commit();
+        return m_store;
+    }
+
+private:
+    void commit()
+    {
+        if (m_run_start >= m_run_end)
+            return;
+
+        m_store.insert_back(m_run_start, m_run_end, m_run_index);
+        m_run_start = m_run_end = 0;
+    }
+};
+
+typedef std::vector<cell_format_column*> cell_format_type;
+
+}
+
 struct sheet_impl
 {
     document& m_doc;
@@ -89,7 +153,8 @@ struct sheet_impl
     col_hidden_store_type::const_iterator m_col_hidden_pos;
     row_hidden_store_type::const_iterator m_row_hidden_pos;
 
-    cell_format_type m_cell_formats;
+    cell_format_type m_cell_formats; /// indexed by column; NULL for columns without formats.
+    formula_results_type m_formula_results; /// formula results cached in the imported file.
     row_t m_row_size;
     col_t m_col_size;
     const sheet_t m_sheet; /// sheet ID
@@ -104,12 +169,65 @@ struct sheet_impl
         m_row_hidden(0, row_size, false),
         m_col_hidden_pos(m_col_hidden.begin()),
         m_row_hidden_pos(m_row_hidden.begin()),
+        m_cell_formats(col_size, NULL),
         m_row_size(row_size), m_col_size(col_size), m_sheet(sheet_index) {}
 
     ~sheet_impl()
     {
         for_each(m_cell_formats.begin(), m_cell_formats.end(),
-                 map_object_deleter<cell_format_type>());
+                 default_deleter<cell_format_column>());
+    }
+
+    /**
+     * Get the cell format store for a column, creating it on first use.
+     */
+    cell_format_column* get_cell_format_store(col_t col)
+    {
+        if (col < 0 || col >= m_col_size)
+            return NULL;
+
+        cell_format_column*& con = m_cell_formats[col];
+        if (!con)
+            con = new cell_format_column(m_row_size);
+
+        return con;
+    }
+
+    /**
+     * Get the result of a formula cell.  The result calculated by ixion
+     * takes precedence, and the result cached in the imported file is used
+     * only while the cell has not been calculated.
+     *
+     * @return pointer to the result, or NULL if the cell has neither.
+     */
+    const ixion::formula_result* get_formula_result(
+        const ixion::formula_cell& cell, const ixion::abs_address_t& pos) const
+    {
+        const ixion::formula_result* res = cell.get_result_cache();
+        if (res)
+            return res;
+
+        formula_results_type::const_iterator it = m_formula_results.find(pos);
+        return it == m_formula_results.end() ? NULL : &it->second;
+    }
+
+    /**
+     * Shrink a range so that it fits in the sheet.
+     *
+     * @return false if no part of the range lies in the sheet.
+     */
+    bool clip_range(row_t& row1, col_t& col1, row_t& row2, col_t& col2) const
+    {
+        if (row1 < 0)
+            row1 = 0;
+        if (col1 < 0)
+            col1 = 0;
+        if (row2 >= m_row_size)
+            row2 = m_row_size - 1;
+        if (col2 >= m_col_size)
+            col2 = m_col_size - 1;
+
+        return row1 <= row2 && col1 <= col2;
     }
 };
 
@@ -136,11 +254,16 @@ void sheet::set_auto(row_t row, col_t col, const char* p, size_t n)
 
     ixion::model_context& cxt = mp_impl->m_doc.get_model_context();
 
-    // First, see if this can be parsed as a number.
-    char* endptr = NULL;
-    double val = strtod(p, &endptr);
-    const char* endptr_check = p + n;
-    if (endptr == endptr_check)
+    // First, see if this can be parsed as a number.  Leading blanks are
+    // allowed, but the number must extend to the end of the string.
+    const char* p_end = p + n;
+    const char* p_num = p;
+    while (p_num != p_end && is_blank(*p_num))
+        ++p_num;
+
+    const char* endptr = NULL;
+    double val = to_double(p_num, p_end, &endptr);
+    if (endptr != p_num && endptr == p_end)
         // Treat this as a numeric value.
         cxt.set_numeric_cell(ixion::abs_address_t(mp_impl->m_sheet,row,col), val);
     else
@@ -170,62 +293,109 @@ void sheet::set_bool(row_t row, col_t col, bool value)
     cxt.set_boolean_cell(ixion::abs_address_t(mp_impl->m_sheet,row,col), value);
 }
 
+void sheet::set_values(row_t row, col_t col, const double* values, size_t n)
+{
+    ixion::model_context& cxt = mp_impl->m_doc.get_model_context();
+    ixion::abs_address_t pos(mp_impl->m_sheet, row, col);
+    for (size_t i = 0; i < n; ++i, ++pos.column)
+        cxt.set_numeric_cell(pos, values[i]);
+}
+
+void sheet::set_strings(row_t row, col_t col, const size_t* sindices, size_t n)
+{
+    ixion::model_context& cxt = mp_impl->m_doc.get_model_context();
+    ixion::abs_address_t pos(mp_impl->m_sheet, row, col);
+    for (size_t i = 0; i < n; ++i, ++pos.column)
+        cxt.set_string_cell(pos, sindices[i]);
+}
+
+void sheet::set_bools(row_t row, col_t col, const bool* values, size_t n)
+{
+    ixion::model_context& cxt = mp_impl->m_doc.get_model_context();
+    ixion::abs_address_t pos(mp_impl->m_sheet, row, col);
+    for (size_t i = 0; i < n; ++i, ++pos.column)
+        cxt.set_boolean_cell(pos, values[i]);
+}
+
+void sheet::set_value_range(row_t row1, col_t col1, row_t row2, col_t col2, double value)
+{
+    if (!mp_impl->clip_range(row1, col1, row2, col2))
+        return;
+
+    // ixion's model_context has no block insertion, so this still costs one
+    // insertion per cell.
+
+    ixion::model_context& cxt = mp_impl->m_doc.get_model_context();
+    ixion::abs_address_t pos(mp_impl->m_sheet, row1, col1);
+    for (pos.column = col1; pos.column <= col2; ++pos.column)
+        for (pos.row = row1; pos.row <= row2; ++pos.row)
+            cxt.set_numeric_cell(pos, value);
+}
+
+void sheet::set_string_range(row_t row1, col_t col1, row_t row2, col_t col2, size_t sindex)
+{
+    if (!mp_impl->clip_range(row1, col1, row2, col2))
+        return;
+
+    // One insertion per cell, as with set_value_range().
+
+    ixion::model_context& cxt = mp_impl->m_doc.get_model_context();
+    ixion::abs_address_t pos(mp_impl->m_sheet, row1, col1);
+    for (pos.column = col1; pos.column <= col2; ++pos.column)
+        for (pos.row = row1; pos.row <= row2; ++pos.row)
+            cxt.set_string_cell(pos, sindex);
+}
+
 void sheet::set_date_time(row_t row, col_t col, int year, int month, int day, int hour, int minute, double second)
 {
-    // I'll convert this into a string value for now.
+    // Store it as a serial date value relative to the document's origin
+    // date.  Formatting it back to a date string is the job of the export.
+    const date_time_t& origin = mp_impl->m_doc.get_origin_date();
+    long days = to_day_number(year, month, day) - to_day_number(origin.year, origin.month, origin.day);
+    double time = (hour * 3600.0 + minute * 60.0 + second) / 86400.0;
 
-    ostringstream os;
-    os << year << '-';
-    if (month < 10)
-        os << '0';
-    os << month << '-';
-    if (day < 10)
-        os << '0';
-    os << day << 'T';
-    if (hour < 10)
-        os << '0';
-    os << hour << ':';
-    if (minute < 10)
-        os << '0';
-    os << minute << ':';
-    if (second < 10.0)
-        os << '0';
-    os << second;
-    string s = os.str();
-    set_auto(row, col, &s[0], s.size());
+    ixion::model_context& cxt = mp_impl->m_doc.get_model_context();
+    cxt.set_numeric_cell(ixion::abs_address_t(mp_impl->m_sheet,row,col), days + time);
 }
 
 void sheet::set_format(row_t row, col_t col, size_t index)
 {
-    cell_format_type::iterator itr = mp_impl->m_cell_formats.find(col);
-    if (itr == mp_impl->m_cell_formats.end())
-    {
-        pair<cell_format_type::iterator, bool> r =
-            mp_impl->m_cell_formats.insert(
-                cell_format_type::value_type(
-                    col, new segment_row_index_type(0, mp_impl->m_row_size+1, 0)));
+    cell_format_column* con = mp_impl->get_cell_format_store(col);
+    if (con)
+        con->append(row, row+1, index);
+}
 
-        if (!r.second)
-        {
-            cerr << "insertion of new cell format container failed!" << endl;
-            return;
-        }
-        itr = r.first;
-    }
+void sheet::set_format_range(row_t row1, col_t col1, row_t row2, col_t col2, size_t index)
+{
+    if (!mp_impl->clip_range(row1, col1, row2, col2))
+        return;
 
-    segment_row_index_type& con = *itr->second;
-    con.insert_back(row, row+1, index);
+    // One segment per column, regardless of how many rows it covers.
+    for (col_t col = col1; col <= col2; ++col)
+    {
+        cell_format_column* con = mp_impl->get_cell_format_store(col);
+        if (con)
+            con->append(row1, row2+1, index);
+    }
 }
 
 void sheet::set_formula(row_t row, col_t col, formula_grammar_t grammar,
                         const char* p, size_t n)
 {
-    // Tokenize the formula string and store it.
     ixion::model_context& cxt = mp_impl->m_doc.get_model_context();
     ixion::abs_address_t pos(mp_impl->m_sheet, row, col);
+    mp_impl->m_doc.insert_dirty_cell(pos);
+
+    if (mp_impl->m_doc.get_formula_tokenize_threads())
+    {
+        // Record the formula string, to tokenize it during finalization.
+        mp_impl->m_doc.insert_deferred_formula(pos, p, n);
+        return;
+    }
+
+    // Tokenize the formula string and store it.
     cxt.set_formula_cell(pos, p, n);
     ixion::register_formula_cell(cxt, pos);
-    mp_impl->m_doc.insert_dirty_cell(pos);
 }
 
 void sheet::set_shared_formula(
@@ -271,6 +441,21 @@ void sheet::set_array_formula(
 
 void sheet::set_formula_result(row_t row, col_t col, const char* p, size_t n)
 {
+    if (!p || !n)
+        return;
+
+    ixion::model_context& cxt = mp_impl->m_doc.get_model_context();
+    ixion::abs_address_t pos(mp_impl->m_sheet, row, col);
+
+    // Store the result as a number when the whole string is one, else as a
+    // string.
+    const char* p_end = p + n;
+    const char* endptr = NULL;
+    double val = to_double(p, p_end, &endptr);
+    if (endptr == p_end)
+        mp_impl->m_formula_results[pos] = ixion::formula_result(val);
+    else
+        mp_impl->m_formula_results[pos] = ixion::formula_result(cxt.add_string(p, n));
 }
 
 void sheet::write_string(ostream& os, row_t row, col_t col) const
@@ -363,8 +548,17 @@ col_t sheet::col_size() const
 
 void sheet::finalize()
 {
+    // This must only touch the storage of this sheet, as the document may
+    // finalize several sheets concurrently.
     mp_impl->m_col_widths.build_tree();
     mp_impl->m_row_heights.build_tree();
+
+    cell_format_type::iterator it = mp_impl->m_cell_formats.begin(), it_end = mp_impl->m_cell_formats.end();
+    for (; it != it_end; ++it)
+    {
+        if (*it)
+            (*it)->get().build_tree();
+    }
 }
 
 void sheet::dump() const
@@ -425,7 +619,7 @@ void sheet::dump() const
                            mp_impl->m_doc.get_model_context(), pos, *t, formula);
                         os << formula;
 
-                        const ixion::formula_result* res = cell->get_result_cache();
+                        const ixion::formula_result* res = mp_impl->get_formula_result(*cell, pos);
                         if (res)
                             os << " (" << res->str(mp_impl->m_doc.get_model_context()) << ")";
 
@@ -575,7 +769,7 @@ void sheet::dump_check(ostream& os, const pstring& sheet_name) const
                             mp_impl->m_doc.get_model_context(), pos, *t, formula);
                         os << ':' << formula;
 
-                        const ixion::formula_result* res = cell->get_result_cache();
+                        const ixion::formula_result* res = mp_impl->get_formula_result(*cell, pos);
                         if (res)
                             os << ':' << res->str(mp_impl->m_doc.get_model_context());
                     }
@@ -779,9 +973,9 @@ void sheet::dump_html(const string& filepath) const
                         size_t sindex = cxt.get_string_identifier(pos);
                         const string* p = cxt.get_string(sindex);
                         assert(p);
-                        const format_runs_t* pformat = sstrings->get_format_runs(sindex);
-                        if (pformat)
-                            print_formatted_text(os, *p, *pformat);
+                        format_runs_t formats = sstrings->get_format_runs(sindex);
+                        if (!formats.empty())
+                            print_formatted_text(os, *p, formats);
                         else
                             os << *p;
                     }
@@ -804,7 +998,7 @@ void sheet::dump_html(const string& filepath) const
                                 mp_impl->m_doc.get_model_context(), pos, *t, formula);
                             os << formula;
 
-                            const ixion::formula_result* res = cell->get_result_cache();
+                            const ixion::formula_result* res = mp_impl->get_formula_result(*cell, pos);
                             if (res)
                                 os << " (" << res->str(mp_impl->m_doc.get_model_context()) << ")";
                         }
@@ -822,11 +1016,10 @@ void sheet::dump_html(const string& filepath) const
 
 size_t sheet::get_cell_format(row_t row, col_t col) const
 {
-    cell_format_type::const_iterator itr = mp_impl->m_cell_formats.find(col);
-    if (itr == mp_impl->m_cell_formats.end())
+    if (col < 0 || col >= mp_impl->m_col_size || !mp_impl->m_cell_formats[col])
         return 0;
 
-    segment_row_index_type& con = *itr->second;
+    segment_row_index_type& con = mp_impl->m_cell_formats[col]->get();
     if (!con.is_tree_valid())
         con.build_tree();
 
@@ -30,6 +30,7 @@
 #include "orcus/spreadsheet/types.hpp"
 #include "orcus/orcus_xml.hpp"
 #include "orcus/global.hpp"
+#include "orcus/measurement.hpp"
 #include "orcus/sax_parser.hpp"
 #include "orcus/stream.hpp"
 
@@ -86,9 +87,9 @@ void xml_map_sax_handler::start_element(const sax::parser_element& elem)
             else if (it->name == "sheet")
                 sheet = it->value;
             else if (it->name == "row")
-                row = strtol(it->value.get(), NULL, 10);
+                row = to_long(it->value);
             else if (it->name == "column")
-                col = strtol(it->value.get(), NULL, 10);
+                col = to_long(it->value);
         }
 
         m_app.set_cell_link(xpath, sheet, row, col);
@@ -100,9 +101,9 @@ void xml_map_sax_handler::start_element(const sax::parser_element& elem)
             if (it->name == "sheet")
                 sheet = it->value;
             else if (it->name == "row")
-                row = strtol(it->value.get(), NULL, 10);
+                row = to_long(it->value);
             else if (it->name == "column")
-                col = strtol(it->value.get(), NULL, 10);
+                col = to_long(it->value);
         }
 
         m_app.start_range(sheet, row, col);